@@ -0,0 +1,141 @@
+/*
+ * LocalJobCgroup.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_LOCAL_JOB_CGROUP_HPP
+#define LAUNCHER_PLUGINS_LOCAL_JOB_CGROUP_HPP
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <sys/types.h>
+
+#include <system/FilePath.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+
+class Error;
+
+namespace local {
+
+/**
+ * @brief Represents the cgroup v2 leaf which contains all the processes of a single job.
+ *
+ * Job cgroups are only used when the job-cgroup-path option is set to a cgroup v2 directory which has been delegated
+ * to the server user. Each job's cgroup is a child of that directory which is named after the job's ID, so it can be
+ * found again from the job alone (e.g. after the plugin restarts).
+ */
+class LocalJobCgroup
+{
+public:
+   /**
+    * @brief Creates the cgroup for the specified job.
+    *
+    * @param in_jobId       The ID of the job.
+    * @param out_cgroup     The cgroup of the job, on Success.
+    *
+    * The cgroup is only created if processes can be moved into it, i.e. if the job-cgroup-path directory has been
+    * delegated to this user.
+    *
+    * @return Success if job cgroups are disabled or the cgroup could be created; Error otherwise.
+    */
+   static Error create(const std::string& in_jobId, LocalJobCgroup& out_cgroup);
+
+   /**
+    * @brief Gets the existing cgroup of the specified job.
+    *
+    * @param in_jobId       The ID of the job.
+    *
+    * @return The cgroup of the job. If job cgroups are disabled or the cgroup doesn't exist, the cgroup will be empty.
+    */
+   static LocalJobCgroup get(const std::string& in_jobId);
+
+   /**
+    * @brief Gets the total CPU time used by every process that has run in this cgroup.
+    *
+    * @param out_usageMicroseconds      The total CPU time, in microseconds, on Success.
+    *
+    * @return Success if the CPU time could be read; Error otherwise.
+    */
+   Error getCpuUsage(uint64_t& out_usageMicroseconds) const;
+
+   /**
+    * @brief Gets the amount of memory currently used by the processes in this cgroup.
+    *
+    * This is only available if the memory controller is enabled for the cgroup.
+    *
+    * @param out_bytes      The amount of memory in use, in bytes, on Success.
+    *
+    * @return Success if the memory usage could be read; Error otherwise.
+    */
+   Error getMemoryUsage(uint64_t& out_bytes) const;
+
+   /**
+    * @brief Gets the path of this cgroup.
+    *
+    * @return The path of this cgroup, or an empty path if there is no cgroup.
+    */
+   const system::FilePath& getPath() const;
+
+   /**
+    * @brief Gets the PIDs of all the processes in this cgroup.
+    *
+    * @param out_pids       The PIDs of the processes in this cgroup, on Success.
+    *
+    * @return Success if the processes could be read; Error otherwise.
+    */
+   Error getPids(std::set<pid_t>& out_pids) const;
+
+   /**
+    * @brief Checks whether this is an empty cgroup object.
+    *
+    * @return True if there is no cgroup; false otherwise.
+    */
+   bool isEmpty() const;
+
+   /**
+    * @brief Sends SIGKILL to every process in this cgroup, including any which have left the job's process group.
+    *
+    * Requires a kernel which supports cgroup.kill (Linux 5.14 or later).
+    *
+    * @return Success if the processes were killed; Error otherwise.
+    */
+   Error kill() const;
+
+   /**
+    * @brief Removes this cgroup. The cgroup can only be removed once all of its processes have exited.
+    *
+    * @return Success if the cgroup was removed or there is no cgroup; Error otherwise.
+    */
+   Error remove() const;
+
+private:
+   /** The path of the cgroup. */
+   system::FilePath m_path;
+};
+
+} // namespace local
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
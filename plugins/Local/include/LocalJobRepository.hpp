@@ -32,6 +32,8 @@
 #include <jobs/JobStatusNotifier.hpp>
 #include <system/FilePath.hpp>
 
+#include <LocalJobWriter.hpp>
+
 namespace rstudio {
 namespace launcher_plugins {
 
@@ -59,7 +61,10 @@ public:
    LocalJobRepository(const std::string& in_hostname, jobs::JobStatusNotifierPtr in_notifier);
 
    /**
-    * @brief Saves a job to disk.
+    * @brief Queues a job to be saved to disk.
+    *
+    * The job is written in the background. Multiple saves of the same job before it is written result in a single
+    * write of its latest state.
     *
     * @param in_job     The job to be saved.
     */
@@ -92,9 +97,9 @@ private:
    /**
     * @brief Removes expired jobs from disk, including all output data.
     *
-    * @param in_job     The job that was removed from the repository.
+    * @param in_jobs    The jobs that were removed from the repository.
     */
-   virtual void onJobRemoved(const api::JobPtr& in_job) override;
+   void onJobsRemoved(const api::JobList& in_jobs) override;
 
    /**
     * @brief Initializes the local job repository.
@@ -102,7 +107,12 @@ private:
     * @return Success if all local job repository directories could be created; Error otherwise.
     */
    Error onInitialize() override;
-   
+
+   /**
+    * @brief Waits until all queued job saves and removals have been written to disk.
+    */
+   void onFlush() override;
+
    /** The name of the host of this Local Plugin instance. */
    const std::string& m_hostname;
 
@@ -117,6 +127,9 @@ private:
 
    /** The scratch path configured by the system administrator. */
    const system::FilePath m_outputRootPath;
+
+   /** Writes job files in the background. */
+   std::unique_ptr<LocalJobWriter> m_jobWriter;
 };
 
 } // namespace local
@@ -106,6 +106,14 @@ private:
     */
    static void onJobExitCallback(WeakLocalJobRunner in_weakThis, int in_exitCode, api::JobPtr io_job);
 
+   /**
+    * @brief Callback to be invoked when the process of a pending Job executes a new program.
+    *
+    * @param in_weakThis    A weak pointer to this LocalJobRunner.
+    * @param io_job         The Job which must be watched.
+    */
+   static void onProcessExec(WeakLocalJobRunner in_weakThis, api::JobPtr io_job);
+
    /**
     * @brief Callback to be invoked after a set amount of time to check whether the Job is running yet.
     *
@@ -115,6 +123,17 @@ private:
     */
    static void onProcessWatchDeadline(WeakLocalJobRunner in_weakThis, int in_count, api::JobPtr io_job);
 
+   /**
+    * @brief Checks whether a pending Job is running yet, and stops watching it once it is running or has exited.
+    *
+    * The Job must be locked by the caller.
+    *
+    * @param io_job     The Job which is being watched.
+    *
+    * @return True if the Job no longer needs to be watched; false otherwise.
+    */
+   bool checkProcessState(const api::JobPtr& io_job);
+
    /**
     * @brief Adds or updates a process watch event.
     *
@@ -132,6 +151,13 @@ private:
     */
    void removeWatchEvent(const std::string& in_id);
 
+   /**
+    * @brief Stops all watching of a Job's process, whether by exec events or by polling.
+    *
+    * @param in_job     The Job which should no longer be watched.
+    */
+   void stopProcessWatch(const api::JobPtr& in_job);
+
    /** The name of the host running this job. */
    const std::string& m_hostname;
 
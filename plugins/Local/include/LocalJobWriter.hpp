@@ -0,0 +1,141 @@
+/*
+ * LocalJobWriter.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_LOCAL_JOB_WRITER_HPP
+#define LAUNCHER_PLUGINS_LOCAL_JOB_WRITER_HPP
+
+#include <Noncopyable.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <api/Job.hpp>
+#include <system/FilePath.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace local {
+
+/**
+ * @brief Writes job files to disk on a dedicated thread.
+ *
+ * Saves and removals are queued and return immediately. Queued operations for the same job are coalesced, so only the
+ * latest state of a job is written, and a job is serialized when it is written rather than when it is queued. Each job
+ * file is replaced atomically by renaming a fully written and synced temporary file over it. Operations which fail are
+ * retried after a short delay, unless the job has been queued again since.
+ */
+class LocalJobWriter : public Noncopyable
+{
+public:
+   /**
+    * @brief Constructor. Starts the writer thread.
+    *
+    * @param in_jobsPath    The directory in which job files are stored.
+    */
+   explicit LocalJobWriter(system::FilePath in_jobsPath);
+
+   /**
+    * @brief Destructor. Writes any queued operations and then stops the writer thread.
+    */
+   ~LocalJobWriter();
+
+   /**
+    * @brief Blocks until every operation queued before this call has been written to disk.
+    */
+   void flush();
+
+   /**
+    * @brief Queues the removal of a job file.
+    *
+    * @param in_jobId   The ID of the job whose file should be removed.
+    */
+   void remove(const std::string& in_jobId);
+
+   /**
+    * @brief Queues a job to be written to disk.
+    *
+    * @param in_job     The job to write.
+    */
+   void save(const api::JobPtr& in_job);
+
+private:
+   /** Queued operations by job ID. An empty job pointer means the job file should be removed. */
+   typedef std::map<std::string, api::JobPtr> PendingWrites;
+
+   /**
+    * @brief Gets the path of the file for the specified job.
+    *
+    * @param in_jobId   The ID of the job.
+    *
+    * @return The path of the job's file.
+    */
+   system::FilePath getJobFilePath(const std::string& in_jobId) const;
+
+   /**
+    * @brief Writes queued operations until the writer is stopped.
+    */
+   void run();
+
+   /**
+    * @brief Writes a batch of queued operations to disk.
+    *
+    * @param in_batch       The operations to write.
+    * @param out_failed     The operations which could not be written, to be retried.
+    */
+   void writeBatch(const PendingWrites& in_batch, PendingWrites& out_failed) const;
+
+   /** The directory in which job files are stored. */
+   const system::FilePath m_jobsPath;
+
+   /** Protects the members below. */
+   std::mutex m_mutex;
+
+   /** Notified when operations are queued or the writer is stopping. */
+   std::condition_variable m_queuedCondVar;
+
+   /** Notified when a batch has been written. */
+   std::condition_variable m_writtenCondVar;
+
+   /** The operations which have not been written yet. */
+   PendingWrites m_pending;
+
+   /** The number of batches which have been taken from the queue and the number which have been written. */
+   uint64_t m_batchesStarted;
+   uint64_t m_batchesWritten;
+
+   /** Whether the writer is stopping. */
+   bool m_isStopping;
+
+   /** The writer thread. */
+   std::thread m_thread;
+};
+
+} // namespace local
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
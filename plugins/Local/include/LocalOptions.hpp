@@ -42,6 +42,14 @@ public:
     */
    static LocalOptions& getInstance();
 
+   /**
+    * @brief Gets the cgroup v2 directory under which each job should be placed in its own cgroup.
+    *
+    * @return The cgroup v2 directory under which each job should be placed in its own cgroup, or an empty path if jobs
+    *         should not be placed in cgroups.
+    */
+   const system::FilePath& getJobCgroupPath() const;
+
    /**
     * @brief Gets the number of seconds that can elapse before an attempted connection to another local node will be
     *        timed out.
@@ -78,6 +86,11 @@ private:
     */
    LocalOptions() = default;
 
+   /**
+    * The cgroup v2 directory under which each job should be placed in its own cgroup.
+    */
+   system::FilePath m_jobCgroupPath;
+
    /**
     * The number of seconds that can elapse before an attempted connection to another local node will be timed out.
     */
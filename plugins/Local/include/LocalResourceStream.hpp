@@ -26,6 +26,8 @@
 
 #include <api/stream/AbstractTimedResourceStream.hpp>
 
+#include <LocalJobCgroup.hpp>
+
 namespace rstudio {
 namespace launcher_plugins {
 namespace local {
@@ -97,6 +99,9 @@ private:
    // The PID of the process of the job.
    pid_t m_pid;
 
+   // The cgroup of the job, if it has one.
+   LocalJobCgroup m_cgroup;
+
    // The last observed number of system ticks. Used to calculate CPU Percent.
    clock_t m_lastSysTicks;
 
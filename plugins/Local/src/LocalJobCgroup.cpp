@@ -0,0 +1,198 @@
+/*
+ * LocalJobCgroup.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <LocalJobCgroup.hpp>
+
+#include <fcntl.h>
+#include <sstream>
+#include <unistd.h>
+
+#include <boost/algorithm/string/trim.hpp>
+
+#include <Error.hpp>
+#include <SafeConvert.hpp>
+#include <utils/FileUtils.hpp>
+
+#include <LocalOptions.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace local {
+
+namespace {
+
+system::FilePath getCgroupPath(const std::string& in_jobId)
+{
+   const system::FilePath& root = LocalOptions::getInstance().getJobCgroupPath();
+   if (root.isEmpty())
+      return root;
+
+   return root.completeChildPath(in_jobId);
+}
+
+Error checkProcsWritable(const system::FilePath& in_cgroup)
+{
+   // Opening cgroup.procs for writing doesn't move any processes, so it's a safe way to check that processes can be
+   // moved into the cgroup (i.e. that it has been delegated to this user).
+   system::FilePath procsFile = in_cgroup.completeChildPath("cgroup.procs");
+   int fd = ::open(procsFile.getAbsolutePath().c_str(), O_WRONLY | O_CLOEXEC);
+   if (fd == -1)
+   {
+      return systemError(
+         errno,
+         "Processes cannot be moved into cgroup " + in_cgroup.getAbsolutePath() +
+            " - it may not be a cgroup v2 directory delegated to this user",
+         ERROR_LOCATION);
+   }
+
+   ::close(fd);
+   return Success();
+}
+
+} // anonymous namespace
+
+Error LocalJobCgroup::create(const std::string& in_jobId, LocalJobCgroup& out_cgroup)
+{
+   system::FilePath path = getCgroupPath(in_jobId);
+   if (path.isEmpty())
+      return Success();
+
+   // Moving a process between cgroups also requires write access to the cgroup.procs file of their common ancestor.
+   Error error = checkProcsWritable(path.getParent());
+   if (error)
+      return error;
+
+   error = path.ensureDirectory();
+   if (error)
+      return error;
+
+   // Don't leave behind a cgroup which can't be used.
+   LocalJobCgroup cgroup;
+   cgroup.m_path = path;
+   error = checkProcsWritable(path);
+   if (error)
+   {
+      cgroup.remove();
+      return error;
+   }
+
+   out_cgroup = cgroup;
+   return Success();
+}
+
+LocalJobCgroup LocalJobCgroup::get(const std::string& in_jobId)
+{
+   LocalJobCgroup cgroup;
+   system::FilePath path = getCgroupPath(in_jobId);
+   if (!path.isEmpty() && path.exists())
+      cgroup.m_path = path;
+
+   return cgroup;
+}
+
+Error LocalJobCgroup::getCpuUsage(uint64_t& out_usageMicroseconds) const
+{
+   std::string contents;
+   Error error = utils::readFileIntoString(m_path.completeChildPath("cpu.stat"), contents);
+   if (error)
+      return error;
+
+   // cpu.stat is a flat keyed file. usage_usec is always present, regardless of which controllers are enabled.
+   std::istringstream stream(contents);
+   std::string key, value;
+   while (stream >> key >> value)
+   {
+      if (key == "usage_usec")
+      {
+         out_usageMicroseconds = safe_convert::stringTo<uint64_t>(value, 0);
+         return Success();
+      }
+   }
+
+   return systemError(ENODATA, "cpu.stat did not contain usage_usec", ERROR_LOCATION);
+}
+
+Error LocalJobCgroup::getMemoryUsage(uint64_t& out_bytes) const
+{
+   std::string contents;
+   Error error = utils::readFileIntoString(m_path.completeChildPath("memory.current"), contents);
+   if (error)
+      return error;
+
+   Optional<uint64_t> bytes = safe_convert::stringTo<uint64_t>(boost::trim_copy(contents));
+   if (!bytes)
+      return systemError(ENODATA, "memory.current did not contain a number", ERROR_LOCATION);
+
+   out_bytes = bytes.getValueOr(0);
+   return Success();
+}
+
+const system::FilePath& LocalJobCgroup::getPath() const
+{
+   return m_path;
+}
+
+Error LocalJobCgroup::getPids(std::set<pid_t>& out_pids) const
+{
+   std::string contents;
+   Error error = utils::readFileIntoString(m_path.completeChildPath("cgroup.procs"), contents);
+   if (error)
+      return error;
+
+   std::istringstream stream(contents);
+   pid_t pid;
+   while (stream >> pid)
+      out_pids.insert(pid);
+
+   return Success();
+}
+
+bool LocalJobCgroup::isEmpty() const
+{
+   return m_path.isEmpty();
+}
+
+Error LocalJobCgroup::kill() const
+{
+   system::FilePath killFile = m_path.completeChildPath("cgroup.kill");
+   if (!killFile.exists())
+      return systemError(ENOTSUP, "cgroup.kill is not supported", ERROR_LOCATION);
+
+   return utils::writeStringToFile("1", killFile);
+}
+
+Error LocalJobCgroup::remove() const
+{
+   if (m_path.isEmpty() || !m_path.exists())
+      return Success();
+
+   // cgroup directories can't be removed recursively, since they contain interface files which can't be unlinked.
+   if (::rmdir(m_path.getAbsolutePath().c_str()) != 0)
+      return systemError(errno, "Failed to remove job cgroup " + m_path.getAbsolutePath(), ERROR_LOCATION);
+
+   return Success();
+}
+
+} // namespace local
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -23,6 +23,9 @@
 
 #include <LocalJobRepository.hpp>
 
+#include <map>
+#include <vector>
+
 #include <Error.hpp>
 #include <json/Json.hpp>
 #include <options/Options.hpp>
@@ -49,44 +52,62 @@ constexpr const char* OUT_FILE_EXT = ".stdout";
 constexpr const char* ROOT_JOBS_DIR = "jobs";
 constexpr const char* ROOT_OUTPUT_DIR = "output";
 
-inline void deleteFileAsUser(const system::User& in_user, const FilePath& in_file)
+/**
+ * @brief Output files of removed jobs which belong to the same user.
+ */
+struct UserOutputFiles
 {
-   if (!in_file.isEmpty())
-   {
-      logging::logDebugMessage("Deleting job file: " + in_file.getAbsolutePath());
+   system::User User;
+   std::vector<FilePath> Files;
+};
 
-      system::process::ProcessOptions opts;
-      opts.Executable = "rm";
-      opts.Arguments = { "-f", in_file.getAbsolutePath() };
-      opts.RunAsUser = in_user;
-      opts.IsShellCommand = true;
+inline void deleteFilesAsUser(const system::User& in_user, const std::vector<FilePath>& in_files)
+{
+   if (in_files.empty())
+      return;
 
-      system::process::ProcessResult result;
-      system::process::SyncChildProcess rmProc(opts);
-      Error error = rmProc.run(result);
-      if (error)
-      {
-         logging::logErrorMessage("Could not delete output file: " + in_file.getAbsolutePath(), ERROR_LOCATION);
-         logging::logError(error, ERROR_LOCATION);
-      }
-      else if (result.ExitCode != 0)
-      {
-         logging::logErrorMessage(
-            "Deleting output file " +
-               in_file.getAbsolutePath() +
-               " exited with non-zero exit code: " +
-               std::to_string(result.ExitCode),
-            ERROR_LOCATION);
+   system::process::ProcessOptions opts;
+   opts.Executable = "rm";
+   opts.Arguments = { "-f" };
+   opts.RunAsUser = in_user;
+   opts.IsShellCommand = true;
 
-         logging::logDebugMessage(
-            "Delete output file stdout: " + result.StdOut + "\nDelete output file stderr:" + result.StdError);
-      }
+   for (const FilePath& file: in_files)
+   {
+      logging::logDebugMessage("Deleting job file: " + file.getAbsolutePath());
+      opts.Arguments.push_back(file.getAbsolutePath());
+   }
 
-      // If the file couldn't be deleted, treat it as a permissions issue.
-      if (in_file.exists())
+   system::process::ProcessResult result;
+   system::process::SyncChildProcess rmProc(opts);
+   Error error = rmProc.run(result);
+   if (error)
+   {
+      logging::logErrorMessage(
+         "Could not delete output files of user " + in_user.getUsername(),
+         ERROR_LOCATION);
+      logging::logError(error, ERROR_LOCATION);
+   }
+   else if (result.ExitCode != 0)
+   {
+      logging::logErrorMessage(
+         "Deleting output files of user " +
+            in_user.getUsername() +
+            " exited with non-zero exit code: " +
+            std::to_string(result.ExitCode),
+         ERROR_LOCATION);
+
+      logging::logDebugMessage(
+         "Delete output file stdout: " + result.StdOut + "\nDelete output file stderr:" + result.StdError);
+   }
+
+   // If a file couldn't be deleted, treat it as a permissions issue.
+   for (const FilePath& file: in_files)
+   {
+      if (file.exists())
       {
          logging::logError(
-            systemError(EPERM, "Could not delete output file: " + in_file.getAbsolutePath(), ERROR_LOCATION));
+            systemError(EPERM, "Could not delete output file: " + file.getAbsolutePath(), ERROR_LOCATION));
       }
    }
 }
@@ -154,11 +175,6 @@ inline Error ensureUserDirectory( const system::FilePath& in_userDirectory, cons
    return Success();
 }
 
-inline FilePath getJobFilePath(const std::string& in_id, const system::FilePath& in_jobsPath)
-{
-   return in_jobsPath.completeChildPath(in_id + JOB_FILE_EXT);
-}
-
 inline Error readJobFromFile(const FilePath& in_jobFile, api::JobPtr& out_job)
 {
    // Programmer error if the out_job is a nullptr.
@@ -185,7 +201,8 @@ LocalJobRepository::LocalJobRepository(const std::string& in_hostname, jobs::Job
    m_jobsRootPath(options::Options::getInstance().getScratchPath().completeChildPath(ROOT_JOBS_DIR)),
    m_jobsPath(m_jobsRootPath.completeChildPath(m_hostname)),
    m_saveUnspecifiedOutput(LocalOptions::getInstance().shouldSaveUnspecifiedOutput()),
-   m_outputRootPath(options::Options::getInstance().getScratchPath().completeChildPath(ROOT_OUTPUT_DIR))
+   m_outputRootPath(options::Options::getInstance().getScratchPath().completeChildPath(ROOT_OUTPUT_DIR)),
+   m_jobWriter(new LocalJobWriter(m_jobsPath))
 {
 }
 
@@ -194,11 +211,7 @@ void LocalJobRepository::saveJob(api::JobPtr in_job) const
    LOCK_JOB(in_job)
    {
       if (m_hostname == in_job->Host)
-      {
-         Error error = utils::writeStringToFile(in_job->toJson().write(), getJobFilePath(in_job->Id, m_jobsPath));
-         if (error)
-            logging::logError(error, ERROR_LOCATION);
-      }
+         m_jobWriter->save(in_job);
    }
    END_LOCK_JOB
 }
@@ -290,32 +303,41 @@ void LocalJobRepository::onJobAdded(const api::JobPtr& in_job)
    saveJob(in_job);
 }
 
-void LocalJobRepository::onJobRemoved(const api::JobPtr& in_job)
+void LocalJobRepository::onJobsRemoved(const api::JobList& in_jobs)
 {
-   LOCK_JOB(in_job)
+   // Group output files by user so only one process is started per user, rather than one per file.
+   std::map<std::string, UserOutputFiles> outputFiles;
+   for (const api::JobPtr& job: in_jobs)
    {
-      if (in_job->Host != m_hostname)
+      LOCK_JOB(job)
       {
-         logging::logDebugMessage("Not deleting job files for job " + in_job->Id + " owned by host " + in_job->Host);
-         return;
-      }
+         if (job->Host != m_hostname)
+         {
+            logging::logDebugMessage("Not deleting job files for job " + job->Id + " owned by host " + job->Host);
+            continue;
+         }
 
-      logging::logDebugMessage("Deleting job files for job: " + in_job->Id);
+         logging::logDebugMessage("Deleting job files for job: " + job->Id);
 
-      FilePath jobFile = getJobFilePath(in_job->Id, m_jobsPath);
-      Error error = jobFile.removeIfExists();
-      if (error)
-         logging::logError(error, ERROR_LOCATION);
+         // Remove the job file through the writer so it can't be rewritten by a save which is still queued.
+         m_jobWriter->remove(job->Id);
 
-      FilePath stdoutFile(in_job->StandardOutFile);
-      FilePath stderrFile(in_job->StandardErrFile);
+         UserOutputFiles& userFiles = outputFiles[job->User.getUsername()];
+         userFiles.User = job->User;
 
-      if (stdoutFile.isWithin(m_outputRootPath))
-         deleteFileAsUser(in_job->User, stdoutFile);
-      if (stderrFile.isWithin(m_outputRootPath))
-         deleteFileAsUser(in_job->User, stderrFile);
+         FilePath stdoutFile(job->StandardOutFile);
+         FilePath stderrFile(job->StandardErrFile);
+
+         if (stdoutFile.isWithin(m_outputRootPath))
+            userFiles.Files.push_back(stdoutFile);
+         if (stderrFile.isWithin(m_outputRootPath))
+            userFiles.Files.push_back(stderrFile);
+      }
+      END_LOCK_JOB
    }
-   END_LOCK_JOB
+
+   for (const auto& userFiles: outputFiles)
+      deleteFilesAsUser(userFiles.second.User, userFiles.second.Files);
 }
 
 Error LocalJobRepository::onInitialize()
@@ -335,6 +357,10 @@ Error LocalJobRepository::onInitialize()
    return Success();
 }
 
+void LocalJobRepository::onFlush()
+{
+   m_jobWriter->flush();
+}
 
 } // namespace local
 } // namespace launcher_plugins
@@ -28,13 +28,16 @@
 #include <boost/algorithm/string.hpp>
 
 #include <json/Json.hpp>
+#include <options/Options.hpp>
 #include <system/Asio.hpp>
 #include <system/DateTime.hpp>
 #include <system/Crypto.hpp>
+#include <system/ExecMonitor.hpp>
 #include <system/Process.hpp>
 
 #include <LocalConstants.hpp>
 #include <LocalError.hpp>
+#include <LocalJobCgroup.hpp>
 #include <LocalJobRepository.hpp>
 
 namespace rstudio {
@@ -47,6 +50,10 @@ typedef std::shared_ptr<LocalJobRunner> SharedThis;
 
 namespace {
 
+// When exec events are available, the job is only polled occasionally in case an event is missed. Starting the poll
+// count here skips the initial fast polling.
+constexpr int s_eventDrivenPollCount = 6;
+
 Error decryptPassword(const api::JobPtr& in_job, const std::string& in_key, std::string& out_password)
 {
    Optional<std::string> encryptedPasswordOpt = in_job->getJobConfigValue(s_encryptedPassword);
@@ -159,6 +166,12 @@ LocalJobRunner::LocalJobRunner(
 
 Error LocalJobRunner::initialize()
 {
+   // Exec events let jobs be marked as running as soon as rsandbox executes the job. Without them, job processes are
+   // polled instead.
+   Error error = system::process::ExecMonitor::start();
+   if (error)
+      logging::logDebugMessage("Process exec events are unavailable; job processes will be polled: " + error.asString());
+
    return m_secureCookie.initialize();
 }
 
@@ -188,6 +201,16 @@ Error LocalJobRunner::runJob(api::JobPtr& io_job, bool& out_wasInvalidJob)
       return error;
    }
 
+   // Place the job in its own cgroup, if enabled, so its processes can be accounted for and killed as a unit. Every job
+   // is also the leader of its own process group, so the job's PID is its process group ID. If the cgroup can't be
+   // created, the job is still run but is only contained by its process group.
+   LocalJobCgroup cgroup;
+   error = LocalJobCgroup::create(io_job->Id, cgroup);
+   if (error)
+      logging::logError(error, ERROR_LOCATION);
+   else
+      procOpts.ControlGroup = cgroup.getPath();
+
    // Set up the onExit and onStderr (for logging) callbacks.
    system::process::AsyncProcessCallbacks callbacks;
    callbacks.OnExit = std::bind(
@@ -204,19 +227,44 @@ Error LocalJobRunner::runJob(api::JobPtr& io_job, bool& out_wasInvalidJob)
    std::shared_ptr<system::process::AbstractChildProcess> childProcess;
    error = system::process::ProcessSupervisor::runAsyncProcess(procOpts, callbacks, &childProcess);
    if (error || (childProcess == nullptr))
+   {
+      cgroup.remove();
       return createError(
          LocalError::JOB_LAUNCH_ERROR,
          "Could not launch process for job " + jobId,
          error,
          ERROR_LOCATION);
+   }
 
    // Set the PID and then notify about the PENDING status update.
    io_job->Pid = childProcess->getPid();
    m_notifier->updateJob(io_job, State::PENDING);
 
+   // Watch for rsandbox executing the job. With exec events, the exec notification drives the RUNNING transition and
+   // polling only falls back every 5 seconds in case an event is missed. Otherwise poll, starting after 100
+   // milliseconds.
+   WeakLocalJobRunner weakThis = weak_from_this();
+   bool isEventDriven = system::process::ExecMonitor::watch(
+      io_job->Pid.getValueOr(0),
+      [weakThis, io_job]()
+      {
+         LocalJobRunner::onProcessExec(weakThis, io_job);
+      });
+
+   // The exec may have happened before the watch started, so check the process once now.
+   bool isDone = false;
+   LOCK_JOB(io_job)
+   {
+      isDone = checkProcessState(io_job);
+   }
+   END_LOCK_JOB
+
+   if (isDone)
+      return Success();
+
    auto jobWatchEvent = std::make_shared<system::AsyncDeadlineEvent>(
-      std::bind(LocalJobRunner::onProcessWatchDeadline, weak_from_this(), 1, io_job),
-      system::TimeDuration::Microseconds(100000));
+      std::bind(LocalJobRunner::onProcessWatchDeadline, weakThis, isEventDriven ? s_eventDrivenPollCount : 1, io_job),
+      isEventDriven ? system::TimeDuration::Seconds(5) : system::TimeDuration::Microseconds(100000));
    addProcessWatchEvent(io_job->Id, jobWatchEvent);
    jobWatchEvent->start();
 
@@ -275,6 +323,16 @@ void LocalJobRunner::onJobExitCallback(WeakLocalJobRunner in_weakThis, int in_ex
 
          io_job->ExitCode = in_exitCode;
 
+         // Stop watching for the job to start running.
+         system::process::ExecMonitor::unwatch(io_job->Pid.getValueOr(0));
+         sharedThis->removeWatchEvent(io_job->Id);
+
+         // The cgroup can only be removed once every process in it has exited, so this may fail if the job left
+         // background processes running.
+         Error error = LocalJobCgroup::get(io_job->Id).remove();
+         if (error)
+            logging::logError(error, ERROR_LOCATION);
+
          // If the job was explicitly killed, the status doesn't need to be changed so there's no need to notify.
          // Normally notifying the status update will save the job, so save the job manually this time. Otherwise,
          // update the status appropriately.
@@ -299,6 +357,48 @@ void LocalJobRunner::onJobExitCallback(WeakLocalJobRunner in_weakThis, int in_ex
    }
 }
 
+bool LocalJobRunner::checkProcessState(const api::JobPtr& io_job)
+{
+   // Check the job status. If it already exited or an earlier check found it running, just stop watching.
+   if (io_job->Status != State::PENDING)
+   {
+      stopProcessWatch(io_job);
+      return true;
+   }
+
+   system::process::ProcessInfo procInfo;
+   Error error = system::process::ProcessInfo::getProcessInfo(io_job->Pid.getValueOr(0), procInfo);
+   if (error)
+   {
+      logging::logError(error, ERROR_LOCATION);
+      stopProcessWatch(io_job);
+      return true;
+   }
+
+   // If the process is no longer rsandbox, then the job is running. Update the status and exit. The executable is
+   // reported as an absolute path, so compare it with the resolved rsandbox path.
+   if (procInfo.Executable != options::Options::getInstance().getRSandboxPath().getAbsolutePath())
+   {
+      m_notifier->updateJob(io_job, State::RUNNING);
+      stopProcessWatch(io_job);
+      return true;
+   }
+
+   return false;
+}
+
+void LocalJobRunner::onProcessExec(WeakLocalJobRunner in_weakThis, api::JobPtr io_job)
+{
+   if (SharedThis sharedThis = in_weakThis.lock())
+   {
+      LOCK_JOB(io_job)
+      {
+         sharedThis->checkProcessState(io_job);
+      }
+      END_LOCK_JOB
+   }
+}
+
 void LocalJobRunner::onProcessWatchDeadline(WeakLocalJobRunner in_weakThis, int in_count, api::JobPtr io_job)
 {
    if (SharedThis sharedThis = in_weakThis.lock())
@@ -308,39 +408,14 @@ void LocalJobRunner::onProcessWatchDeadline(WeakLocalJobRunner in_weakThis, int
       {
          logging::logErrorMessage(
             "Job " + io_job->Id + " did not transition to a running state within a reasonable time.");
+         system::process::ExecMonitor::unwatch(io_job->Pid.getValueOr(0));
          return;
       }
 
       LOCK_JOB(io_job)
       {
-         // Check the job status. If it already exited, just stop watching.
-         if ((io_job->Status == State::KILLED) || (io_job->Status == State::FINISHED))
-         {
-            // Remove the watch event to prevent an ever-growing map.
-            sharedThis->removeWatchEvent(io_job->Id);
+         if (sharedThis->checkProcessState(io_job))
             return;
-         }
-
-         system::process::ProcessInfo procInfo;
-         Error error = system::process::ProcessInfo::getProcessInfo(io_job->Pid.getValueOr(0), procInfo);
-         if (error)
-         {
-            logging::logError(error, ERROR_LOCATION);
-
-            // Remove the watch event to prevent an ever-growing map.
-            sharedThis->removeWatchEvent(io_job->Id);
-            return;
-         }
-
-         // If the process name has changed from rsandbox, then the job is running. Update the status and exit.
-         if (procInfo.Executable != "rsandbox")
-         {
-            sharedThis->m_notifier->updateJob(io_job, State::RUNNING);
-
-            // Remove the watch event to prevent an ever-growing map.
-            sharedThis->removeWatchEvent(io_job->Id);
-            return;
-         }
       }
       END_LOCK_JOB
 
@@ -370,6 +445,14 @@ void LocalJobRunner::addProcessWatchEvent(
    END_LOCK_MUTEX
 }
 
+void LocalJobRunner::stopProcessWatch(const api::JobPtr& in_job)
+{
+   system::process::ExecMonitor::unwatch(in_job->Pid.getValueOr(0));
+
+   // Remove the watch event to prevent an ever-growing map.
+   removeWatchEvent(in_job->Id);
+}
+
 void LocalJobRunner::removeWatchEvent(const std::string& in_id)
 {
    LOCK_MUTEX(m_mutex)
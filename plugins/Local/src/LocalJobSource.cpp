@@ -31,6 +31,7 @@
 #include <system/Process.hpp>
 
 #include <LocalConstants.hpp>
+#include <LocalJobCgroup.hpp>
 #include <LocalResourceStream.hpp>
 
 namespace rstudio {
@@ -97,28 +98,28 @@ Error LocalJobSource::getConfiguration(const system::User&, api::JobSourceConfig
 
 Error LocalJobSource::getNetworkInfo(api::JobPtr in_job, api::NetworkInfo& out_networkInfo) const
 {
-   using system::posix::IpAddress;
-   std::vector<IpAddress> addresses;
-   Error error = system::posix::getIpAddresses(addresses, true);
+   // Return all addresses except the loop-back and link local addresses.
+   system::posix::IpAddressListPtr addresses;
+   Error error = system::posix::getReachableIpAddresses(addresses);
    if (error)
       return error;
 
    out_networkInfo.Hostname = in_job->Host;
-   for (const IpAddress& addr: addresses)
-   {
-      // Return all addresses except the loop-back and link local addresses.
-      if ((addr.Address.find("127") != 0) &&
-         (addr.Address.find("::1") != 0) &&
-         (addr.Address.find("%") == std::string::npos))
-         out_networkInfo.IpAddresses.push_back(addr.Address);
-   }
+   out_networkInfo.IpAddresses = *addresses;
 
    return Success();
 }
 
 bool LocalJobSource::killJob(api::JobPtr in_job, bool& out_isComplete, std::string& out_statusMessage)
 {
-   out_isComplete = signalJob(in_job->Id, in_job->Pid, SIGKILL, "kill", out_statusMessage);
+   // If the job has a cgroup, kill everything in it at once. This includes any processes which have left the job's
+   // process group. Otherwise fall back to signalling the process group.
+   LocalJobCgroup cgroup = LocalJobCgroup::get(in_job->Id);
+   if (!cgroup.isEmpty() && !cgroup.kill())
+      out_isComplete = true;
+   else
+      out_isComplete = signalJob(in_job->Id, in_job->Pid, SIGKILL, "kill", out_statusMessage);
+
    if (out_isComplete)
       m_jobStatusNotifier->updateJob(in_job, api::Job::State::KILLED);
 
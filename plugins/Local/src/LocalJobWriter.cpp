@@ -0,0 +1,317 @@
+/*
+ * LocalJobWriter.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <LocalJobWriter.hpp>
+
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+
+#include <Error.hpp>
+#include <logging/Logger.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace local {
+
+namespace {
+
+constexpr const char* JOB_FILE_EXT = ".job";
+constexpr const char* TEMP_FILE_EXT = ".tmp";
+
+/** The maximum number of temporary job files which are open at once. */
+constexpr size_t MAX_OPEN_FILES = 64;
+
+/** How long to wait before retrying operations which failed. */
+constexpr std::chrono::seconds RETRY_DELAY(1);
+
+Error writeAll(int in_fd, const std::string& in_contents)
+{
+   size_t written = 0;
+   while (written < in_contents.size())
+   {
+      ssize_t ret = ::write(in_fd, in_contents.data() + written, in_contents.size() - written);
+      if (ret < 0)
+      {
+         if (errno == EINTR)
+            continue;
+         return systemError(errno, ERROR_LOCATION);
+      }
+
+      written += static_cast<size_t>(ret);
+   }
+
+   return Success();
+}
+
+/**
+ * @brief A temporary job file which has been written but not yet synced or renamed over the job file.
+ */
+struct TempJobFile
+{
+   int Fd;
+   system::FilePath TempFile;
+   system::FilePath JobFile;
+   const std::pair<const std::string, api::JobPtr>* Pending;
+};
+
+void logFileError(Error& io_error, const system::FilePath& in_file)
+{
+   io_error.addProperty("path", in_file.getAbsolutePath());
+   logging::logError(io_error);
+}
+
+/**
+ * @brief Syncs written temporary job files and renames each over its job file. Closes every temporary file.
+ *
+ * The files are synced only after all of them have been written, so the kernel can write them back together. A job
+ * file is only replaced once its replacement is durable.
+ *
+ * @param in_tempFiles   The temporary job files.
+ * @param io_failed      The operations which failed. Any operation which fails here is added.
+ *
+ * @return True if any job file was replaced; false otherwise.
+ */
+bool syncAndRename(
+   const std::vector<TempJobFile>& in_tempFiles,
+   std::map<std::string, api::JobPtr>& io_failed)
+{
+   bool renamed = false;
+   for (const TempJobFile& tempFile: in_tempFiles)
+   {
+      int ret = ::fsync(tempFile.Fd);
+      int syncErrno = errno;
+      ::close(tempFile.Fd);
+
+      if (ret != 0)
+      {
+         Error error = systemError(syncErrno, ERROR_LOCATION);
+         logFileError(error, tempFile.TempFile);
+         tempFile.TempFile.removeIfExists();
+         io_failed.insert(*tempFile.Pending);
+         continue;
+      }
+
+      if (::rename(tempFile.TempFile.getAbsolutePath().c_str(), tempFile.JobFile.getAbsolutePath().c_str()) != 0)
+      {
+         Error error = systemError(errno, ERROR_LOCATION);
+         logFileError(error, tempFile.JobFile);
+         tempFile.TempFile.removeIfExists();
+         io_failed.insert(*tempFile.Pending);
+         continue;
+      }
+
+      renamed = true;
+   }
+
+   return renamed;
+}
+
+} // anonymous namespace
+
+LocalJobWriter::LocalJobWriter(system::FilePath in_jobsPath) :
+   m_jobsPath(std::move(in_jobsPath)),
+   m_batchesStarted(0),
+   m_batchesWritten(0),
+   m_isStopping(false)
+{
+   m_thread = std::thread(&LocalJobWriter::run, this);
+}
+
+LocalJobWriter::~LocalJobWriter()
+{
+   try
+   {
+      LOCK_MUTEX(m_mutex)
+      {
+         m_isStopping = true;
+      }
+      END_LOCK_MUTEX
+
+      m_queuedCondVar.notify_all();
+      if (m_thread.joinable())
+         m_thread.join();
+   }
+   catch (...)
+   {
+      // Swallow exceptions in destructors.
+   }
+}
+
+void LocalJobWriter::flush()
+{
+   UNIQUE_LOCK_MUTEX(m_mutex)
+   {
+      // Anything queued before now is either in the next batch or in one which has already been started.
+      const uint64_t target = m_batchesStarted + (m_pending.empty() ? 0 : 1);
+      m_writtenCondVar.wait(uniqueLock, [this, target]() { return m_batchesWritten >= target; });
+   }
+   END_LOCK_MUTEX
+}
+
+void LocalJobWriter::remove(const std::string& in_jobId)
+{
+   LOCK_MUTEX(m_mutex)
+   {
+      m_pending[in_jobId] = api::JobPtr();
+   }
+   END_LOCK_MUTEX
+
+   m_queuedCondVar.notify_one();
+}
+
+void LocalJobWriter::save(const api::JobPtr& in_job)
+{
+   LOCK_MUTEX(m_mutex)
+   {
+      m_pending[in_job->Id] = in_job;
+   }
+   END_LOCK_MUTEX
+
+   m_queuedCondVar.notify_one();
+}
+
+system::FilePath LocalJobWriter::getJobFilePath(const std::string& in_jobId) const
+{
+   return m_jobsPath.completeChildPath(in_jobId + JOB_FILE_EXT);
+}
+
+void LocalJobWriter::run()
+{
+   UNIQUE_LOCK_MUTEX(m_mutex)
+   {
+      while (true)
+      {
+         m_queuedCondVar.wait(uniqueLock, [this]() { return m_isStopping || !m_pending.empty(); });
+
+         // Only stop once everything queued has been written.
+         if (m_pending.empty())
+            break;
+
+         PendingWrites batch;
+         batch.swap(m_pending);
+         ++m_batchesStarted;
+
+         PendingWrites failed;
+         uniqueLock.unlock();
+         writeBatch(batch, failed);
+         uniqueLock.lock();
+
+         ++m_batchesWritten;
+         m_writtenCondVar.notify_all();
+
+         // Retry failed operations in a later batch, unless the job has been queued again since. Once stopping, the
+         // failures have been logged and are not retried, so the writer can't be kept from stopping.
+         if (!failed.empty() && !m_isStopping)
+         {
+            m_pending.insert(failed.begin(), failed.end());
+            m_queuedCondVar.wait_for(uniqueLock, RETRY_DELAY, [this]() { return m_isStopping; });
+         }
+      }
+   }
+   END_LOCK_MUTEX
+}
+
+void LocalJobWriter::writeBatch(const PendingWrites& in_batch, PendingWrites& out_failed) const
+{
+   std::vector<TempJobFile> tempFiles;
+   tempFiles.reserve(MAX_OPEN_FILES);
+   bool renamed = false;
+   for (const auto& pending: in_batch)
+   {
+      system::FilePath jobFile = getJobFilePath(pending.first);
+      if (pending.second == nullptr)
+      {
+         logging::logDebugMessage("Deleting job file: " + jobFile.getAbsolutePath());
+         Error error = jobFile.removeIfExists();
+         if (error)
+         {
+            logging::logError(error, ERROR_LOCATION);
+            out_failed.insert(pending);
+         }
+         continue;
+      }
+
+      // Serialize the job now so that the latest state is written.
+      std::string contents;
+      LOCK_JOB(pending.second)
+      {
+         contents = pending.second->toJson().write();
+      }
+      END_LOCK_JOB
+
+      system::FilePath tempFile(jobFile.getAbsolutePath() + TEMP_FILE_EXT);
+      // Job files are created with the same mode as before, subject to the umask.
+      int fd = ::open(
+         tempFile.getAbsolutePath().c_str(),
+         O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+         S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+      if (fd < 0)
+      {
+         Error error = systemError(errno, ERROR_LOCATION);
+         logFileError(error, tempFile);
+         out_failed.insert(pending);
+         continue;
+      }
+
+      Error error = writeAll(fd, contents);
+      if (error)
+      {
+         logFileError(error, tempFile);
+         ::close(fd);
+         tempFile.removeIfExists();
+         out_failed.insert(pending);
+         continue;
+      }
+
+      tempFiles.push_back(TempJobFile{ fd, tempFile, jobFile, &pending });
+
+      // Bound the number of open files, so a large backlog can't exhaust file descriptors.
+      if (tempFiles.size() >= MAX_OPEN_FILES)
+      {
+         renamed = syncAndRename(tempFiles, out_failed) || renamed;
+         tempFiles.clear();
+      }
+   }
+
+   renamed = syncAndRename(tempFiles, out_failed) || renamed;
+
+   // Sync the directory once for the whole batch so the renames are durable.
+   if (renamed)
+   {
+      int dirFd = ::open(m_jobsPath.getAbsolutePath().c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if ((dirFd < 0) || (::fsync(dirFd) != 0))
+      {
+         Error error = systemError(errno, ERROR_LOCATION);
+         logFileError(error, m_jobsPath);
+      }
+
+      if (dirFd >= 0)
+         ::close(dirFd);
+   }
+}
+
+} // namespace local
+} // namespace launcher_plugins
+} // namespace rstudio
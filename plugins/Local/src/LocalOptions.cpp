@@ -34,6 +34,11 @@ LocalOptions& LocalOptions::getInstance()
    return options;
 }
 
+const system::FilePath& LocalOptions::getJobCgroupPath() const
+{
+   return m_jobCgroupPath;
+}
+
 size_t LocalOptions::getNodeConnectionTimeoutSeconds() const
 {
    return m_nodeConnectionTimeoutSeconds;
@@ -51,6 +56,10 @@ void LocalOptions::initialize()
    using namespace rstudio::launcher_plugins::options;
    Options& options = Options::getInstance();
    options.registerOptions()
+      ("job-cgroup-path",
+       Value<FilePath>(m_jobCgroupPath).setDefaultValue(FilePath()),
+       "cgroup v2 directory, delegated to the server user, under which each job is placed in its own cgroup - empty to "
+       "disable")
       ("node-connection-timeout-seconds",
        Value<size_t>(m_nodeConnectionTimeoutSeconds).setDefaultValue(3),
        "amount of seconds to allow for outgoing connections to other nodes in a load balanced cluster or 0 to use "
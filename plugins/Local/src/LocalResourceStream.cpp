@@ -56,8 +56,19 @@ system::FilePath getStatRootPath(pid_t in_pid)
    return system::FilePath("/proc").completeChildPath(std::to_string(in_pid));
 }
 
-Error getChildPids(std::set<pid_t>& io_pids)
+Error getChildPids(const LocalJobCgroup& in_cgroup, std::set<pid_t>& io_pids)
 {
+   // The job's cgroup lists every process in the job directly, so there's no need to search all of /proc.
+   if (!in_cgroup.isEmpty())
+   {
+      std::set<pid_t> cgroupPids;
+      if (!in_cgroup.getPids(cgroupPids) && !cgroupPids.empty())
+      {
+         io_pids.insert(cgroupPids.begin(), cgroupPids.end());
+         return Success();
+      }
+   }
+
    std::vector<system::process::ProcessInfo> children;
    Error error = system::process::getChildProcesses(*io_pids.begin(), children);
    if (error)
@@ -130,10 +141,18 @@ Error readStatFields(
    return readStatFields(fields, in_args...);
 }
 
-Error getProcessTicks(pid_t in_rootPid, clock_t& out_ticks)
+Error getProcessTicks(pid_t in_rootPid, const LocalJobCgroup& in_cgroup, double in_ticksPerSecond, clock_t& out_ticks)
 {
+   // The job's cgroup tracks the CPU time of every process that has run in it, in microseconds.
+   uint64_t usageMicroseconds = 0;
+   if (!in_cgroup.isEmpty() && !in_cgroup.getCpuUsage(usageMicroseconds))
+   {
+      out_ticks = static_cast<clock_t>((static_cast<double>(usageMicroseconds) * in_ticksPerSecond) / 1000000.0);
+      return Success();
+   }
+
    std::set<pid_t> pids = { in_rootPid };
-   Error error = getChildPids(pids);
+   Error error = getChildPids(in_cgroup, pids);
    if (error)
       return error;
 
@@ -200,6 +219,7 @@ Error LocalResourceStream::onInitialize()
       }
 
       m_pid = m_job->Pid.getValueOr(0);
+      m_cgroup = LocalJobCgroup::get(m_job->Id);
 
       return Success();
    }
@@ -216,7 +236,7 @@ Error LocalResourceStream::getCpuPercent(double& out_cpuPercent)
    for (int count = 0; count < 10; ++count)
    {
       clock_t procTicks = 0;
-      Error error = getProcessTicks(m_pid, procTicks);
+      Error error = getProcessTicks(m_pid, m_cgroup, m_clockTicksPerSecond, procTicks);
       if (error)
          return error;
 
@@ -250,7 +270,7 @@ Error LocalResourceStream::getCpuPercent(double& out_cpuPercent)
 Error LocalResourceStream::getCpuSeconds(double& out_cpuTime)
 {
    clock_t procTicks = 0;
-   Error error = getProcessTicks(m_pid, procTicks);
+   Error error = getProcessTicks(m_pid, m_cgroup, m_clockTicksPerSecond, procTicks);
    if (error)
       return error;
 
@@ -263,13 +283,19 @@ Error LocalResourceStream::getCpuSeconds(double& out_cpuTime)
 Error LocalResourceStream::getMem(double& out_memPhysical, double& out_memVirtual)
 {
    std::set<pid_t> pids = { m_pid };
-   Error error = getChildPids(pids);
+   Error error = getChildPids(m_cgroup, pids);
    if (error)
       return error;
 
    out_memPhysical = 0.0;
    out_memVirtual = 0.0;
 
+   // Prefer the cgroup's own physical memory accounting, if the memory controller is enabled for it.
+   uint64_t cgroupMemBytes = 0;
+   const bool hasCgroupMem = !m_cgroup.isEmpty() && !m_cgroup.getMemoryUsage(cgroupMemBytes);
+   if (hasCgroupMem)
+      out_memPhysical = static_cast<double>(cgroupMemBytes) / 1000000.0;
+
    for (pid_t pid: pids)
    {
       system::FilePath statFile = getStatRootPath(pid).completeChildPath("statm");
@@ -292,7 +318,8 @@ Error LocalResourceStream::getMem(double& out_memPhysical, double& out_memVirtua
       {
          // Get the memory values in MB by calculating the total number of bytes (the number of pages multiplied by the 
          // number of bytes in a page), and then dividing that by 1 million to convert from bytes to MB.
-         out_memPhysical += (safe_convert::stringTo<double>(physicalPageCount, 0) * m_bytesPerPage) / 1000000.0;
+         if (!hasCgroupMem)
+            out_memPhysical += (safe_convert::stringTo<double>(physicalPageCount, 0) * m_bytesPerPage) / 1000000.0;
          out_memVirtual += (safe_convert::stringTo<double>(virtualPageCount, 0) * m_bytesPerPage) / 1000000.0;
       }
    }
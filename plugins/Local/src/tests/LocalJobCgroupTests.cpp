@@ -0,0 +1,174 @@
+/*
+ * LocalJobCgroupTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <TestMain.hpp>
+
+#include <options/Options.hpp>
+#include <system/FilePath.hpp>
+#include <utils/FileUtils.hpp>
+
+#include <LocalJobCgroup.hpp>
+#include <LocalOptions.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace local {
+
+namespace {
+
+/**
+ * @brief Gets the job-cgroup-path, which is a plain directory that stands in for a delegated cgroup v2 directory.
+ *
+ * Real cgroup interface files are created by the kernel, so the tests create whichever ones they need.
+ */
+const system::FilePath& getCgroupRoot()
+{
+   static system::FilePath root;
+   if (root.isEmpty())
+   {
+      REQUIRE_FALSE(system::FilePath::uniqueFilePath("/tmp", root));
+      REQUIRE_FALSE(root.ensureDirectory());
+
+      LocalOptions::getInstance().initialize();
+
+      const std::string cgroupPathArg = "--job-cgroup-path=" + root.getAbsolutePath();
+      const char* argv[] = { "local-cgroup-tests", cgroupPathArg.c_str() };
+      REQUIRE_FALSE(options::Options::getInstance().readOptions(2, argv, system::FilePath()));
+   }
+
+   return root;
+}
+
+void writeFile(const system::FilePath& in_file, const std::string& in_contents)
+{
+   REQUIRE_FALSE(utils::writeStringToFile(in_contents, in_file));
+}
+
+void removeCgroupDirectory(const system::FilePath& in_directory)
+{
+   std::vector<system::FilePath> children;
+   REQUIRE_FALSE(in_directory.getChildren(children));
+   for (const system::FilePath& child: children)
+      REQUIRE_FALSE(child.remove());
+
+   REQUIRE_FALSE(in_directory.remove());
+}
+
+} // anonymous namespace
+
+TEST_CASE("Local job cgroups")
+{
+   const system::FilePath& root = getCgroupRoot();
+   system::FilePath rootProcs = root.completeChildPath("cgroup.procs");
+   system::FilePath jobPath = root.completeChildPath("job1");
+
+   SECTION("Job cgroup path is not delegated")
+   {
+      REQUIRE_FALSE(rootProcs.removeIfExists());
+
+      LocalJobCgroup cgroup;
+      CHECK(LocalJobCgroup::create("job1", cgroup));
+      CHECK(cgroup.isEmpty());
+      CHECK_FALSE(jobPath.exists());
+      CHECK(LocalJobCgroup::get("job1").isEmpty());
+   }
+
+   SECTION("Processes can't be moved into the job cgroup")
+   {
+      writeFile(rootProcs, "");
+
+      // A plain directory is created, but it has no cgroup.procs file, so it isn't left behind.
+      LocalJobCgroup cgroup;
+      CHECK(LocalJobCgroup::create("job1", cgroup));
+      CHECK(cgroup.isEmpty());
+      CHECK_FALSE(jobPath.exists());
+   }
+
+   SECTION("Resource accounting")
+   {
+      writeFile(rootProcs, "");
+      REQUIRE_FALSE(jobPath.ensureDirectory());
+      writeFile(jobPath.completeChildPath("cgroup.procs"), "100\n200\n");
+      writeFile(jobPath.completeChildPath("cpu.stat"), "usage_usec 2500000\nuser_usec 2000000\nsystem_usec 500000\n");
+      writeFile(jobPath.completeChildPath("memory.current"), "1048576\n");
+
+      LocalJobCgroup cgroup;
+      REQUIRE_FALSE(LocalJobCgroup::create("job1", cgroup));
+      REQUIRE_FALSE(cgroup.isEmpty());
+      CHECK(cgroup.getPath() == jobPath);
+      CHECK(LocalJobCgroup::get("job1").getPath() == jobPath);
+
+      uint64_t usageMicroseconds = 0;
+      REQUIRE_FALSE(cgroup.getCpuUsage(usageMicroseconds));
+      CHECK(usageMicroseconds == 2500000);
+
+      uint64_t memBytes = 0;
+      REQUIRE_FALSE(cgroup.getMemoryUsage(memBytes));
+      CHECK(memBytes == 1048576);
+
+      std::set<pid_t> pids;
+      REQUIRE_FALSE(cgroup.getPids(pids));
+      CHECK(pids == std::set<pid_t>{ 100, 200 });
+
+      // Without the memory controller or usage_usec, the accounting falls back to /proc.
+      writeFile(jobPath.completeChildPath("cpu.stat"), "user_usec 2000000\n");
+      CHECK(cgroup.getCpuUsage(usageMicroseconds));
+      REQUIRE_FALSE(jobPath.completeChildPath("memory.current").remove());
+      CHECK(cgroup.getMemoryUsage(memBytes));
+
+      // cgroup.kill is only available on newer kernels.
+      CHECK(cgroup.kill());
+      system::FilePath killFile = jobPath.completeChildPath("cgroup.kill");
+      writeFile(killFile, "");
+      REQUIRE_FALSE(cgroup.kill());
+
+      std::string killContents;
+      REQUIRE_FALSE(utils::readFileIntoString(killFile, killContents));
+      CHECK(killContents == "1");
+
+      // A cgroup with interface files in it can't be removed.
+      CHECK(cgroup.remove());
+      removeCgroupDirectory(jobPath);
+      CHECK(LocalJobCgroup::get("job1").isEmpty());
+      CHECK_FALSE(cgroup.remove());
+   }
+
+   SECTION("Removal")
+   {
+      writeFile(rootProcs, "");
+      REQUIRE_FALSE(jobPath.ensureDirectory());
+      writeFile(jobPath.completeChildPath("cgroup.procs"), "");
+
+      LocalJobCgroup cgroup;
+      REQUIRE_FALSE(LocalJobCgroup::create("job1", cgroup));
+
+      // The kernel removes the interface files along with the directory, so remove them first here.
+      REQUIRE_FALSE(jobPath.completeChildPath("cgroup.procs").remove());
+      REQUIRE_FALSE(cgroup.remove());
+      CHECK_FALSE(jobPath.exists());
+   }
+}
+
+} // namespace local
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -0,0 +1,221 @@
+/*
+ * LocalJobWriterTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <TestMain.hpp>
+
+#include <sys/stat.h>
+
+#include <json/Json.hpp>
+#include <system/FilePath.hpp>
+#include <system/User.hpp>
+#include <utils/FileUtils.hpp>
+
+#include <LocalJobWriter.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace local {
+
+namespace {
+
+api::JobPtr makeJob(const std::string& in_id)
+{
+   system::User user;
+   REQUIRE_FALSE(system::User::getUserFromIdentifier(USER_ONE, user));
+
+   api::JobPtr job(new api::Job());
+   job->Id = in_id;
+   job->Name = "Job " + in_id;
+   job->Command = "echo " + in_id;
+   job->Status = api::Job::State::PENDING;
+   job->User = user;
+   return job;
+}
+
+void setName(const api::JobPtr& io_job, const std::string& in_name)
+{
+   LOCK_JOB(io_job)
+   {
+      io_job->Name = in_name;
+   }
+   END_LOCK_JOB
+}
+
+std::string readJobName(const system::FilePath& in_jobFile)
+{
+   std::string contents;
+   REQUIRE_FALSE(utils::readFileIntoString(in_jobFile, contents));
+
+   json::Object jobObj;
+   REQUIRE_FALSE(jobObj.parse(contents));
+   return jobObj["name"].getString();
+}
+
+size_t countTempFiles(const system::FilePath& in_directory)
+{
+   std::vector<system::FilePath> children;
+   REQUIRE_FALSE(in_directory.getChildren(children));
+
+   size_t count = 0;
+   for (const system::FilePath& child: children)
+   {
+      if (child.getExtension() == ".tmp")
+         ++count;
+   }
+
+   return count;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Local job writer")
+{
+   system::FilePath directory;
+   REQUIRE_FALSE(system::FilePath::uniqueFilePath("/tmp", directory));
+   REQUIRE_FALSE(directory.ensureDirectory());
+
+   system::FilePath jobFile = directory.completeChildPath("job1.job");
+
+   SECTION("Repeated saves are coalesced into the latest state")
+   {
+      LocalJobWriter writer(directory);
+      api::JobPtr job = makeJob("job1");
+      for (int i = 0; i < 100; ++i)
+      {
+         setName(job, "Name " + std::to_string(i));
+         writer.save(job);
+      }
+
+      writer.flush();
+      REQUIRE(jobFile.exists());
+      CHECK(readJobName(jobFile) == "Name 99");
+      CHECK(countTempFiles(directory) == 0);
+   }
+
+   SECTION("Remove after a queued save")
+   {
+      LocalJobWriter writer(directory);
+      api::JobPtr job = makeJob("job1");
+      writer.save(job);
+      writer.remove(job->Id);
+      writer.flush();
+      CHECK_FALSE(jobFile.exists());
+
+      // A save after the removal writes the job again.
+      writer.save(job);
+      writer.flush();
+      CHECK(jobFile.exists());
+
+      writer.remove(job->Id);
+      writer.flush();
+      CHECK_FALSE(jobFile.exists());
+   }
+
+   SECTION("Flush waits for everything queued before it")
+   {
+      // Queue more jobs than are written at once.
+      LocalJobWriter writer(directory);
+      std::vector<api::JobPtr> jobs;
+      for (int i = 0; i < 200; ++i)
+      {
+         jobs.push_back(makeJob("job" + std::to_string(i)));
+         writer.save(jobs.back());
+      }
+
+      writer.flush();
+      for (const api::JobPtr& job: jobs)
+      {
+         system::FilePath file = directory.completeChildPath(job->Id + ".job");
+         REQUIRE(file.exists());
+         CHECK(readJobName(file) == job->Name);
+      }
+
+      // Job files are created with the usual mode, subject to the umask.
+      mode_t umask = ::umask(0);
+      ::umask(umask);
+
+      struct stat st;
+      REQUIRE(::stat(jobFile.getAbsolutePath().c_str(), &st) == 0);
+      CHECK((st.st_mode & 0777) == (0666 & ~umask));
+
+      // Flushing with nothing queued returns immediately.
+      writer.flush();
+   }
+
+   SECTION("A failed write leaves the previous job file in place")
+   {
+      LocalJobWriter writer(directory);
+      api::JobPtr job = makeJob("job1");
+      setName(job, "Original");
+      writer.save(job);
+      writer.flush();
+      REQUIRE(readJobName(jobFile) == "Original");
+
+      // Block the temporary file with a directory so that the write fails.
+      system::FilePath tempFile(jobFile.getAbsolutePath() + ".tmp");
+      REQUIRE_FALSE(tempFile.ensureDirectory());
+
+      setName(job, "Updated");
+      writer.save(job);
+      writer.flush();
+      CHECK(readJobName(jobFile) == "Original");
+
+      // Once the write can succeed, the failed write is retried without the job being saved again.
+      REQUIRE_FALSE(tempFile.remove());
+      for (int i = 0; (i < 5) && (readJobName(jobFile) != "Updated"); ++i)
+         writer.flush();
+
+      CHECK(readJobName(jobFile) == "Updated");
+      CHECK(countTempFiles(directory) == 0);
+   }
+
+   SECTION("A failed write doesn't keep the writer from stopping")
+   {
+      system::FilePath tempFile(jobFile.getAbsolutePath() + ".tmp");
+      REQUIRE_FALSE(tempFile.ensureDirectory());
+
+      {
+         LocalJobWriter writer(directory);
+         writer.save(makeJob("job1"));
+      }
+
+      CHECK_FALSE(jobFile.exists());
+      REQUIRE_FALSE(tempFile.remove());
+   }
+
+   SECTION("Queued operations are written when the writer is destroyed")
+   {
+      {
+         LocalJobWriter writer(directory);
+         writer.save(makeJob("job1"));
+      }
+
+      CHECK(jobFile.exists());
+   }
+
+   REQUIRE_FALSE(directory.remove());
+}
+
+} // namespace local
+} // namespace launcher_plugins
+} // namespace rstudio
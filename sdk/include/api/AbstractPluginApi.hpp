@@ -62,6 +62,12 @@ public:
     */
    Error initialize();
 
+   /**
+    * @brief Blocks until any job changes which are being persisted in the background have been persisted. This should
+    *        be called after all requests have been handled, before the Plugin exits.
+    */
+   void flush();
+
 protected:
    /**
     * @brief Constructor.
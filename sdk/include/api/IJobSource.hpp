@@ -24,6 +24,7 @@
 #ifndef LAUNCHER_PLUGINS_I_JOB_SOURCE_HPP
 #define LAUNCHER_PLUGINS_I_JOB_SOURCE_HPP
 
+#include <functional>
 #include <set>
 
 #include <Error.hpp>
@@ -95,10 +96,39 @@ struct JobSourceConfiguration
    ResourceLimitList ResourceLimits;
 };
 
+/**
+ * @enum ControlJobResult
+ * @brief The result of an asynchronous control job operation.
+ */
+enum class ControlJobResult
+{
+   /** The operation completed successfully. */
+   COMPLETE,
+
+   /** The operation was attempted, but did not complete successfully. */
+   INCOMPLETE,
+
+   /** The operation is not supported by the Job Source. */
+   NOT_SUPPORTED,
+
+   /** The job was no longer in the required state when the operation was about to be performed. */
+   INVALID_STATE
+};
+
 /** @brief Generic interface for communicating with a Job Source. Implementation is plugin specific. */
 class IJobSource
 {
 public:
+   /**
+    * Definitions for callback functions which will be invoked when asynchronous operations complete. Each is invoked
+    * exactly once per operation, from any thread, and must not be invoked while the Job lock is held.
+    */
+   typedef std::function<void(ControlJobResult, const std::string&)> OnControlJobComplete;
+   typedef std::function<void(const Error&, OutputStreamPtr)> OnCreateOutputStreamComplete;
+   typedef std::function<void(const Error&, const JobSourceConfiguration&)> OnGetConfigurationComplete;
+   typedef std::function<void(const Error&, const NetworkInfo&)> OnGetNetworkInfoComplete;
+   typedef std::function<void(const Error&, bool)> OnSubmitJobComplete;
+
    /**
     * @brief Virtual Destructor.
     */
@@ -264,6 +294,107 @@ public:
       comms::AbstractLauncherCommunicatorPtr in_launcherCommunicator,
       AbstractResourceStreamPtr& out_resourceStream) = 0;
 
+   /**
+    * @brief Asynchronously cancels a pending job.
+    *
+    * The SDK invokes the asynchronous versions of the job source operations, so that a worker thread does not wait on
+    * the Job Scheduling System. By default, each one invokes its synchronous version and then the completion callback.
+    * Job Sources which communicate with the Job Scheduling System asynchronously should override them.
+    *
+    * This method will not be invoked unless the job was pending when it was checked. Unlike cancelJob, the Job lock
+    * will not be held when this method is invoked, so the job's state may have changed since. The default
+    * implementations check the state again with the Job lock held, and complete with ControlJobResult::INVALID_STATE
+    * without invoking the synchronous version if the job is no longer in the required state. Overrides should do the
+    * same.
+    *
+    * @param in_job             The job to be canceled.
+    * @param in_onComplete      Callback function which will be invoked with the result of the operation and its status
+    *                           message, as returned by cancelJob.
+    */
+   virtual void cancelJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete);
+
+   /**
+    * @brief Asynchronously creates an output stream for the specified job.
+    *
+    * The Job lock will not be held when this method is invoked. The default implementation holds it while it invokes
+    * createOutputStream.
+    *
+    * @param in_outputType      The type of job output to stream.
+    * @param in_job             The job for which output should be streamed.
+    * @param in_onOutput        Callback function which will be invoked when data is reported.
+    * @param in_onComplete      Callback function which will be invoked when the stream is complete.
+    * @param in_onError         Callback function which will be invoked if an error occurs.
+    * @param in_onCreated       Callback function which will be invoked with the newly created output stream, or the
+    *                           Error that occurred.
+    */
+   virtual void createOutputStreamAsync(
+      OutputType in_outputType,
+      JobPtr in_job,
+      AbstractOutputStream::OnOutput in_onOutput,
+      AbstractOutputStream::OnComplete in_onComplete,
+      AbstractOutputStream::OnError in_onError,
+      OnCreateOutputStreamComplete in_onCreated);
+
+   /**
+    * @brief Asynchronously gets the configuration and capabilities of this Job Source for the specified user.
+    *
+    * @param in_user            The user who made the request to see the configuration and capabilities of the Cluster.
+    * @param in_onComplete      Callback function which will be invoked with the configuration and capabilities of this
+    *                           Job Source, or the Error that occurred.
+    */
+   virtual void getConfigurationAsync(const system::User& in_user, OnGetConfigurationComplete in_onComplete) const;
+
+   /**
+    * @brief Asynchronously gets the network information for the specified job.
+    *
+    * @param in_job             The job for which to retrieve network information.
+    * @param in_onComplete      Callback function which will be invoked with the network information of the specified
+    *                           job, or the Error that occurred.
+    */
+   virtual void getNetworkInfoAsync(JobPtr in_job, OnGetNetworkInfoComplete in_onComplete) const;
+
+   /**
+    * @brief Asynchronously kills a running job. See cancelJobAsync for details.
+    *
+    * @param in_job             The job to be killed.
+    * @param in_onComplete      Callback function which will be invoked with the result of the operation.
+    */
+   virtual void killJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete);
+
+   /**
+    * @brief Asynchronously resumes a suspended job. See cancelJobAsync for details.
+    *
+    * @param in_job             The job to be resumed.
+    * @param in_onComplete      Callback function which will be invoked with the result of the operation.
+    */
+   virtual void resumeJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete);
+
+   /**
+    * @brief Asynchronously stops a running job. See cancelJobAsync for details.
+    *
+    * @param in_job             The job to be stopped.
+    * @param in_onComplete      Callback function which will be invoked with the result of the operation.
+    */
+   virtual void stopJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete);
+
+   /**
+    * @brief Asynchronously submits a job to the Job Scheduling System.
+    *
+    * @param io_job             The Job to be submitted. It should be updated as described for submitJob before
+    *                           in_onComplete is invoked.
+    * @param in_onComplete      Callback function which will be invoked with the Error that occurred, if any, and whether
+    *                           the requested Job was invalid.
+    */
+   virtual void submitJobAsync(JobPtr io_job, OnSubmitJobComplete in_onComplete) const;
+
+   /**
+    * @brief Asynchronously suspends a running job. See cancelJobAsync for details.
+    *
+    * @param in_job             The job to be suspended.
+    * @param in_onComplete      Callback function which will be invoked with the result of the operation.
+    */
+   virtual void suspendJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete);
+
 protected:
    /**
     * @brief Constructor.
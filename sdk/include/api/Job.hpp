@@ -35,6 +35,7 @@
 #include <json/Json.hpp>
 #include <system/DateTime.hpp>
 #include <system/User.hpp>
+#include <utils/InternedString.hpp>
 #include <utils/MutexUtils.hpp>
 
 namespace rstudio {
@@ -100,7 +101,7 @@ struct Container
    json::Object toJson() const;
 
    /** The name of the image to use. */
-   std::string Image;
+   utils::InternedString Image;
 
    /** The optional user ID to run the container as. */
    Optional<int> RunAsUserId;
@@ -206,6 +207,15 @@ struct Job
     */
    static Error fromJson(const json::Object& in_json, Job& out_job);
 
+   /**
+    * @brief Checks whether a field of the JSON representation of a job is included in job summaries.
+    *
+    * @param in_fieldName   The name of the JSON field.
+    *
+    * @return True if the field is included in job summaries; false otherwise.
+    */
+   static bool isSummaryField(const std::string& in_fieldName);
+
    /**
     * @brief Converts a status string into its equivalent Job::State enum value.
     *
@@ -252,6 +262,14 @@ struct Job
     */
    Optional<std::string> getJobConfigValue(const std::string& in_name) const;
 
+   /**
+    * @brief Creates a copy of this job which only has the fields that are needed to list the job and report its status
+    *        (see isSummaryField).
+    *
+    * @return The summary of this job.
+    */
+   JobPtr getSummary() const;
+
    /**
     * @brief Checks whether the job has completed (i.e. the job's state is a completed state).
     *
@@ -279,7 +297,7 @@ struct Job
    std::vector<std::string> Arguments;
 
    /** The name of the cluster which should run this job. */
-   std::string Cluster;
+   utils::InternedString Cluster;
 
    /**
     * @brief The shell command to run.
@@ -318,7 +336,7 @@ struct Job
    ExposedPortList ExposedPorts;
 
    /** The host on which the job was or is being run. */
-   std::string Host;
+   utils::InternedString Host;
 
    /** The unique ID of the job in the scheduling system. */
    std::string Id;
@@ -339,7 +357,7 @@ struct Job
    PlacementConstraintList PlacementConstraints;
 
    /** The set of queues on which this job may be run, or the queue which ran the job. */
-   std::set<std::string> Queues;
+   std::set<utils::InternedString> Queues;
 
    /** The resource limits that were set by the user for this job. */
    ResourceLimitList ResourceLimits;
@@ -363,7 +381,7 @@ struct Job
    system::DateTime SubmissionTime;
 
    /** The tags which were set on the job by the user. Can be used for filtering jobs based on tags. */
-   std::set<std::string> Tags;
+   std::set<utils::InternedString> Tags;
 
    /** The user who ran the job. */
    system::User User;
@@ -437,7 +455,7 @@ struct JobConfig
    json::Object toJson() const;
 
    /** The name of the custom job configuration value. */
-   std::string Name;
+   utils::InternedString Name;
 
    /** The type of the custom job configuration value. */
    Optional<Type> ValueType;
@@ -891,7 +909,7 @@ struct Mount
    json::Object toJson() const;
 
    /** The path to which to mount the source path. */
-   std::string Destination;
+   utils::InternedString Destination;
 
    /** Whether the mounted path is read only. */
    bool IsReadOnly;
@@ -68,6 +68,13 @@ public:
     */
    virtual json::Object toJson() const;
 
+   /**
+    * @brief Writes this response as a JSON string.
+    *
+    * @return The JSON string which represents this response.
+    */
+   virtual std::string write() const;
+
 protected:
    /**
     * @enum Response::Type
@@ -357,6 +364,15 @@ public:
     */
    json::Object toJson() const override;
 
+   /**
+    * @brief Writes this output stream response as a JSON string.
+    *
+    * The output is escaped directly into the JSON string, without first being copied into a JSON object.
+    *
+    * @return The JSON string which represents this output stream response.
+    */
+   std::string write() const override;
+
 private:
    // The private implementation of OutputStreamResponse
    PRIVATE_IMPL(m_impl);
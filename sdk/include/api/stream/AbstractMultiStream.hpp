@@ -32,6 +32,7 @@
 
 #include <Error.hpp>
 #include <PImpl.hpp>
+#include <api/ResponseTypes.hpp>
 #include <comms/AbstractLauncherCommunicator.hpp>
 
 namespace rstudio {
@@ -132,6 +133,17 @@ protected:
     */
    void sendResponse(const std::set<uint64_t>& in_requestIds, Args... in_responseArgs);
 
+   /**
+    * @brief Sends a response to the Launcher with sequence IDs which are tracked by the inheriting class, rather than
+    *        by this class.
+    *
+    * NOTE: The mutex must be held when this is called.
+    *
+    * @param in_sequences       The requests to which to send the response, with their sequence IDs.
+    * @param in_responseArgs    The details of the response, if any.
+    */
+   void sendSequencedResponse(const StreamSequences& in_sequences, Args... in_responseArgs);
+
    /** Mutex to protect shared state of the stream. */
    mutable std::mutex m_mutex;
 
@@ -34,6 +34,8 @@ namespace rstudio {
 namespace launcher_plugins {
 namespace system {
 
+class FilePath;
+class TimeDuration;
 class User;
 
 } // namespace system
@@ -71,6 +73,29 @@ public:
     */
    void addJob(const api::JobPtr& in_job);
 
+   /**
+    * @brief Moves the full details of completed jobs which have not changed for the specified idle time out of memory.
+    *
+    * The summary of each such job (see api::Job::getSummary) stays in memory, and its full details are loaded from
+    * the specified directory when they are needed. This is invoked by initialize when the job-tiering-idle-seconds
+    * option is set, with a directory under the scratch path which is unique to the host and process. Before that, any
+    * such directories of processes on this host which are no longer running are removed.
+    *
+    * @param in_directory   The directory in which to store the full details of the jobs. It should not be used by any
+    *                       other process.
+    * @param in_idleTime    How long a completed job must go unchanged before its full details are moved out of memory.
+    *
+    * @return Success if tiering could be enabled; Error otherwise.
+    */
+   Error enableTiering(const system::FilePath& in_directory, const system::TimeDuration& in_idleTime);
+
+   /**
+    * @brief Blocks until any job changes which are being persisted in the background have been persisted.
+    *
+    * This should be called before the Plugin exits.
+    */
+   void flush();
+
    /**
     * @brief Gets the specified job for the specified user from the repository.
     *
@@ -95,6 +120,30 @@ public:
     */
    api::JobList getJobs(const system::User& in_use = system::User()) const;
 
+   /**
+    * @brief Gets the specified jobs from the repository under a single acquisition of the repository lock.
+    *
+    * The full details of jobs which have been moved out of memory are loaded, but the jobs are not moved back into
+    * memory. Only getJob moves jobs back into memory.
+    *
+    * @param in_jobIds      The IDs of the jobs to retrieve.
+    *
+    * @return The jobs, in the same order as in_jobIds. Jobs which could not be found are empty pointers.
+    */
+   api::JobList getJobs(const std::vector<std::string>& in_jobIds) const;
+
+   /**
+    * @brief Gets all jobs belonging to the specified user, without loading the full details of jobs which have been
+    *        moved out of memory.
+    *
+    * Only the summary fields (see api::Job::isSummaryField) of the returned jobs are guaranteed to be set.
+    *
+    * @param in_user    The user for whom to retrieve all jobs. Default: All users.
+    *
+    * @return All of the jobs belonging to the specified user.
+    */
+   api::JobList getJobSummaries(const system::User& in_user = system::User()) const;
+
    /**
     * @brief Initializes the AbstractJobRepository.
     *
@@ -105,7 +154,8 @@ public:
    /**
     * @brief Removes a job from the repository.
     *
-    * If there is no job with the specified id, nothing will happen.
+    * If there is no job with the specified id, nothing will happen. The job is removed from the repository right
+    * away, but it is cleaned up (see onJobsRemoved) later, in the background.
     *
     * @param in_jobId   The ID of the job to remove.
     */
@@ -133,10 +183,23 @@ private:
    /**
     * @brief Allows inheriting classes to perform custom actions when a job is removed from the repository.
     *
+    * This is invoked by the default implementation of onJobsRemoved.
+    *
     * @param in_job     The job that was removed from the repository.
     */
    virtual void onJobRemoved(const api::JobPtr& in_job);
 
+   /**
+    * @brief Allows inheriting classes to clean up jobs which were removed from the repository, in batches.
+    *
+    * This is invoked in the background without the repository lock held, so it may be slow (e.g. to delete output
+    * files). Inheriting classes may override this to clean up many jobs at once. By default, onJobRemoved is invoked
+    * for each job.
+    *
+    * @param in_jobs    The jobs that were removed from the repository.
+    */
+   virtual void onJobsRemoved(const api::JobList& in_jobs);
+
    /**
     * @brief Allows inheriting classes to perform custom initialization actions when the repository is created.
     *
@@ -144,6 +207,11 @@ private:
     */
    virtual Error onInitialize();
 
+   /**
+    * @brief Allows inheriting classes which persist jobs in the background to finish persisting them.
+    */
+   virtual void onFlush();
+
    // The private implementation of AbstractJobRepository.
    PRIVATE_IMPL(m_impl);
 };
@@ -69,7 +69,9 @@ protected:
    /**
     * @brief Updates the job status for the specified job.
     *
-    * Attempts to look up the job in the repository. If the job cannot be found getJobDetails(...) will be invoked.
+    * Attempts to look up the job in the repository. If the job cannot be found getBatchJobDetails(...) will be invoked,
+    * unless the job's details are already being retrieved by another caller, in which case this waits for them, or were
+    * retrieved within the last few seconds, in which case they are reused.
     *
     * @param in_jobId               The ID of the job which should be updated.
     * @param in_newStatus           The new status of the job.
@@ -84,7 +86,49 @@ protected:
       const std::string& in_statusMessage = "",
       const system::DateTime& in_invocationTime = system::DateTime());
 
+   /**
+    * @brief Updates the job statuses for many jobs at once.
+    *
+    * All of the jobs are looked up in the repository together, and getBatchJobDetails(...) is invoked once for all of
+    * the jobs which cannot be found, as with updateJobStatus. Subscribers are notified of the changed jobs as a single
+    * batch.
+    *
+    * @param in_updates         The new statuses of the jobs.
+    *
+    * @return Success if all of the jobs could be found and updated; Error otherwise. The jobs which could be found are
+    *         updated even if an error is returned.
+    */
+   Error updateJobStatuses(const JobStatusUpdates& in_updates);
+
 private:
+   /**
+    * @brief Checks whether a status update would change the job. Updates which would not are not posted.
+    *
+    * By default, every update is treated as a change.
+    *
+    * @param in_jobId               The ID of the job which should be updated.
+    * @param in_newStatus           The new status of the job.
+    * @param in_statusMessage       The new status message of the job.
+    *
+    * @return True if the update should be posted; false otherwise.
+    */
+   virtual bool isStatusChanged(
+      const std::string& in_jobId,
+      api::Job::State in_newStatus,
+      const std::string& in_statusMessage);
+
+   /**
+    * @brief Invoked after a status update has been posted to the notifier.
+    *
+    * @param in_jobId               The ID of the job which was updated.
+    * @param in_newStatus           The new status of the job.
+    * @param in_statusMessage       The new status message of the job.
+    */
+   virtual void onStatusUpdated(
+      const std::string& in_jobId,
+      api::Job::State in_newStatus,
+      const std::string& in_statusMessage);
+
    /**
     * @brief Gets the job details for the specified job.
     *
@@ -95,6 +139,20 @@ private:
     */
    virtual Error getJobDetails(const std::string& in_jobId, api::JobPtr& out_job) const = 0;
 
+   /**
+    * @brief Gets the job details for each of the specified jobs.
+    *
+    * Override this to retrieve the details of many jobs with a single call to the Job Scheduling System. By default,
+    * getJobDetails(...) is invoked for each job. Callers which need the details of these jobs wait for this to return,
+    * so it must not post status updates for them.
+    *
+    * @param in_jobIds  The IDs of the jobs to retrieve.
+    * @param out_jobs   The populated Job objects, in any order. Jobs which could not be retrieved may be omitted.
+    *
+    * @return Success if the details of every job could be retrieved and parsed; Error otherwise.
+    */
+   virtual Error getBatchJobDetails(const std::vector<std::string>& in_jobIds, api::JobList& out_jobs) const;
+
    // The private implementation of AbstractJobStatusWatcher.
    PRIVATE_IMPL(m_baseImpl);
 };
@@ -36,6 +36,10 @@ namespace jobs {
 
 /**
  * @brief Responsible for polling job statuses on a timer.
+ *
+ * Job Sources which can list only the jobs that changed since a previous query should implement pollJobStatusChanges.
+ * Others should implement pollJobStatus and report the status of every job on each poll; updates which don't change a
+ * job's status or status message since the previous poll will not be posted.
  */
 class AbstractTimedJobStatusWatcher :
    public AbstractJobStatusWatcher,
@@ -70,7 +74,51 @@ protected:
       JobRepositoryPtr in_jobRepository,
       JobStatusNotifierPtr in_jobStatusNotifier);
 
+   /**
+    * @brief Constructor for a watcher which adapts its polling frequency.
+    *
+    * Job statuses are polled at the minimum frequency while polls find changes. Each poll which finds no changes doubles
+    * the time until the next poll, up to the maximum frequency. Each wait is randomly varied by up to 10% so that
+    * watchers don't poll the Job Scheduling System at the same time.
+    *
+    * @param in_minFrequency            The shortest time between polls.
+    * @param in_maxFrequency            The longest time between polls.
+    * @param in_jobRepository           The job repository, from which to look-up jobs.
+    * @param in_jobStatusNotifier       The job status notifier to which to post job updates.
+    */
+   AbstractTimedJobStatusWatcher(
+      system::TimeDuration in_minFrequency,
+      system::TimeDuration in_maxFrequency,
+      JobRepositoryPtr in_jobRepository,
+      JobStatusNotifierPtr in_jobStatusNotifier);
+
 private:
+   /**
+    * @brief Skips updates which don't change a job's status or status message since the previous full poll.
+    *
+    * @param in_jobId               The ID of the job which should be updated.
+    * @param in_newStatus           The new status of the job.
+    * @param in_statusMessage       The new status message of the job.
+    *
+    * @return True if the update should be posted; false otherwise.
+    */
+   bool isStatusChanged(
+      const std::string& in_jobId,
+      api::Job::State in_newStatus,
+      const std::string& in_statusMessage) final;
+
+   /**
+    * @brief Records a status update which was posted, so it won't be posted again.
+    *
+    * @param in_jobId               The ID of the job which was updated.
+    * @param in_newStatus           The new status of the job.
+    * @param in_statusMessage       The new status message of the job.
+    */
+   void onStatusUpdated(
+      const std::string& in_jobId,
+      api::Job::State in_newStatus,
+      const std::string& in_statusMessage) final;
+
    /**
     * @brief Polls job statuses.
     *
@@ -83,7 +131,23 @@ private:
     *
     * @return Success if the jobs could be polled; Error if an unrecoverable polling issue occurred.
     */
-   virtual Error pollJobStatus() = 0;
+   virtual Error pollJobStatus();
+
+   /**
+    * @brief Polls the statuses of jobs which changed since the previous poll.
+    *
+    * The cursor identifies the point up to which changes have been reported, in a form chosen by the implementation
+    * (e.g. a timestamp or a sequence number of the Job Scheduling System). If the cursor is empty, the status of every
+    * job should be reported. Setting out_nextCursor to an empty string makes the next poll report every job again.
+    *
+    * Errors are treated as described for pollJobStatus. By default, invokes pollJobStatus and returns no cursor.
+    *
+    * @param in_cursor          The cursor returned by the previous poll, or an empty string.
+    * @param out_nextCursor     The cursor to pass to the next poll.
+    *
+    * @return Success if the jobs could be polled; Error if an unrecoverable polling issue occurred.
+    */
+   virtual Error pollJobStatusChanges(const std::string& in_cursor, std::string& out_nextCursor);
 
    PRIVATE_IMPL(m_timedBaseImpl);
 };
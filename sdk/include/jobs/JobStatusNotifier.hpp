@@ -29,6 +29,7 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <PImpl.hpp>
 #include <api/Job.hpp>
@@ -47,6 +48,44 @@ typedef std::shared_ptr<Subscription> SubscriptionHandle;
 /** @brief Function which is invoked whe a subscribed job is updated. */
 typedef std::function<void(const api::JobPtr&)> OnJobStatusUpdate;
 
+/** @brief Function which is invoked with every job that changed in a batch of updates. */
+typedef std::function<void(const api::JobList&)> OnJobStatusBatchUpdate;
+
+/**
+ * @brief A new status for a job.
+ */
+struct JobStatusUpdate
+{
+   /**
+    * @brief Constructor.
+    *
+    * @param in_jobId               The ID of the job which should be updated.
+    * @param in_newStatus           The new status of the job.
+    * @param in_statusMessage       The new status message of the job, if any.
+    * @param in_invocationTime      The time at which the job was updated, if different from now.
+    */
+   JobStatusUpdate(
+      std::string in_jobId,
+      api::Job::State in_newStatus,
+      std::string in_statusMessage = "",
+      system::DateTime in_invocationTime = system::DateTime());
+
+   /** The ID of the job which should be updated. */
+   std::string JobId;
+
+   /** The new status of the job. */
+   api::Job::State Status;
+
+   /** The new status message of the job. */
+   std::string StatusMessage;
+
+   /** The time at which the job was updated. */
+   system::DateTime InvocationTime;
+};
+
+/** Convenience typedef */
+typedef std::vector<JobStatusUpdate> JobStatusUpdates;
+
 /**
  * @brief Class which notifies subscribers when a job updates.
  */
@@ -80,6 +119,17 @@ public:
     */
    SubscriptionHandle subscribe(const std::string& in_jobId, const OnJobStatusUpdate& in_onJobStatusUpdate);
 
+   /**
+    * @brief Subscribes to all jobs, receiving the jobs changed by a batch of updates together.
+    *
+    * Updates posted one at a time are delivered as a batch of one job.
+    *
+    * @param in_onJobStatusUpdates  The function to be invoked when any jobs are updated.
+    *
+    * @return A handle to the job subscription. To end the subscription, allow the handle to fall out of scope.
+    */
+   SubscriptionHandle subscribeBatch(const OnJobStatusBatchUpdate& in_onJobStatusUpdates);
+
    /**
     * @brief Updates the status of a job with a new status and optionally a new status message.
     *
@@ -97,6 +147,18 @@ public:
       const std::string& in_statusMessage = "",
       const system::DateTime& in_invocationTime = system::DateTime());
 
+   /**
+    * @brief Updates the statuses of many jobs at once.
+    *
+    * Each job is updated under its own lock, as with updateJob. Subscribers are notified once all of the jobs have been
+    * updated, and without the jobs' locks held: subscribers to all jobs are notified once per changed job, and batch
+    * subscribers are notified once with every changed job.
+    *
+    * @param in_jobs        The jobs to be updated.
+    * @param in_updates     The new status of each job, in the same order as in_jobs.
+    */
+   void updateJobs(const api::JobList& in_jobs, const JobStatusUpdates& in_updates);
+
 private:
    // The private implementation of JobStatusNotifier.
    PRIVATE_IMPL(m_impl);
@@ -0,0 +1,206 @@
+/*
+ * Metrics.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef LAUNCHER_PLUGINS_METRICS_HPP
+#define LAUNCHER_PLUGINS_METRICS_HPP
+
+#include <Noncopyable.hpp>
+
+#include <cstdint>
+#include <string>
+
+#include <PImpl.hpp>
+#include <api/Request.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+
+class Error;
+
+namespace system {
+
+class FilePath;
+class TimeDuration;
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace metrics {
+
+/**
+ * @enum RequestStage
+ * @brief The stages of handling a request from the Launcher, for which latency is measured.
+ */
+enum class RequestStage
+{
+   /** Parsing the received frame into a Request object. */
+   PARSE    = 0,
+
+   /** Waiting in the AsioService queue before the request is handled. */
+   QUEUE    = 1,
+
+   /** Running the request handler, including sending any immediate responses. */
+   HANDLE   = 2,
+
+   /** The whole time from receiving the frame until the request handler returns. */
+   TOTAL    = 3,
+};
+
+/**
+ * @brief A lock-free histogram of latency values, in microseconds.
+ *
+ * Values are counted in logarithmic buckets with eight linear sub-buckets per power of two, so any reported value is
+ * within 12.5% of the recorded value. Recording a value is a few relaxed atomic increments.
+ */
+class LatencyHistogram final : public Noncopyable
+{
+public:
+   /**
+    * @brief Constructor.
+    */
+   LatencyHistogram();
+
+   /**
+    * @brief Records a value.
+    *
+    * @param in_value       The value to record, in microseconds.
+    */
+   void record(uint64_t in_value);
+
+   /**
+    * @brief Gets the number of values that have been recorded.
+    *
+    * @return The number of values that have been recorded.
+    */
+   uint64_t getCount() const;
+
+   /**
+    * @brief Gets the sum of all the values that have been recorded.
+    *
+    * @return The sum of all the values that have been recorded, in microseconds.
+    */
+   uint64_t getSum() const;
+
+   /**
+    * @brief Gets the value at the specified quantile. The value is the highest value which is equivalent to the values
+    *        in its bucket.
+    *
+    * @param in_quantile    The quantile, between 0 and 1.
+    *
+    * @return The value at the specified quantile, in microseconds, or 0 if no values have been recorded.
+    */
+   uint64_t getValueAtQuantile(double in_quantile) const;
+
+private:
+   // The private implementation of LatencyHistogram.
+   PRIVATE_IMPL(m_impl);
+};
+
+/**
+ * @brief Checks whether metrics collection is enabled.
+ *
+ * @return True if metrics collection is enabled; false otherwise.
+ */
+bool isEnabled();
+
+/**
+ * @brief Enables metrics collection and, if a file is provided, periodically writes the metrics to the file in the
+ *        Prometheus text exposition format.
+ *
+ * The file is replaced atomically each time it is written, so it is suitable for use with the Prometheus node exporter
+ * textfile collector. This function should be called once, before the AsioService threads are started.
+ *
+ * @param in_metricsFile     The file to which metrics should be written. If empty, metrics will only be collected.
+ * @param in_interval        The amount of time between writes of the metrics file.
+ *
+ * @return Success if metrics collection could be started; Error otherwise.
+ */
+Error start(const system::FilePath& in_metricsFile, const system::TimeDuration& in_interval);
+
+/**
+ * @brief Stops writing the metrics file, after writing it a final time.
+ */
+void stop();
+
+/**
+ * @brief Gets the current metrics in the Prometheus text exposition format.
+ *
+ * @return The current metrics in the Prometheus text exposition format.
+ */
+std::string getPrometheusText();
+
+/**
+ * @brief Records the amount of time a request spent in the specified stage of handling.
+ *
+ * @param in_type            The type of the request.
+ * @param in_stage           The stage of handling.
+ * @param in_microseconds    The amount of time spent in the stage, in microseconds.
+ */
+void recordRequestStage(api::Request::Type in_type, RequestStage in_stage, uint64_t in_microseconds);
+
+/**
+ * @brief Records bytes received from the Launcher.
+ *
+ * @param in_bytes       The number of bytes received.
+ */
+void recordBytesReceived(size_t in_bytes);
+
+/**
+ * @brief Records complete frames received from the Launcher.
+ *
+ * @param in_frames      The number of frames received.
+ */
+void recordFramesReceived(size_t in_frames);
+
+/**
+ * @brief Records a frame sent to the Launcher.
+ *
+ * @param in_bytes       The size of the frame, in bytes.
+ */
+void recordFrameSent(size_t in_bytes);
+
+/**
+ * @brief Adjusts the number of blocks of data waiting to be written to AsioStreams.
+ *
+ * @param in_delta       The change in the number of blocks of data waiting to be written.
+ */
+void adjustStreamWriteQueueDepth(int64_t in_delta);
+
+/**
+ * @brief Sets the sizes of the hot (in memory) and cold (on disk) tiers of the job repository.
+ *
+ * @param in_hotJobs     The number of jobs whose full details are in memory.
+ * @param in_coldJobs    The number of jobs whose full details are on disk.
+ * @param in_coldBytes   The size of the full details of the jobs which are on disk, in bytes.
+ */
+void setJobTierSizes(size_t in_hotJobs, size_t in_coldJobs, uint64_t in_coldBytes);
+
+} // namespace metrics
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
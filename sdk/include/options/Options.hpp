@@ -202,6 +202,15 @@ public:
     */
    system::TimeDuration getJobExpiryHours() const;
 
+   /**
+    * @brief Gets how long completed jobs must go unchanged before their full details are moved out of memory, to the
+    *        cold tier on disk.
+    *
+    * @return How long completed jobs must go unchanged before their details are moved to disk, or 0 if jobs should
+    *         always be kept in memory.
+    */
+   system::TimeDuration getJobTieringIdleSeconds() const;
+
    /**
     * @brief Gets the number of seconds between heartbeats.
     *
@@ -236,6 +245,20 @@ public:
     */
    size_t getMaxMessageSize() const;
 
+   /**
+    * @brief Gets the file to which metrics should be written in the Prometheus text exposition format.
+    *
+    * @return The file to which metrics should be written, or an empty path if metrics are disabled.
+    */
+   const system::FilePath& getMetricsFile() const;
+
+   /**
+    * @brief Gets the number of seconds between writes of the metrics file.
+    *
+    * @return The number of seconds between writes of the metrics file.
+    */
+   system::TimeDuration getMetricsIntervalSeconds() const;
+
    /**
     * @brief Gets the name the administrator gave to this instance of the Plugin in the launcher.conf file.
     *
@@ -281,6 +304,20 @@ public:
     */
    Error getServerUser(system::User& out_serverUser) const;
 
+   /**
+    * @brief Gets how long users which could not be found should be cached.
+    *
+    * @return How long users which could not be found should be cached.
+    */
+   system::TimeDuration getUserCacheNegativeTtlSeconds() const;
+
+   /**
+    * @brief Gets how long users which were found should be cached.
+    *
+    * @return How long users which were found should be cached.
+    */
+   system::TimeDuration getUserCacheTtlSeconds() const;
+
    /**
     * @brief Gets the size of the thread pool.
     *
@@ -288,6 +325,29 @@ public:
     */
    size_t getThreadPoolSize() const;
 
+   /**
+    * @brief Gets whether each thread in the thread pool should be pinned to a CPU core.
+    *
+    * @return True if each thread in the thread pool should be pinned to a CPU core; false otherwise.
+    */
+   bool pinThreadPoolThreads() const;
+
+   /**
+    * @brief Gets whether each thread in the thread pool should have its own work queue, stealing work from other
+    *        threads when it is idle.
+    *
+    * @return True if each thread in the thread pool should have its own work queue; false if the threads should share a
+    *         single work queue.
+    */
+   bool useWorkStealingThreadPool() const;
+
+   /**
+    * @brief Gets the amount of time by which timed events which are due soon may be delayed, so they can be grouped.
+    *
+    * @return The amount of time by which timed events which are due soon may be delayed.
+    */
+   system::TimeDuration getTimerSlackMilliseconds() const;
+
    /**
     * @brief Gets whether the plugin should run in single-user unprivileged mode.
     *
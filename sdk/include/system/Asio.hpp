@@ -26,6 +26,7 @@
 
 #include <Noncopyable.hpp>
 
+#include <cstdint>
 #include <functional>
 
 #include <PImpl.hpp>
@@ -54,6 +55,70 @@ typedef std::function<void(const char*, size_t)> OnReadBytes;
  */
 typedef std::function<void(int)> OnSignal;
 
+/**
+ * @enum AsioPriority
+ * @brief The priority lane to which work posted to the AsioService should be added.
+ *
+ * Work in a higher priority lane is run before work in a lower priority lane. To ensure lower priority work is not
+ * starved, each lane may only run a bounded number of consecutive items while lower priority work is waiting.
+ */
+enum class AsioPriority
+{
+   /** Latency sensitive work, such as heartbeats and job control requests. */
+   HIGH     = 0,
+
+   /** Regular work. This is the default priority. */
+   NORMAL   = 1,
+
+   /** Bulk work, such as wildcard job scans, which should yield to other work. */
+   LOW      = 2,
+};
+
+/**
+ * @enum AsioExecutionMode
+ * @brief The way in which the worker threads of the AsioService run work.
+ */
+enum class AsioExecutionMode
+{
+   /** All worker threads run work from a single shared queue. This is the default mode. */
+   SHARED      = 0,
+
+   /**
+    * Each worker thread runs its own queue. Work posted from a worker thread is queued on that worker, and streams
+    * created on a worker thread are serviced by that worker. Idle workers steal queued work from busy workers.
+    */
+   PER_WORKER  = 1,
+};
+
+/**
+ * @brief Statistics about the work which has been posted to a single priority lane of the AsioService.
+ */
+struct AsioQueueStats
+{
+   /**
+    * @brief Constructor.
+    */
+   AsioQueueStats() :
+      QueuedCount(0),
+      CompletedCount(0),
+      TotalWaitMicroseconds(0),
+      MaxWaitMicroseconds(0)
+   {
+   }
+
+   /** The number of work items which are currently waiting to be run. */
+   size_t QueuedCount;
+
+   /** The number of work items which have been started. */
+   uint64_t CompletedCount;
+
+   /** The total amount of time, in microseconds, that started work items spent waiting in the queue. */
+   uint64_t TotalWaitMicroseconds;
+
+   /** The longest amount of time, in microseconds, that a started work item spent waiting in the queue. */
+   uint64_t MaxWaitMicroseconds;
+};
+
 /**
  * @brief Async input/output class which may be used to manage ASIO operations.
  */
@@ -68,6 +133,23 @@ public:
     */
    static void post(const AsioFunction& in_work);
 
+   /**
+    * @brief Posts a job to be completed by this ASIO Service in the specified priority lane.
+    *
+    * @param in_work        The job to be posted to the ASIO Service.
+    * @param in_priority    The priority lane to which the job should be added.
+    */
+   static void post(const AsioFunction& in_work, AsioPriority in_priority);
+
+   /**
+    * @brief Gets the queue statistics of the specified priority lane.
+    *
+    * @param in_priority    The priority lane for which to get statistics.
+    *
+    * @return The queue statistics of the specified priority lane.
+    */
+   static AsioQueueStats getQueueStats(AsioPriority in_priority);
+
    /**
     * @brief Sets the signal handler on the ASIO service.
     *
@@ -78,6 +160,14 @@ public:
     */
    static void setSignalHandler(const OnSignal& in_onSignal);
 
+   /**
+    * @brief Sets the amount of time by which timed events which are due soon may be delayed, so that events which are
+    *        due close together are run together. Events which are due further in the future may be delayed by more.
+    *
+    * @param in_slack   The amount of time by which timed events which are due soon may be delayed.
+    */
+   static void setTimerSlack(const TimeDuration& in_slack);
+
    /**
     * @brief Creates and adds the specified number of worker threads to the ASIO service.
     *
@@ -85,6 +175,19 @@ public:
     */
    static void startThreads(size_t in_numThreads);
 
+   /**
+    * @brief Creates and adds the specified number of worker threads to the ASIO service, using the specified execution
+    *        mode.
+    *
+    * The PER_WORKER execution mode may only be used the first time threads are started. Otherwise, the threads will be
+    * added in SHARED mode.
+    *
+    * @param in_numThreads  The number of worker threads to add to the ASIO service.
+    * @param in_mode        The execution mode of the worker threads.
+    * @param in_pinThreads  Whether each worker thread should be pinned to a CPU core.
+    */
+   static void startThreads(size_t in_numThreads, AsioExecutionMode in_mode, bool in_pinThreads);
+
    /**
     * @brief Stops the ASIO Service.
     *
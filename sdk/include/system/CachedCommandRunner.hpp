@@ -0,0 +1,389 @@
+/*
+ * CachedCommandRunner.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_CACHED_COMMAND_RUNNER_HPP
+#define LAUNCHER_PLUGINS_CACHED_COMMAND_RUNNER_HPP
+
+#include <Noncopyable.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Error.hpp>
+#include <system/Process.hpp>
+#include <utils/MutexUtils.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+/**
+ * @brief Runs commands, such as Job Scheduling System CLI queries, asynchronously and caches their parsed output.
+ *
+ * Standard output is parsed line by line as the command writes it, so the raw output is never held in memory. Identical
+ * commands which are run while one is already running share its result rather than starting another child process.
+ * Results of commands which exit with code 0 are cached for the TTL. At most the configured number of commands run at
+ * once; the rest are queued and started in order.
+ *
+ * Instances must be owned by a std::shared_ptr.
+ *
+ * @tparam T    The type into which the output of the commands is parsed.
+ */
+template <typename T>
+class CachedCommandRunner : public Noncopyable, public std::enable_shared_from_this<CachedCommandRunner<T> >
+{
+public:
+   /** The clock used for expiry. */
+   typedef std::chrono::steady_clock Clock;
+
+   /** Callback invoked with the result of a command, or the Error that occurred. The result must not be modified. */
+   typedef std::function<void(const Error&, const std::shared_ptr<const T>&)> OnComplete;
+
+   /** Function which parses one line of standard output, without its line ending, into the result. */
+   typedef std::function<void(const std::string&, T&)> ParseLine;
+
+   /**
+    * @brief Constructor.
+    *
+    * @param in_parseLine           The function which parses each line of standard output into the result.
+    * @param in_ttl                 How long the results of successful commands are cached.
+    * @param in_maxConcurrent       The maximum number of commands which may run at once. Must be at least 1.
+    */
+   CachedCommandRunner(ParseLine in_parseLine, Clock::duration in_ttl, size_t in_maxConcurrent) :
+      m_generation(0),
+      m_maxConcurrent(std::max<size_t>(in_maxConcurrent, 1)),
+      m_parseLine(std::move(in_parseLine)),
+      m_running(0),
+      m_ttl(in_ttl)
+   {
+   }
+
+   /**
+    * @brief Removes all results from the cache. Commands which are already running will not be cached.
+    */
+   void invalidate()
+   {
+      LOCK_MUTEX(m_mutex)
+      {
+         m_entries.clear();
+         ++m_generation;
+      }
+      END_LOCK_MUTEX
+   }
+
+   /**
+    * @brief Runs a command, or uses its cached result.
+    *
+    * The command is identified by its executable, arguments, environment, standard input, working directory and user.
+    * A command which exits with a non-zero code completes with an Error which includes its standard error output.
+    *
+    * @param in_options         The options of the command to run.
+    * @param in_onComplete      Callback which will be invoked when the result of the command is available. It may be
+    *                           invoked before this method returns.
+    */
+   void run(const process::ProcessOptions& in_options, const OnComplete& in_onComplete)
+   {
+      const std::string key = getKey(in_options);
+      std::shared_ptr<const T> cachedResult;
+      std::shared_ptr<Command> command;
+
+      LOCK_MUTEX(m_mutex)
+      {
+         auto itr = m_entries.find(key);
+         if ((itr != m_entries.end()) && (itr->second.ExpiryTime > Clock::now()))
+            cachedResult = itr->second.Result;
+         else
+         {
+            // Join the running command, if there is one.
+            auto runningItr = m_commands.find(key);
+            if (runningItr != m_commands.end())
+            {
+               runningItr->second->Waiters.push_back(in_onComplete);
+               return;
+            }
+
+            command.reset(new Command(key, in_options, m_generation));
+            command->Waiters.push_back(in_onComplete);
+            m_commands[key] = command;
+
+            if (m_running >= m_maxConcurrent)
+            {
+               m_queue.push_back(command);
+               return;
+            }
+
+            ++m_running;
+         }
+      }
+      END_LOCK_MUTEX
+
+      if (cachedResult)
+         in_onComplete(Success(), cachedResult);
+      else if (command)
+         start(command);
+   }
+
+private:
+   /**
+    * @brief A command which is queued or running, and the callbacks waiting for its result.
+    */
+   struct Command
+   {
+      Command(std::string in_key, process::ProcessOptions in_options, uint64_t in_generation) :
+         Generation(in_generation),
+         Key(std::move(in_key)),
+         Options(std::move(in_options)),
+         Result(new T())
+      {
+      }
+
+      uint64_t Generation;
+      std::string Key;
+      process::ProcessOptions Options;
+      std::string PartialLine;
+      Error ProcessError;
+      std::shared_ptr<T> Result;
+      std::string StdError;
+      std::vector<OnComplete> Waiters;
+   };
+
+   /**
+    * @brief A cached result.
+    */
+   struct Entry
+   {
+      Clock::time_point ExpiryTime;
+      std::shared_ptr<const T> Result;
+   };
+
+   /**
+    * @brief Gets the key which identifies a command.
+    *
+    * @param in_options     The options of the command.
+    *
+    * @return The key which identifies the command.
+    */
+   static std::string getKey(const process::ProcessOptions& in_options)
+   {
+      // Separate each value with a NUL, which can't appear in any of them.
+      std::string key = in_options.Executable;
+      key.append(1, '\0').append(in_options.IsShellCommand ? "1" : "0");
+      for (const std::string& arg: in_options.Arguments)
+         key.append(1, '\0').append(arg);
+      key.append(1, '\0');
+      for (const auto& envVar: in_options.Environment)
+         key.append(1, '\0').append(envVar.first).append("=").append(envVar.second);
+      key.append(1, '\0').append(in_options.StandardInput);
+      key.append(1, '\0').append(in_options.WorkingDirectory.getAbsolutePath());
+      key.append(1, '\0').append(in_options.RunAsUser.getUsername());
+      return key;
+   }
+
+   /**
+    * @brief Completes a command, caching its result if it succeeded, and starts the next queued command. This must be
+    *        invoked exactly once per command, once its process has exited or failed to start.
+    *
+    * @param in_command     The command which completed.
+    * @param in_error       The error which occurred, if any.
+    */
+   void finish(const std::shared_ptr<Command>& in_command, const Error& in_error)
+   {
+      std::vector<OnComplete> waiters;
+      std::shared_ptr<Command> next;
+
+      LOCK_MUTEX(m_mutex)
+      {
+         waiters.swap(in_command->Waiters);
+         m_commands.erase(in_command->Key);
+
+         if (!in_error && (in_command->Generation == m_generation) && (m_ttl > Clock::duration::zero()))
+         {
+            // Drop expired results while we're here, so commands which are no longer run don't stay cached.
+            const Clock::time_point now = Clock::now();
+            for (auto itr = m_entries.begin(); itr != m_entries.end();)
+            {
+               if (itr->second.ExpiryTime <= now)
+                  itr = m_entries.erase(itr);
+               else
+                  ++itr;
+            }
+
+            Entry& entry = m_entries[in_command->Key];
+            entry.ExpiryTime = now + m_ttl;
+            entry.Result = in_command->Result;
+         }
+
+         if (m_queue.empty())
+            --m_running;
+         else
+         {
+            next = m_queue.front();
+            m_queue.pop_front();
+         }
+      }
+      END_LOCK_MUTEX
+
+      std::shared_ptr<const T> result;
+      if (!in_error)
+         result = in_command->Result;
+
+      for (const OnComplete& onComplete: waiters)
+         onComplete(in_error, result);
+
+      if (next)
+         start(next);
+   }
+
+   /**
+    * @brief Parses standard output which was written by a command.
+    *
+    * The output callbacks of a single child process are never invoked concurrently.
+    *
+    * @param in_command     The command which wrote the output.
+    * @param in_output      The output which was written.
+    * @param in_isEof       Whether the command has exited, so any partial line is complete.
+    */
+   void parseOutput(Command& in_command, const std::string& in_output, bool in_isEof)
+   {
+      size_t start = 0;
+      size_t end = in_output.find('\n');
+      while (end != std::string::npos)
+      {
+         if (in_command.PartialLine.empty())
+            m_parseLine(in_output.substr(start, end - start), *in_command.Result);
+         else
+         {
+            in_command.PartialLine.append(in_output, start, end - start);
+            m_parseLine(in_command.PartialLine, *in_command.Result);
+            in_command.PartialLine.clear();
+         }
+
+         start = end + 1;
+         end = in_output.find('\n', start);
+      }
+
+      in_command.PartialLine.append(in_output, start, std::string::npos);
+      if (in_isEof && !in_command.PartialLine.empty())
+      {
+         m_parseLine(in_command.PartialLine, *in_command.Result);
+         in_command.PartialLine.clear();
+      }
+   }
+
+   /**
+    * @brief Starts a command.
+    *
+    * @param in_command     The command to start.
+    */
+   void start(const std::shared_ptr<Command>& in_command)
+   {
+      // The callbacks keep this object alive until the command completes, so its waiters are always invoked.
+      std::shared_ptr<CachedCommandRunner> sharedThis = this->shared_from_this();
+
+      process::AsyncProcessCallbacks callbacks;
+      callbacks.OnStandardOutput = [sharedThis, in_command](const std::string& in_output)
+      {
+         sharedThis->parseOutput(*in_command, in_output, false);
+      };
+      callbacks.OnStandardError = [in_command](const std::string& in_output)
+      {
+         in_command->StdError.append(in_output);
+      };
+      callbacks.OnError = [sharedThis, in_command](const Error& in_error)
+      {
+         // The process is terminated after an error and will still exit, so only record the error here. Finishing now
+         // would start the next queued command while this one is still running.
+         LOCK_MUTEX(sharedThis->m_mutex)
+         {
+            if (!in_command->ProcessError)
+               in_command->ProcessError = in_error;
+         }
+         END_LOCK_MUTEX
+      };
+      callbacks.OnExit = [sharedThis, in_command](int in_exitCode)
+      {
+         sharedThis->parseOutput(*in_command, "", true);
+
+         Error error;
+         LOCK_MUTEX(sharedThis->m_mutex)
+         {
+            error = in_command->ProcessError;
+         }
+         END_LOCK_MUTEX
+
+         if (!error && (in_exitCode != 0))
+         {
+            error = unknownError(
+               "Command " + in_command->Options.Executable + " exited with code " + std::to_string(in_exitCode) +
+               (in_command->StdError.empty() ? "." : ": " + in_command->StdError),
+               ERROR_LOCATION);
+         }
+
+         sharedThis->finish(in_command, error);
+      };
+
+      Error error = process::ProcessSupervisor::runAsyncProcess(in_command->Options, callbacks);
+      if (error)
+         finish(in_command, error);
+   }
+
+   /** The results of commands which are cached. */
+   std::map<std::string, Entry> m_entries;
+
+   /** Incremented when the cache is invalidated, so commands started before then aren't cached. */
+   uint64_t m_generation;
+
+   /** The maximum number of commands which may run at once. */
+   const size_t m_maxConcurrent;
+
+   /** The commands which are queued or running. */
+   std::map<std::string, std::shared_ptr<Command> > m_commands;
+
+   /** The mutex which protects this object. */
+   std::mutex m_mutex;
+
+   /** The function which parses each line of standard output. */
+   ParseLine m_parseLine;
+
+   /** The commands which are waiting for a running command to complete. */
+   std::deque<std::shared_ptr<Command> > m_queue;
+
+   /** The number of commands which are running. */
+   size_t m_running;
+
+   /** How long the results of successful commands are cached. */
+   Clock::duration m_ttl;
+};
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
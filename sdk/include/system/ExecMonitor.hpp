@@ -0,0 +1,95 @@
+/*
+ * ExecMonitor.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_EXEC_MONITOR_HPP
+#define LAUNCHER_PLUGINS_EXEC_MONITOR_HPP
+
+#include <functional>
+#include <sys/types.h>
+
+namespace rstudio {
+namespace launcher_plugins {
+
+class Error;
+
+} // namespace launcher_plugins
+} // namespace rstudio
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+namespace process {
+
+/**
+ * @brief Reports when watched processes call exec, using the kernel's process events connector.
+ *
+ * Process events require root or CAP_NET_ADMIN to subscribe to. If the process has dropped root privileges but may
+ * regain them, only the monitor's own thread regains root, and only while subscribing.
+ *
+ * The kernel may drop events if they can't be read quickly enough. When that happens every watched process is
+ * reported, since any of them may have called exec. Callers should therefore confirm the state of the process when
+ * they are notified.
+ */
+class ExecMonitor
+{
+public:
+   /**
+    * @brief Starts monitoring process events. Does nothing if the monitor is already running.
+    *
+    * @return Success if process events could be subscribed to; Error otherwise.
+    */
+   static Error start();
+
+   /**
+    * @brief Checks whether the monitor is running.
+    *
+    * @return True if the monitor is running; false otherwise.
+    */
+   static bool isRunning();
+
+   /**
+    * @brief Watches the specified process for calls to exec until it exits or ExecMonitor::unwatch is invoked.
+    *
+    * The callback is posted to the AsioService each time the process calls exec.
+    *
+    * @param in_pid         The PID of the process to watch.
+    * @param in_onExec      The function to invoke when the process calls exec.
+    *
+    * @return True if the process is being watched; false if the monitor is not running.
+    */
+   static bool watch(pid_t in_pid, const std::function<void()>& in_onExec);
+
+   /**
+    * @brief Stops watching the specified process.
+    *
+    * @param in_pid         The PID of the process to stop watching.
+    */
+   static void unwatch(pid_t in_pid);
+};
+
+} // namespace process
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
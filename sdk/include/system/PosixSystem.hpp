@@ -25,6 +25,9 @@
 #define LAUNCHER_PLUGINS_POSIX_SYSTEM_HPP
 
 #include <functional>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <Optional.hpp>
 #include <Error.hpp>
@@ -61,6 +64,9 @@ struct IpAddress
    std::string Address;
 };
 
+/** Convenience typedef. */
+typedef std::shared_ptr<const std::vector<std::string> > IpAddressListPtr;
+
 /**
  * @brief Enables core dumps for this process.
  *
@@ -87,6 +93,19 @@ std::string getEnvironmentVariable(const std::string& in_name);
  */
 launcher_plugins::Error getIpAddresses(std::vector<IpAddress>& out_addresses, bool in_includeIPv6 = false);
 
+/**
+ * @brief Gets the IPv4 and IPv6 addresses of the machine running this process, except loop-back and link local
+ *        addresses.
+ *
+ * The addresses are cached. The cache is refreshed when the kernel reports that an address was added or removed, or
+ * every 30 seconds if address change notifications are not available.
+ *
+ * @param out_addresses         The IP addresses of the machine running this process. Must not be modified.
+ *
+ * @return Success if the IP addresses could be retrieved; Error otherwise.
+ */
+Error getReachableIpAddresses(IpAddressListPtr& out_addresses);
+
 /**
  * @brief Ignores a particular signal for this process.
  *
@@ -96,6 +115,17 @@ launcher_plugins::Error getIpAddresses(std::vector<IpAddress>& out_addresses, bo
  */
 Error ignoreSignal(int in_signal);
 
+/**
+ * @brief Pins the calling thread to the specified CPU core.
+ *
+ * If the specified core is greater than or equal to the number of cores on the system, it will wrap around.
+ *
+ * @param in_core       The index of the core to which the calling thread should be pinned.
+ *
+ * @return Success if the calling thread could be pinned to the core; Error otherwise.
+ */
+Error pinCurrentThreadToCore(unsigned int in_core);
+
 /**
  * @brief Makes a posix call and handles EINTR retries.
  *
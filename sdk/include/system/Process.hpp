@@ -165,6 +165,16 @@ struct ProcessOptions
     */
    bool CloseStdIn;
 
+   /**
+    * @brief The cgroup v2 directory into which the process should be moved before it executes, if any.
+    *
+    * The directory must already exist and its cgroup.procs file must be writable by the user this process is running
+    * as (e.g. because the directory is part of a subtree delegated to that user). If cgroup.procs is not writable, an
+    * error will be logged and the process will be launched without being moved into the cgroup. If moving the process
+    * fails anyway, it will exit without running.
+    */
+   FilePath ControlGroup;
+
    /**
     * @brief The environment variables which should available to the process. If PATH is not set, it will be added to
     *        the environment with the same value as the PATH of this process.
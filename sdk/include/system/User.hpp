@@ -37,6 +37,7 @@ class Error;
 namespace system {
 
 class FilePath;
+class TimeDuration;
 
 } // namespace system
 } // namespace launcher_plugins
@@ -77,7 +78,7 @@ public:
     explicit User(bool in_isEmpty = false);
 
    /**
-    * @brief Copy constructor.
+    * @brief Copy constructor. The user details are immutable, so they are shared rather than copied.
     *
     * @param in_other   The user to copy.
     */
@@ -120,6 +121,23 @@ public:
     */
    static Error getUserFromIdentifier(UidType in_userId, User& out_user);
 
+   /**
+    * @brief Removes all users from the user cache, so the next lookup of each user queries the system again.
+    *
+    * This should be invoked if the system's users are known to have changed.
+    */
+   static void invalidateCache();
+
+   /**
+    * @brief Sets how long user lookups are cached.
+    *
+    * A duration of 0 disables that type of caching.
+    *
+    * @param in_ttl             How long to cache users which were found.
+    * @param in_negativeTtl     How long to cache users which could not be found.
+    */
+   static void setCacheTimeouts(const TimeDuration& in_ttl, const TimeDuration& in_negativeTtl);
+
    /**
     * @brief Overloaded assignment operator.
     *
@@ -225,7 +243,7 @@ public:
 
 private:
    // The private implementation of User.
-   PRIVATE_IMPL(m_impl);
+   PRIVATE_IMPL_SHARED(m_impl);
 };
 
 } // namesapce system
@@ -0,0 +1,226 @@
+/*
+ * InternedString.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_INTERNED_STRING_HPP
+#define LAUNCHER_PLUGINS_INTERNED_STRING_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace utils {
+
+/**
+ * @brief An immutable string which shares its value with every other InternedString of the same value.
+ *
+ * Values are kept in a process wide table for as long as any InternedString refers to them, so storing a value which
+ * repeats across many objects (e.g. a host name or a queue name) only stores it once. Two InternedStrings are equal
+ * if and only if they refer to the same table entry, so equality checks are pointer comparisons.
+ *
+ * Constructing an InternedString from a std::string requires a table look up, so values which are compared often
+ * should be interned once and reused.
+ */
+class InternedString final
+{
+public:
+   /**
+    * @brief Constructs an empty InternedString.
+    */
+   InternedString() = default;
+
+   /**
+    * @brief Constructs an InternedString with the specified value.
+    *
+    * @param in_value   The value of the InternedString.
+    */
+   InternedString(const std::string& in_value);
+
+   /**
+    * @brief Constructs an InternedString with the specified value.
+    *
+    * @param in_value   The value of the InternedString.
+    */
+   InternedString(const char* in_value);
+
+   /**
+    * @brief Gets the number of distinct values which are currently interned.
+    *
+    * @return The number of distinct values which are currently interned.
+    */
+   static size_t getInternedCount();
+
+   /**
+    * @brief Conversion operator to the value of this InternedString.
+    *
+    * @return The value of this InternedString.
+    */
+   operator const std::string&() const;
+
+   /**
+    * @brief Equality operator. This is a pointer comparison.
+    *
+    * @param in_other   The InternedString to compare with this one.
+    *
+    * @return True if the values are the same; false otherwise.
+    */
+   bool operator==(const InternedString& in_other) const;
+
+   /**
+    * @brief Inequality operator. This is a pointer comparison.
+    *
+    * @param in_other   The InternedString to compare with this one.
+    *
+    * @return True if the values are different; false otherwise.
+    */
+   bool operator!=(const InternedString& in_other) const;
+
+   /**
+    * @brief Less than operator. Values are ordered in the same way as std::string values.
+    *
+    * @param in_other   The InternedString to compare with this one.
+    *
+    * @return True if the value of this InternedString is lexicographically before the other; false otherwise.
+    */
+   bool operator<(const InternedString& in_other) const;
+
+   /**
+    * @brief Gets the value of this InternedString as a C string.
+    *
+    * @return The value of this InternedString as a C string.
+    */
+   const char* c_str() const;
+
+   /**
+    * @brief Checks whether this InternedString is empty.
+    *
+    * @return True if the value of this InternedString is the empty string; false otherwise.
+    */
+   bool empty() const;
+
+   /**
+    * @brief Gets the length of the value of this InternedString.
+    *
+    * @return The length of the value of this InternedString.
+    */
+   size_t size() const;
+
+   /**
+    * @brief Gets the value of this InternedString.
+    *
+    * @return The value of this InternedString.
+    */
+   const std::string& str() const;
+
+private:
+   // The shared value. Empty values are not interned.
+   std::shared_ptr<const std::string> m_value;
+};
+
+/**
+ * @brief Equality operator for an InternedString and a string.
+ *
+ * @param in_lhs     The InternedString to compare.
+ * @param in_rhs     The string to compare.
+ *
+ * @return True if the values are the same; false otherwise.
+ */
+bool operator==(const InternedString& in_lhs, const std::string& in_rhs);
+
+/**
+ * @brief Equality operator for a string and an InternedString.
+ *
+ * @param in_lhs     The string to compare.
+ * @param in_rhs     The InternedString to compare.
+ *
+ * @return True if the values are the same; false otherwise.
+ */
+bool operator==(const std::string& in_lhs, const InternedString& in_rhs);
+
+/**
+ * @brief Equality operator for an InternedString and a C string.
+ *
+ * @param in_lhs     The InternedString to compare.
+ * @param in_rhs     The C string to compare.
+ *
+ * @return True if the values are the same; false otherwise.
+ */
+bool operator==(const InternedString& in_lhs, const char* in_rhs);
+
+/**
+ * @brief Inequality operator for an InternedString and a string.
+ *
+ * @param in_lhs     The InternedString to compare.
+ * @param in_rhs     The string to compare.
+ *
+ * @return True if the values are different; false otherwise.
+ */
+bool operator!=(const InternedString& in_lhs, const std::string& in_rhs);
+
+/**
+ * @brief Inequality operator for a string and an InternedString.
+ *
+ * @param in_lhs     The string to compare.
+ * @param in_rhs     The InternedString to compare.
+ *
+ * @return True if the values are different; false otherwise.
+ */
+bool operator!=(const std::string& in_lhs, const InternedString& in_rhs);
+
+/**
+ * @brief Inequality operator for an InternedString and a C string.
+ *
+ * @param in_lhs     The InternedString to compare.
+ * @param in_rhs     The C string to compare.
+ *
+ * @return True if the values are different; false otherwise.
+ */
+bool operator!=(const InternedString& in_lhs, const char* in_rhs);
+
+/**
+ * @brief Concatenates a string and an InternedString.
+ *
+ * @param in_lhs     The string.
+ * @param in_rhs     The InternedString.
+ *
+ * @return The concatenated string.
+ */
+std::string operator+(const std::string& in_lhs, const InternedString& in_rhs);
+
+/**
+ * @brief Writes the value of an InternedString to an output stream.
+ *
+ * @param io_ostream     The output stream to which to write.
+ * @param in_string      The InternedString to write.
+ *
+ * @return A reference to the output stream.
+ */
+std::ostream& operator<<(std::ostream& io_ostream, const InternedString& in_string);
+
+} // namespace utils
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
@@ -31,6 +31,7 @@
 #include <logging/FileLogDestination.hpp>
 #include <logging/StderrLogDestination.hpp>
 #include <logging/SyslogDestination.hpp>
+#include <metrics/Metrics.hpp>
 #include <options/Options.hpp>
 #include <system/PosixSystem.hpp>
 #include <system/User.hpp>
@@ -208,6 +209,12 @@ int AbstractMain::run(int in_argc, char** in_argv)
    error = options.readOptions(in_argc, in_argv, getConfigFile());
    CHECK_ERROR(error)
 
+   // Configure the user cache before any users are looked up.
+   system::User::setCacheTimeouts(options.getUserCacheTtlSeconds(), options.getUserCacheNegativeTtlSeconds());
+
+   // Configure the timer slack before any timed events are started.
+   system::AsioService::setTimerSlack(options.getTimerSlackMilliseconds());
+
    // Ensure the server user exists.
    system::User serverUser;
    error = options.getServerUser(serverUser);
@@ -266,6 +273,13 @@ int AbstractMain::run(int in_argc, char** in_argv)
    error = system::posix::enableCoreDumps();
    CHECK_ERROR(error)
 
+   // Start collecting metrics, if enabled.
+   if (!options.getMetricsFile().isEmpty())
+   {
+      error = metrics::start(options.getMetricsFile(), options.getMetricsIntervalSeconds());
+      CHECK_ERROR(error, "Could not write metrics file: " + options.getMetricsFile().getAbsolutePath() + ".")
+   }
+
    // Create and initialize the LauncherPluginApi.
    std::shared_ptr<api::AbstractPluginApi> pluginApi = createLauncherPluginApi(launcherCommunicator);
    CHECK_ERROR(error);
@@ -274,7 +288,10 @@ int AbstractMain::run(int in_argc, char** in_argv)
    CHECK_ERROR(error)
 
    // Add the configured number of threads to the ASIO service.
-   system::AsioService::startThreads(options.getThreadPoolSize());
+   system::AsioService::startThreads(
+      options.getThreadPoolSize(),
+      options.useWorkStealingThreadPool() ? system::AsioExecutionMode::PER_WORKER : system::AsioExecutionMode::SHARED,
+      options.pinThreadPoolThreads());
 
    // Start the communicator.
    error = launcherCommunicator->start();
@@ -286,10 +303,14 @@ int AbstractMain::run(int in_argc, char** in_argv)
    // Stop the communicator and the threads.
    logInfoMessage("Stopping plugin...");
    launcherCommunicator->stop();
+   metrics::stop();
    system::AsioService::stop();
    launcherCommunicator->waitForExit();
    system::AsioService::waitForExit();
 
+   // Make sure any job changes which are still being written are on disk before exiting.
+   pluginApi->flush();
+
    return EXIT_SUCCESS;
 }
 
@@ -67,7 +67,24 @@ struct AbstractPluginApi::Impl
     */
    void sendErrorResponse(uint64_t in_requestId, ErrorResponse::Type in_type, const std::string& in_errorMessage)
    {
-      LauncherCommunicator->sendResponse(
+      sendErrorResponse(LauncherCommunicator, in_requestId, in_type, in_errorMessage);
+   }
+
+   /**
+    * @brief Sends an error response to the Launcher. For use by completion callbacks, which may outlive this object.
+    *
+    * @param in_launcherCommunicator    The communicator with which to send the response.
+    * @param in_requestId               The ID of the request for which an error occurred.
+    * @param in_type                    The type of error which occurred.
+    * @param in_errorMessage            The message of the error which occurred.
+    */
+   static void sendErrorResponse(
+      const comms::AbstractLauncherCommunicatorPtr& in_launcherCommunicator,
+      uint64_t in_requestId,
+      ErrorResponse::Type in_type,
+      const std::string& in_errorMessage)
+   {
+      in_launcherCommunicator->sendResponse(
          ErrorResponse(
             in_requestId,
             in_type,
@@ -142,18 +159,22 @@ struct AbstractPluginApi::Impl
             ErrorResponse::Type::INVALID_REQUEST,
             "User must not be empty.");
 
-      bool isInvalidRequest = false;
-      Error error = JobSource->submitJob(in_submitJobRequest->getJob(), isInvalidRequest);
-      if (error)
-         return sendErrorResponse(
-            in_submitJobRequest->getId(),
-            isInvalidRequest ? ErrorResponse::Type::INVALID_REQUEST : ErrorResponse::Type::UNKNOWN,
-            error.getSummary());
+      // Respond once the job source has finished, rather than waiting on it here.
+      comms::AbstractLauncherCommunicatorPtr communicator = LauncherCommunicator;
+      std::shared_ptr<SubmitJobRequest> request = in_submitJobRequest;
+      JobSource->submitJobAsync(
+         in_submitJobRequest->getJob(),
+         [communicator, request](const Error& in_error, bool in_wasInvalidRequest)
+         {
+            if (in_error)
+               return sendErrorResponse(
+                  communicator,
+                  request->getId(),
+                  in_wasInvalidRequest ? ErrorResponse::Type::INVALID_REQUEST : ErrorResponse::Type::UNKNOWN,
+                  in_error.getSummary());
 
-      LauncherCommunicator->sendResponse(
-         JobStateResponse(
-            in_submitJobRequest->getId(),
-            { in_submitJobRequest->getJob() }));
+            communicator->sendResponse(JobStateResponse(request->getId(), { request->getJob() }));
+         });
    }
 
    /**
@@ -213,7 +234,12 @@ struct AbstractPluginApi::Impl
       JobList jobs;
       if (jobId == "*")
       {
-         jobs = JobRepo->getJobs(in_getJobRequest->getUser());
+         // The full details of jobs are only needed if the request asks for fields which aren't in the summary.
+         if (fields &&
+            std::all_of(fields.getValueOr({}).begin(), fields.getValueOr({}).end(), &Job::isSummaryField))
+            jobs = JobRepo->getJobSummaries(in_getJobRequest->getUser());
+         else
+            jobs = JobRepo->getJobs(in_getJobRequest->getUser());
 
          // Filter the jobs based on the request.
          for (auto itr = jobs.begin(); itr != jobs.end();)
@@ -262,96 +288,98 @@ struct AbstractPluginApi::Impl
             " could not be found" +
             (requestUser.isAllUsers() ? "" : " for user " + requestUser.getUsername()));
 
+      // Pick the operation and the state the job must be in for it.
+      typedef void (IJobSource::*ControlJobFunction)(JobPtr, IJobSource::OnControlJobComplete);
+      ControlJobFunction controlJob = nullptr;
+      Job::State requiredState = Job::State::RUNNING;
+      std::string invalidStateMessage;
+      const ControlJobRequest::Operation operation = in_controlJobRequest->getOperation();
+      switch (operation)
+      {
+         case ControlJobRequest::Operation::KILL:
+         {
+            controlJob = &IJobSource::killJobAsync;
+            invalidStateMessage = "Job must be running to kill it";
+            break;
+         }
+         case ControlJobRequest::Operation::SUSPEND:
+         {
+            controlJob = &IJobSource::suspendJobAsync;
+            invalidStateMessage = "Job must be running to suspend it";
+            break;
+         }
+         case ControlJobRequest::Operation::RESUME:
+         {
+            controlJob = &IJobSource::resumeJobAsync;
+            requiredState = Job::State::SUSPENDED;
+            invalidStateMessage = "Job must be suspended to resume it";
+            break;
+         }
+         case ControlJobRequest::Operation::STOP:
+         {
+            controlJob = &IJobSource::stopJobAsync;
+            invalidStateMessage = "Job must be running to stop it";
+            break;
+         }
+         case ControlJobRequest::Operation::CANCEL:
+         {
+            controlJob = &IJobSource::cancelJobAsync;
+            requiredState = Job::State::PENDING;
+            invalidStateMessage = "Job must be pending to cancel it";
+            break;
+         }
+         default:
+         {
+            assert(false);
+            return sendErrorResponse(
+               in_controlJobRequest->getId(),
+               ErrorResponse::Type::UNKNOWN,
+               "Internal server error: unrecognized control job operation.");
+         }
+      }
+
+      // Only hold the job lock while checking its state, so the job isn't locked while the job source works.
+      bool isValidState = false;
       LOCK_JOB(job)
       {
-         bool opUnsupported = false;
-         bool opComplete = false;
-         std::string message;
-         switch (in_controlJobRequest->getOperation())
+         isValidState = (job->Status == requiredState);
+      }
+      END_LOCK_JOB
+
+      if (!isValidState)
+         return sendErrorResponse(
+            in_controlJobRequest->getId(),
+            ErrorResponse::Type::INVALID_JOB_STATE,
+            invalidStateMessage);
+
+      comms::AbstractLauncherCommunicatorPtr communicator = LauncherCommunicator;
+      uint64_t requestId = in_controlJobRequest->getId();
+      ((*JobSource).*controlJob)(
+         job,
+         [communicator, requestId, operation, invalidStateMessage](
+            ControlJobResult in_result,
+            const std::string& in_message)
          {
-            case ControlJobRequest::Operation::KILL:
-            {
-               if (job->Status != Job::State::RUNNING)
-                  return sendErrorResponse(
-                     in_controlJobRequest->getId(),
-                     ErrorResponse::Type::INVALID_JOB_STATE,
-                     "Job must be running to kill it");
-
-               opUnsupported = JobSource->killJob(job, opComplete, message);
-               break;
-            }
-            case ControlJobRequest::Operation::SUSPEND:
-            {
-               if (job->Status != Job::State::RUNNING)
-                  return sendErrorResponse(
-                     in_controlJobRequest->getId(),
-                     ErrorResponse::Type::INVALID_JOB_STATE,
-                     "Job must be running to suspend it");
-
-               opUnsupported = JobSource->suspendJob(job, opComplete, message);
-               break;
-            }
-            case ControlJobRequest::Operation::RESUME:
-            {
-               if (job->Status != Job::State::SUSPENDED)
-                  return sendErrorResponse(
-                     in_controlJobRequest->getId(),
-                     ErrorResponse::Type::INVALID_JOB_STATE,
-                     "Job must be suspended to resume it");
-
-               opUnsupported = JobSource->resumeJob(job, opComplete, message);
-               break;
-            }
-            case ControlJobRequest::Operation::STOP:
-            {
-               if (job->Status != Job::State::RUNNING)
-                  return sendErrorResponse(
-                     in_controlJobRequest->getId(),
-                     ErrorResponse::Type::INVALID_JOB_STATE,
-                     "Job must be running to stop it");
-
-               opUnsupported = JobSource->stopJob(job, opComplete, message);
-               break;
-            }
-            case ControlJobRequest::Operation::CANCEL:
-            {
-               if (job->Status != Job::State::PENDING)
-                  return sendErrorResponse(
-                     in_controlJobRequest->getId(),
-                     ErrorResponse::Type::INVALID_JOB_STATE,
-                     "Job must be pending to cancel it");
-
-               opUnsupported = JobSource->cancelJob(job, opComplete, message);
-               break;
-            }
-            default:
-            {
-               assert(false);
+            if (in_result == ControlJobResult::INVALID_STATE)
                return sendErrorResponse(
-                  in_controlJobRequest->getId(),
-                  ErrorResponse::Type::UNKNOWN,
-                  "Internal server error: unrecognized control job operation.");
-            }
+                  communicator,
+                  requestId,
+                  ErrorResponse::Type::INVALID_JOB_STATE,
+                  invalidStateMessage);
 
-            if (opUnsupported)
+            if (in_result == ControlJobResult::NOT_SUPPORTED)
             {
-               std::string opStr = std::to_string(static_cast<int>(in_controlJobRequest->getOperation()));
-               sendErrorResponse(
-                  in_controlJobRequest->getId(),
+               std::string opStr = std::to_string(static_cast<int>(operation));
+               return sendErrorResponse(
+                  communicator,
+                  requestId,
                   ErrorResponse::Type::INVALID_REQUEST,
-                  message.empty() ?
-                     "Operation " + opStr + " not supported." :
-                     message);
-            }
-            else
-            {
-               LauncherCommunicator->sendResponse(
-                  ControlJobResponse(in_controlJobRequest->getId(), message, opComplete));
+                  in_message.empty() ? "Operation " + opStr + " not supported." : in_message);
             }
-            
-         }
-      }
-      END_LOCK_JOB
+
+            communicator->sendResponse(
+               ControlJobResponse(requestId, in_message, in_result == ControlJobResult::COMPLETE));
+         });
    }
 
    void handleGetNetworkRequest(const std::shared_ptr<NetworkRequest>& in_networkRequest)
@@ -368,12 +396,17 @@ struct AbstractPluginApi::Impl
                " could not be found" +
                (requestUser.isAllUsers() ? "" : " for user " + requestUser.getUsername()));
 
-      NetworkInfo networkInfo;
-      Error error = JobSource->getNetworkInfo(job, networkInfo);
-      if (error)
-         return sendErrorResponse(in_networkRequest->getId(), ErrorResponse::Type::UNKNOWN, error);
+      comms::AbstractLauncherCommunicatorPtr communicator = LauncherCommunicator;
+      uint64_t requestId = in_networkRequest->getId();
+      JobSource->getNetworkInfoAsync(
+         job,
+         [communicator, requestId](const Error& in_error, const NetworkInfo& in_networkInfo)
+         {
+            if (in_error)
+               return sendErrorResponse(communicator, requestId, ErrorResponse::Type::UNKNOWN, in_error.asString());
 
-      LauncherCommunicator->sendResponse(NetworkResponse(in_networkRequest->getId(), networkInfo));
+            communicator->sendResponse(NetworkResponse(requestId, in_networkInfo));
+         });
    }
 
    /**
@@ -386,12 +419,16 @@ struct AbstractPluginApi::Impl
       const system::User& requestUser = in_clusterInfoRequest->getUser();
       uint64_t requestId = in_clusterInfoRequest->getId();
 
-      JobSourceConfiguration caps;
-      Error error = JobSource->getConfiguration(requestUser, caps);
-      if (error)
-         return sendErrorResponse(requestId, ErrorResponse::Type::UNKNOWN, error);
+      comms::AbstractLauncherCommunicatorPtr communicator = LauncherCommunicator;
+      JobSource->getConfigurationAsync(
+         requestUser,
+         [communicator, requestId](const Error& in_error, const JobSourceConfiguration& in_configuration)
+         {
+            if (in_error)
+               return sendErrorResponse(communicator, requestId, ErrorResponse::Type::UNKNOWN, in_error.asString());
 
-      LauncherCommunicator->sendResponse(ClusterInfoResponse(in_clusterInfoRequest->getId(), caps));
+            communicator->sendResponse(ClusterInfoResponse(requestId, in_configuration));
+         });
    }
 
 
@@ -523,6 +560,12 @@ Error AbstractPluginApi::initialize()
    return doInitialize();
 }
 
+void AbstractPluginApi::flush()
+{
+   if (m_abstractPluginImpl->JobRepo)
+      m_abstractPluginImpl->JobRepo->flush();
+}
+
 AbstractPluginApi::AbstractPluginApi(std::shared_ptr<comms::AbstractLauncherCommunicator> in_launcherCommunicator) :
    m_abstractPluginImpl(new Impl(std::move(in_launcherCommunicator)))
 {
@@ -0,0 +1,147 @@
+/*
+ * IJobSource.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <api/IJobSource.hpp>
+
+#include <system/User.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace api {
+
+namespace {
+
+typedef bool (IJobSource::*ControlJobFunction)(JobPtr, bool&, std::string&);
+
+/**
+ * @brief Invokes a synchronous control job operation with the Job lock held, and then its completion callback.
+ *
+ * @param in_jobSource      The job source on which to invoke the operation.
+ * @param in_function       The control job operation to invoke.
+ * @param in_requiredState  The state the job must be in for the operation to be performed.
+ * @param in_job            The job to control.
+ * @param in_onComplete     Callback function which will be invoked with the result of the operation.
+ */
+void controlJob(
+   IJobSource& in_jobSource,
+   ControlJobFunction in_function,
+   Job::State in_requiredState,
+   const JobPtr& in_job,
+   const IJobSource::OnControlJobComplete& in_onComplete)
+{
+   ControlJobResult result = ControlJobResult::INVALID_STATE;
+   std::string statusMessage;
+   LOCK_JOB(in_job)
+   {
+      // The state was checked before this was invoked, but the Job lock may have been released since.
+      if (in_job->Status == in_requiredState)
+      {
+         bool isComplete = false;
+         if (!(in_jobSource.*in_function)(in_job, isComplete, statusMessage))
+            result = ControlJobResult::NOT_SUPPORTED;
+         else
+            result = isComplete ? ControlJobResult::COMPLETE : ControlJobResult::INCOMPLETE;
+      }
+   }
+   END_LOCK_JOB
+
+   in_onComplete(result, statusMessage);
+}
+
+} // anonymous namespace
+
+void IJobSource::cancelJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete)
+{
+   controlJob(*this, &IJobSource::cancelJob, Job::State::PENDING, in_job, in_onComplete);
+}
+
+void IJobSource::createOutputStreamAsync(
+   OutputType in_outputType,
+   JobPtr in_job,
+   AbstractOutputStream::OnOutput in_onOutput,
+   AbstractOutputStream::OnComplete in_onComplete,
+   AbstractOutputStream::OnError in_onError,
+   OnCreateOutputStreamComplete in_onCreated)
+{
+   Error error;
+   OutputStreamPtr outputStream;
+   LOCK_JOB(in_job)
+   {
+      error = createOutputStream(
+         in_outputType,
+         in_job,
+         std::move(in_onOutput),
+         std::move(in_onComplete),
+         std::move(in_onError),
+         outputStream);
+   }
+   END_LOCK_JOB
+
+   in_onCreated(error, outputStream);
+}
+
+void IJobSource::getConfigurationAsync(const system::User& in_user, OnGetConfigurationComplete in_onComplete) const
+{
+   JobSourceConfiguration configuration;
+   Error error = getConfiguration(in_user, configuration);
+   in_onComplete(error, configuration);
+}
+
+void IJobSource::getNetworkInfoAsync(JobPtr in_job, OnGetNetworkInfoComplete in_onComplete) const
+{
+   NetworkInfo networkInfo;
+   Error error = getNetworkInfo(in_job, networkInfo);
+   in_onComplete(error, networkInfo);
+}
+
+void IJobSource::killJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete)
+{
+   controlJob(*this, &IJobSource::killJob, Job::State::RUNNING, in_job, in_onComplete);
+}
+
+void IJobSource::resumeJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete)
+{
+   controlJob(*this, &IJobSource::resumeJob, Job::State::SUSPENDED, in_job, in_onComplete);
+}
+
+void IJobSource::stopJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete)
+{
+   controlJob(*this, &IJobSource::stopJob, Job::State::RUNNING, in_job, in_onComplete);
+}
+
+void IJobSource::submitJobAsync(JobPtr io_job, OnSubmitJobComplete in_onComplete) const
+{
+   bool wasInvalidRequest = false;
+   Error error = submitJob(io_job, wasInvalidRequest);
+   in_onComplete(error, wasInvalidRequest);
+}
+
+void IJobSource::suspendJobAsync(JobPtr in_job, OnControlJobComplete in_onComplete)
+{
+   controlJob(*this, &IJobSource::suspendJob, Job::State::RUNNING, in_job, in_onComplete);
+}
+
+} // namespace api
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -23,6 +23,7 @@
 
 #include <api/Job.hpp>
 
+#include <algorithm>
 #include <mutex>
 
 #include <boost/algorithm/string/predicate.hpp>
@@ -358,6 +359,25 @@ json::Array toJsonArray(const std::vector<T>& in_vector)
    return arr;
 }
 
+json::Array toJsonArray(const std::set<utils::InternedString>& in_set)
+{
+   json::Array arr;
+   for (const utils::InternedString& value: in_set)
+      arr.push_back(json::Value(value.str()));
+
+   return arr;
+}
+
+std::set<utils::InternedString> toInternedSet(const std::set<std::string>& in_set)
+{
+   // The values are already in order, so each insert is at the end.
+   std::set<utils::InternedString> result;
+   for (const std::string& value: in_set)
+      result.insert(result.end(), utils::InternedString(value));
+
+   return result;
+}
+
 template <>
 json::Array toJsonArray(const EnvironmentList& in_vector)
 {
@@ -391,10 +411,11 @@ Error& updateError(const std::string& in_name, const json::Object& in_object, Er
 // Container ===========================================================================================================
 Error Container::fromJson(const json::Object& in_json, Container& out_container)
 {
+   std::string image;
    Optional<json::Array> supplementalGroupIds;
 
    Error error = json::readObject(in_json,
-      CONTAINER_IMAGE, out_container.Image,
+      CONTAINER_IMAGE, image,
       CONTAINER_RUN_AS_USER_ID, out_container.RunAsUserId,
       CONTAINER_RUN_AS_GROUP_ID, out_container.RunAsGroupId,
       CONTAINER_SUPP_GROUP_IDS, supplementalGroupIds);
@@ -402,6 +423,8 @@ Error Container::fromJson(const json::Object& in_json, Container& out_container)
    if (error)
       return updateError(JOB_CONTAINER, in_json, error);
 
+   out_container.Image = image;
+
    if (supplementalGroupIds &&
       !supplementalGroupIds.getValueOr(json::Array()).toVectorInt(out_container.SupplementalGroupIds))
       return jobParseError(
@@ -416,7 +439,7 @@ Error Container::fromJson(const json::Object& in_json, Container& out_container)
 json::Object Container::toJson() const
 {
    json::Object containerObj;
-   containerObj[CONTAINER_IMAGE] = Image;
+   containerObj[CONTAINER_IMAGE] = Image.str();
 
    if (RunAsUserId)
       containerObj[CONTAINER_RUN_AS_USER_ID] = RunAsUserId.getValueOr(0);
@@ -629,12 +652,12 @@ Error Job::fromJson(const json::Object& in_json, Job& out_job)
    result.Exe = exe.getValueOr("");
    result.Host = host.getValueOr("");
    result.Id = id.getValueOr("");
-   result.Queues = queues.getValueOr({});
+   result.Queues = toInternedSet(queues.getValueOr({}));
    result.StandardIn = stdIn.getValueOr("");
    result.StandardErrFile = stdErr.getValueOr("");
    result.StandardOutFile = stdOut.getValueOr("");
    result.StatusMessage = statusMessage.getValueOr("");
-   result.Tags = tags.getValueOr({});
+   result.Tags = toInternedSet(tags.getValueOr({}));
    result.WorkingDirectory = workingDir.getValueOr("");
 
    if (containerObj)
@@ -701,6 +724,26 @@ Error Job::fromJson(const json::Object& in_json, Job& out_job)
    return Success();
 }
 
+bool Job::isSummaryField(const std::string& in_fieldName)
+{
+   static const std::set<std::string> summaryFields = {
+      JOB_CLUSTER,
+      JOB_EXIT_CODE,
+      JOB_HOST,
+      JOB_ID,
+      JOB_LAST_UPDATE_TIME,
+      JOB_NAME,
+      JOB_PID,
+      JOB_QUEUES,
+      JOB_STATUS,
+      JOB_STATUS_MESSAGE,
+      JOB_SUBMISSION_TIME,
+      JOB_TAGS,
+      JOB_USER };
+
+   return summaryFields.find(in_fieldName) != summaryFields.end();
+}
+
 Error Job::stateFromString(const std::string& in_statusString, State& out_status)
 {
    if (!jobStatusFromString(in_statusString, out_status))
@@ -807,6 +850,25 @@ Optional<std::string> Job::getJobConfigValue(const std::string& in_name) const
    return value;
 }
 
+JobPtr Job::getSummary() const
+{
+   JobPtr summary(new Job());
+   summary->Cluster = Cluster;
+   summary->ExitCode = ExitCode;
+   summary->Host = Host;
+   summary->Id = Id;
+   summary->LastUpdateTime = LastUpdateTime;
+   summary->Name = Name;
+   summary->Pid = Pid;
+   summary->Queues = Queues;
+   summary->Status = Status;
+   summary->StatusMessage = StatusMessage;
+   summary->SubmissionTime = SubmissionTime;
+   summary->Tags = Tags;
+   summary->User = User;
+   return summary;
+}
+
 bool Job::isCompleted() const
 {
    return (Status == State::FINISHED) ||
@@ -820,11 +882,21 @@ bool Job::matchesTags(const std::set<std::string>& in_tags) const
    if (in_tags.size() > Tags.size())
       return false;
 
-   for (const std::string& searchTag: in_tags)
-      if (Tags.find(searchTag) == Tags.end())
-         return false;
+   // Both sets are ordered by value, so they can be compared without interning the search tags.
+   struct TagLess
+   {
+      bool operator()(const utils::InternedString& in_lhs, const std::string& in_rhs) const
+      {
+         return in_lhs.str() < in_rhs;
+      }
+
+      bool operator()(const std::string& in_lhs, const utils::InternedString& in_rhs) const
+      {
+         return in_lhs < in_rhs.str();
+      }
+   };
 
-   return true;
+   return std::includes(Tags.begin(), Tags.end(), in_tags.begin(), in_tags.end(), TagLess());
 }
 
 json::Object Job::toJson() const
@@ -834,7 +906,7 @@ json::Object Job::toJson() const
    jobObj[JOB_ARGUMENTS] = json::toJsonArray(Arguments);
 
    if (!Cluster.empty())
-      jobObj[JOB_CLUSTER] = Cluster;
+      jobObj[JOB_CLUSTER] = Cluster.str();
 
    jobObj[JOB_COMMAND] = Command;
    jobObj[JOB_CONFIG] = toJsonArray(Config);
@@ -849,7 +921,7 @@ json::Object Job::toJson() const
    if (ExitCode)
       jobObj[JOB_EXIT_CODE] = ExitCode.getValueOr(-1);
 
-   jobObj[JOB_HOST] = Host;
+   jobObj[JOB_HOST] = Host.str();
    jobObj[JOB_ID] = Id;
 
    if (LastUpdateTime)
@@ -862,7 +934,7 @@ json::Object Job::toJson() const
       jobObj[JOB_PID] = Pid.getValueOr(-1);
 
    jobObj[JOB_PLACEMENT_CONSTRAINTS] = toJsonArray(PlacementConstraints);
-   jobObj[JOB_QUEUES] = json::toJsonArray(Queues);
+   jobObj[JOB_QUEUES] = toJsonArray(Queues);
    jobObj[JOB_RESOURCE_LIMITS] = toJsonArray(ResourceLimits);
    jobObj[JOB_STANDARD_IN] = StandardIn;
    jobObj[JOB_STANDARD_ERROR_FILE] = StandardErrFile;
@@ -874,7 +946,7 @@ json::Object Job::toJson() const
 
   jobObj[JOB_SUBMISSION_TIME] = SubmissionTime.toString();
 
-   jobObj[JOB_TAGS] = json::toJsonArray(Tags);
+   jobObj[JOB_TAGS] = toJsonArray(Tags);
    jobObj[JOB_USER] = User.getUsername();
    jobObj[JOB_WORKING_DIRECTORY] = WorkingDirectory;
 
@@ -890,15 +962,18 @@ JobConfig::JobConfig(std::string in_name, Type in_type) :
 
 Error JobConfig::fromJson(const json::Object& in_json, JobConfig& out_jobConfig)
 {
+   std::string name;
    Optional<std::string> optStrType;
    Error error = json::readObject(in_json,
-      JOB_CONFIG_NAME, out_jobConfig.Name,
+      JOB_CONFIG_NAME, name,
       JOB_CONFIG_VALUE, out_jobConfig.Value,
       JOB_CONFIG_TYPE, optStrType);
 
    if (error)
       return updateError(JOB_CONFIG, in_json, error);
 
+   out_jobConfig.Name = name;
+
    if (optStrType)
    {
       std::string strType = optStrType.getValueOr("");
@@ -927,7 +1002,7 @@ Error JobConfig::fromJson(const json::Object& in_json, JobConfig& out_jobConfig)
 json::Object JobConfig::toJson() const
 {
    json::Object confObj;
-   confObj[JOB_CONFIG_NAME] = Name;
+   confObj[JOB_CONFIG_NAME] = Name.str();
 
    if (ValueType)
    {
@@ -1396,14 +1471,17 @@ std::string NfsMountSource::getPath() const
 // Mount ===============================================================================================================
 Error Mount::fromJson(const json::Object& in_json, Mount& out_mount)
 {
+   std::string destination;
    Optional<bool> isReadOnly;
    Error error = json::readObject(in_json,
-      MOUNT_PATH, out_mount.Destination,
+      MOUNT_PATH, destination,
       MOUNT_READ_ONLY, isReadOnly);
 
    if (error)
       return updateError(JOB_MOUNTS, in_json, error);
 
+   out_mount.Destination = destination;
+
    error = MountSource::fromJson(in_json, out_mount.Source);
    if (error)
       return error;
@@ -1416,7 +1494,7 @@ Error Mount::fromJson(const json::Object& in_json, Mount& out_mount)
 json::Object Mount::toJson() const
 {
    json::Object mountObj;
-   mountObj[MOUNT_PATH] = Destination;
+   mountObj[MOUNT_PATH] = Destination.str();
    mountObj[MOUNT_READ_ONLY] = IsReadOnly;
    mountObj[MOUNT_TYPE] = mountTypeToString(Source.SourceType, Source.CustomType);
    mountObj[MOUNT_SOURCE] = Source.SourceObject;
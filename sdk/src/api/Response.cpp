@@ -26,6 +26,7 @@
 #include <atomic>
 
 #include <json/Json.hpp>
+#include <json/JsonEscape.hpp>
 #include <api/IJobSource.hpp>
 #include "Constants.hpp"
 
@@ -78,6 +79,11 @@ json::Object Response::toJson() const
    return jsonObject;
 }
 
+std::string Response::write() const
+{
+   return toJson().write();
+}
+
 Response::Response(Type in_responseType, uint64_t in_requestId) :
    m_responseImpl(new Impl(in_responseType, in_requestId))
 {
@@ -321,7 +327,7 @@ struct OutputStreamResponse::Impl
 {
    Impl(uint64_t in_sequenceId, std::string&& in_output, OutputType in_outputType) :
       IsComplete(false),
-      Output(in_output),
+      Output(std::move(in_output)),
       OutType(in_outputType),
       SequenceId(in_sequenceId)
    {
@@ -333,6 +339,40 @@ struct OutputStreamResponse::Impl
    {
    }
 
+   /**
+    * @brief Adds every field of the response except the output itself.
+    *
+    * @param io_result      The JSON object to which the fields should be added.
+    */
+   void addFields(json::Object& io_result) const
+   {
+      io_result[FIELD_SEQUENCE_ID] = SequenceId;
+      io_result[FIELD_COMPLETE] = IsComplete;
+
+      if (Output.empty())
+         return;
+
+      switch (OutType)
+      {
+         case OutputType::STDOUT:
+         {
+            io_result[FIELD_OUTPUT_TYPE] = "stdout";
+            break;
+         }
+         case OutputType::STDERR:
+         {
+            io_result[FIELD_OUTPUT_TYPE] = "stderr";
+            break;
+         }
+         default:
+         case OutputType::BOTH:
+         {
+            io_result[FIELD_OUTPUT_TYPE] = "mixed";
+            break;
+         }
+      }
+   }
+
    bool IsComplete;
    std::string Output;
    OutputType OutType;
@@ -360,37 +400,33 @@ OutputStreamResponse::OutputStreamResponse(uint64_t in_requestId, uint64_t in_se
 json::Object OutputStreamResponse::toJson() const
 {
    json::Object result = Response::toJson();
-   result[FIELD_SEQUENCE_ID] = m_impl->SequenceId;
-   result[FIELD_COMPLETE] = m_impl->IsComplete;
+   m_impl->addFields(result);
 
    if (!m_impl->Output.empty())
-   {
       result[FIELD_OUTPUT] = m_impl->Output;
-      
-      switch (m_impl->OutType)
-      {
-         case OutputType::STDOUT:
-         {
-            result[FIELD_OUTPUT_TYPE] = "stdout";
-            break;
-         }
-         case OutputType::STDERR:
-         {
-            result[FIELD_OUTPUT_TYPE] = "stderr";
-            break;
-         }
-         default:
-         case OutputType::BOTH:
-         {
-            result[FIELD_OUTPUT_TYPE] = "mixed";
-            break;
-         }
-      }
-   }
 
    return result;
 }
 
+std::string OutputStreamResponse::write() const
+{
+   json::Object result = Response::toJson();
+   m_impl->addFields(result);
+
+   std::string jsonStr = result.write();
+   if (m_impl->Output.empty())
+      return jsonStr;
+
+   // The output is usually far larger than the rest of the response, so it is escaped straight into the end of the
+   // written object rather than being copied into the JSON object and escaped by the JSON writer.
+   jsonStr.pop_back();
+   jsonStr.append(",\"").append(FIELD_OUTPUT).append("\":");
+   json::appendEscapedString(m_impl->Output.data(), m_impl->Output.size(), jsonStr);
+   jsonStr.push_back('}');
+
+   return jsonStr;
+}
+
 // Resource Utilization Stream Response ================================================================================
 struct ResourceUtilStreamResponse::Impl
 {
@@ -171,6 +171,15 @@ void AbstractMultiStream<R, Args...>::sendResponse(const std::set<uint64_t>& in_
       m_baseImpl->LauncherCommunicator->sendResponse(R(sequences, in_responseArgs...));
 }
 
+template <typename R, typename ... Args>
+void AbstractMultiStream<R, Args...>::sendSequencedResponse(
+   const StreamSequences& in_sequences,
+   Args... in_responseArgs)
+{
+   if (!in_sequences.empty())
+      m_baseImpl->LauncherCommunicator->sendResponse(R(in_sequences, in_responseArgs...));
+}
+
 template <typename R, typename ... Args>
 void AbstractMultiStream<R, Args...>::onRemoveRequest(uint64_t in_requestId)
 {
@@ -23,6 +23,9 @@
 
 #include "JobStatusStream.hpp"
 
+#include <unordered_map>
+#include <vector>
+
 namespace rstudio {
 namespace launcher_plugins {
 namespace api {
@@ -34,6 +37,21 @@ typedef std::weak_ptr<AllJobStatusStream> WeakAll;
 
 typedef std::map<uint64_t, system::User> RequestUserMap;
 
+/**
+ * @brief A request which is listening to a stream, and the sequence ID of the next response it will be sent.
+ */
+struct RequestSequence
+{
+   /** The ID of the request. */
+   uint64_t RequestId;
+
+   /** The sequence ID of the next response to the request. */
+   uint64_t NextSequenceId;
+};
+
+typedef std::vector<RequestSequence> RequestSequences;
+typedef std::unordered_map<system::UidType, RequestSequences> UserRequestsMap;
+
 // Single Job Status Stream ============================================================================================
 struct SingleJobStatusStream::Impl
 {
@@ -162,6 +180,131 @@ struct AllJobStatusStream::Impl
    {
    }
 
+   /**
+    * @brief Adds a request, indexed by the user who made it.
+    *
+    * @param in_requestId       The ID of the request.
+    * @param in_requestUser     The user who made the request.
+    */
+   void addRequest(uint64_t in_requestId, const system::User& in_requestUser)
+   {
+      if (!RequestUsers.emplace(in_requestId, in_requestUser).second)
+         return;
+
+      // An empty user can't see any jobs.
+      if (in_requestUser.isEmpty())
+         return;
+
+      RequestSequences& requests = in_requestUser.isAllUsers() ?
+         AdminRequests :
+         UserRequests[in_requestUser.getUserId()];
+      requests.push_back(RequestSequence{ in_requestId, 1 });
+   }
+
+   /**
+    * @brief Gets the requests made by the specified user.
+    *
+    * @param in_requestUser     The user who made the requests.
+    *
+    * @return The requests made by the user, if any; nullptr otherwise.
+    */
+   RequestSequences* findRequests(const system::User& in_requestUser)
+   {
+      if (in_requestUser.isAllUsers())
+         return &AdminRequests;
+
+      if (in_requestUser.isEmpty())
+         return nullptr;
+
+      auto itr = UserRequests.find(in_requestUser.getUserId());
+      return (itr == UserRequests.end()) ? nullptr : &itr->second;
+   }
+
+   /**
+    * @brief Gets the sequence ID of the next response to the specified request.
+    *
+    * @param in_requestId   The ID of the request.
+    *
+    * @return The request and its next sequence ID, if the request is listening to this stream.
+    */
+   StreamSequences getSequences(uint64_t in_requestId)
+   {
+      StreamSequences sequences;
+      auto userItr = RequestUsers.find(in_requestId);
+      if (userItr == RequestUsers.end())
+         return sequences;
+
+      if (RequestSequences* requests = findRequests(userItr->second))
+      {
+         for (RequestSequence& request: *requests)
+         {
+            if (request.RequestId == in_requestId)
+               sequences.emplace_back(request.RequestId, request.NextSequenceId++);
+         }
+      }
+
+      return sequences;
+   }
+
+   /**
+    * @brief Gets the requests which should be given information about the specified job, and the sequence ID of the
+    *        next response to each.
+    *
+    * @param in_job     The job which was updated.
+    *
+    * @return The requests with permission to see the specified job's details and their next sequence IDs.
+    */
+   StreamSequences getSequences(const JobPtr& in_job)
+   {
+      StreamSequences sequences;
+      auto userItr = in_job->User.isEmpty() ? UserRequests.end() : UserRequests.find(in_job->User.getUserId());
+
+      size_t count = AdminRequests.size() + ((userItr == UserRequests.end()) ? 0 : userItr->second.size());
+      if (count == 0)
+         return sequences;
+
+      sequences.reserve(count);
+      for (RequestSequence& request: AdminRequests)
+         sequences.emplace_back(request.RequestId, request.NextSequenceId++);
+
+      if (userItr != UserRequests.end())
+      {
+         for (RequestSequence& request: userItr->second)
+            sequences.emplace_back(request.RequestId, request.NextSequenceId++);
+      }
+
+      return sequences;
+   }
+
+   /**
+    * @brief Removes a request from the index.
+    *
+    * @param in_requestId   The ID of the request.
+    */
+   void removeRequest(uint64_t in_requestId)
+   {
+      auto userItr = RequestUsers.find(in_requestId);
+      if (userItr == RequestUsers.end())
+         return;
+
+      if (RequestSequences* requests = findRequests(userItr->second))
+      {
+         for (auto itr = requests->begin(); itr != requests->end(); ++itr)
+         {
+            if (itr->RequestId == in_requestId)
+            {
+               requests->erase(itr);
+               break;
+            }
+         }
+
+         if (requests->empty() && !userItr->second.isAllUsers())
+            UserRequests.erase(userItr->second.getUserId());
+      }
+
+      RequestUsers.erase(userItr);
+   }
+
    /** The JobStatus Subscription Handle. */
    jobs::SubscriptionHandle Handle;
 
@@ -174,8 +317,17 @@ struct AllJobStatusStream::Impl
    /** The job status notifier, which will notify about new job updates. */
    jobs::JobStatusNotifierPtr Notifier;
 
-   /** The map from Request ID to User. Used to filter job status responses based on permissions. */
+   /** The map from Request ID to User. */
    RequestUserMap RequestUsers;
+
+   // Requests are indexed by user so that a job update only visits the requests which may see the job. Sequence IDs
+   // are tracked here rather than by AbstractMultiStream to avoid looking each request up again when responding.
+
+   /** The requests made with admin privileges, which may see every job. */
+   RequestSequences AdminRequests;
+
+   /** The requests made by each user, who may only see their own jobs. */
+   UserRequestsMap UserRequests;
 };
 
 PRIVATE_IMPL_DELETER_IMPL(AllJobStatusStream)
@@ -193,9 +345,7 @@ void AllJobStatusStream::addRequest(uint64_t in_requestId, const system::User& i
 {
    LOCK_MUTEX(m_mutex)
    {
-      auto itr = m_impl->RequestUsers.find(in_requestId);
-      if (itr == m_impl->RequestUsers.end())
-         m_impl->RequestUsers.emplace(in_requestId, in_requestUser);
+      m_impl->addRequest(in_requestId, in_requestUser);
 
       onAddRequest(in_requestId);
       if (m_impl->IsInitialized)
@@ -212,24 +362,27 @@ Error AllJobStatusStream::initialize()
    // First send the initial job states.
    sendInitialStates();
 
-   // Then register for updates.
+   // Then register for updates. Batches of updates are sent under a single acquisition of the stream mutex.
    WeakAll weakThis = shared_from_this();
-   jobs::OnJobStatusUpdate onJobStatusUpdate = [weakThis](const api::JobPtr& in_job)
+   jobs::OnJobStatusBatchUpdate onJobStatusUpdates = [weakThis](const api::JobList& in_jobs)
    {
       if (SharedAll sharedThis = weakThis.lock())
       {
          LOCK_MUTEX(sharedThis->m_mutex)
          {
-            LOCK_JOB(in_job)
+            for (const JobPtr& job: in_jobs)
             {
-               sharedThis->sendResponse(sharedThis->getRequestIdsForJob(in_job), in_job);
+               LOCK_JOB(job)
+               {
+                  sharedThis->sendSequencedResponse(sharedThis->m_impl->getSequences(job), job);
+               }
+               END_LOCK_JOB
             }
-            END_LOCK_JOB
          }
          END_LOCK_MUTEX
       }
    };
-   m_impl->Handle = m_impl->Notifier->subscribe(onJobStatusUpdate);
+   m_impl->Handle = m_impl->Notifier->subscribeBatch(onJobStatusUpdates);
 
    m_impl->IsInitialized = true;
    return Success();
@@ -239,27 +392,13 @@ void AllJobStatusStream::removeRequest(uint64_t in_requestId)
 {
    LOCK_MUTEX(m_mutex)
    {
-      auto itr = m_impl->RequestUsers.find(in_requestId);
-      if (itr != m_impl->RequestUsers.end())
-         m_impl->RequestUsers.erase(in_requestId);
+      m_impl->removeRequest(in_requestId);
 
       onRemoveRequest(in_requestId);
    }
    END_LOCK_MUTEX
 }
 
-std::set<uint64_t> AllJobStatusStream::getRequestIdsForJob(const JobPtr& in_job) const
-{
-   std::set<uint64_t> requestIds;
-   for (const auto& requestUser: m_impl->RequestUsers)
-   {
-      if (requestUser.second.isAllUsers() || requestUser.second == in_job->User)
-         requestIds.insert(requestUser.first);
-   }
-
-   return requestIds;
-}
-
 void AllJobStatusStream::sendInitialStates(uint64_t in_requestId)
 {
    if (in_requestId != 0)
@@ -267,12 +406,12 @@ void AllJobStatusStream::sendInitialStates(uint64_t in_requestId)
       const auto& itr = m_impl->RequestUsers.find(in_requestId);
       if (itr != m_impl->RequestUsers.end())
       {
-         const JobList& jobs = m_impl->JobRepo->getJobs(itr->second);
+         const JobList& jobs = m_impl->JobRepo->getJobSummaries(itr->second);
          for (const auto& job: jobs)
          {
             LOCK_JOB(job)
             {
-               sendResponse({ in_requestId }, job);
+               sendSequencedResponse(m_impl->getSequences(in_requestId), job);
             }
             END_LOCK_JOB
          }
@@ -280,13 +419,13 @@ void AllJobStatusStream::sendInitialStates(uint64_t in_requestId)
    }
    else
    {
-      // Get all the jobs and filter based on permission using getRequestIdsForJob.
-      const JobList& jobs = m_impl->JobRepo->getJobs(system::User());
+      // Get all the jobs and send each to the requests with permission to see it.
+      const JobList& jobs = m_impl->JobRepo->getJobSummaries(system::User());
       for (const auto& job: jobs)
       {
          LOCK_JOB(job)
          {
-            sendResponse(getRequestIdsForJob(job), job);
+            sendSequencedResponse(m_impl->getSequences(job), job);
          }
          END_LOCK_JOB
       }
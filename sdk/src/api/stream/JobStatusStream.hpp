@@ -132,17 +132,6 @@ public:
    void removeRequest(uint64_t in_requestId) override;
 
 private:
-   /**
-    * @brief Gets the IDs of the requests which should be given information about the specified job.
-    *
-    * NOTE: The mutex must be held when this is called.
-    *
-    * @param in_job     The job which was updated.
-    *
-    * @return The set of request IDs with permission to see the specified job's details.
-    */
-   std::set<uint64_t> getRequestIdsForJob(const JobPtr& in_job) const;
-
    /**
     * @brief Sends the initial states for the given request, or all requests if none is specified.
     *
@@ -25,6 +25,7 @@
 #include "OutputStreamManager.hpp"
 
 #include <cassert>
+#include <set>
 
 #include <api/IJobSource.hpp>
 #include <api/Request.hpp>
@@ -92,6 +93,38 @@ struct OutputStreamManager::Impl : public std::enable_shared_from_this<Impl>
    {
    }
 
+   /**
+    * @brief Starts an output stream once the job source has created it, unless its request was canceled meanwhile.
+    *
+    * @param in_requestId       The ID of the request for which the stream was created.
+    * @param in_job             The job for which the stream was created.
+    * @param in_error           The error which occurred while creating the stream, if any.
+    * @param in_outputStream    The output stream, if no error occurred.
+    */
+   void onStreamCreated(
+      uint64_t in_requestId,
+      const JobPtr& in_job,
+      const Error& in_error,
+      const OutputStreamPtr& in_outputStream)
+   {
+      UNIQUE_LOCK_MUTEX(Mutex)
+      {
+         if (PendingOutputStreams.erase(in_requestId) == 0)
+            return;
+
+         if (in_error || !in_outputStream)
+            return sendJobOutputNotFoundError(in_requestId, in_error);
+
+         // Lock the job while we start the stream.
+         LOCK_JOB(in_job)
+         {
+            startStream(in_requestId, in_job, in_outputStream);
+         }
+         END_LOCK_JOB
+      }
+      END_LOCK_MUTEX
+   }
+
    /**
     * @brief Sends a job output stream completion response to the Launcher.
     *
@@ -278,6 +311,9 @@ struct OutputStreamManager::Impl : public std::enable_shared_from_this<Impl>
    /** The map of open output streams. */
    OutputStreamMap ActiveOutputStreams;
 
+   /** The IDs of the requests for which the job source is still creating an output stream. */
+   std::set<uint64_t> PendingOutputStreams;
+
    /** The job repository. */
    jobs::JobRepositoryPtr JobRepo;
 
@@ -312,12 +348,19 @@ void OutputStreamManager::handleStreamRequest(const std::shared_ptr<OutputStream
    const std::string& jobId = in_outputStreamRequest->getJobId();
    const system::User& jobUser = in_outputStreamRequest->getUser();
 
+   JobPtr job;
    UNIQUE_LOCK_MUTEX(m_impl->Mutex)
    {
       auto itr = m_impl->ActiveOutputStreams.find(requestId);
-      if (itr != m_impl->ActiveOutputStreams.end())
+      bool isPending = (m_impl->PendingOutputStreams.find(requestId) != m_impl->PendingOutputStreams.end());
+      if ((itr != m_impl->ActiveOutputStreams.end()) || isPending)
       {
-         if (isCancel)
+         if (isCancel && isPending)
+         {
+            // The stream is still being created. It will be discarded once it has been.
+            m_impl->PendingOutputStreams.erase(requestId);
+         }
+         else if (isCancel)
          {
             itr->second.Stream->stop();
             m_impl->ActiveOutputStreams.erase(itr);
@@ -333,49 +376,46 @@ void OutputStreamManager::handleStreamRequest(const std::shared_ptr<OutputStream
       }
       else if (!isCancel)
       {
-         JobPtr job = m_impl->JobRepo->getJob(jobId, jobUser);
+         job = m_impl->JobRepo->getJob(jobId, jobUser);
          if (!job)
             return m_impl->sendJobNotFoundError(requestId, jobId, jobUser);
 
-         // Lock the job while we create the stream.
-         LOCK_JOB(job)
-         {
-            OutputStreamPtr outputStream;
-            Impl::WeakThis weakThis = m_impl->weak_from_this();
-            Error error = m_impl->JobSource->createOutputStream(
-               in_outputStreamRequest->getStreamType(),
-               job,
-               [weakThis, requestId](
-                  const std::string& in_output,
-                  OutputType in_outputType,
-                  uint64_t in_sequenceId)
-               {
-                  if (Impl::SharedThis sharedThis = weakThis.lock())
-                     sharedThis->sendOutputResponse(requestId, in_sequenceId, in_output, in_outputType);
-               },
-               [weakThis, requestId](uint64_t in_sequenceId)
-               {
-                  if (Impl::SharedThis sharedThis = weakThis.lock())
-                     sharedThis->sendCompleteResponse(requestId, in_sequenceId);
-               },
-               [weakThis, requestId](const Error& in_error)
-               {
-                  if (Impl::SharedThis sharedThis = weakThis.lock())
-                     sharedThis->sendStreamErrorResponse(requestId, in_error);
-               },
-               outputStream);
-
-            if (error || !outputStream)
-               m_impl->sendJobOutputNotFoundError(requestId, error);
-            else
-            {
-               m_impl->startStream(requestId, job, outputStream);
-            }
-         }
-         END_LOCK_JOB
+         m_impl->PendingOutputStreams.insert(requestId);
       }
    }
    END_LOCK_MUTEX
+
+   if (!job)
+      return;
+
+   // Create the stream without holding the mutex, since the job source may finish creating it on this thread.
+   Impl::WeakThis weakThis = m_impl->weak_from_this();
+   m_impl->JobSource->createOutputStreamAsync(
+      in_outputStreamRequest->getStreamType(),
+      job,
+      [weakThis, requestId](
+         const std::string& in_output,
+         OutputType in_outputType,
+         uint64_t in_sequenceId)
+      {
+         if (Impl::SharedThis sharedThis = weakThis.lock())
+            sharedThis->sendOutputResponse(requestId, in_sequenceId, in_output, in_outputType);
+      },
+      [weakThis, requestId](uint64_t in_sequenceId)
+      {
+         if (Impl::SharedThis sharedThis = weakThis.lock())
+            sharedThis->sendCompleteResponse(requestId, in_sequenceId);
+      },
+      [weakThis, requestId](const Error& in_error)
+      {
+         if (Impl::SharedThis sharedThis = weakThis.lock())
+            sharedThis->sendStreamErrorResponse(requestId, in_error);
+      },
+      [weakThis, requestId, job](const Error& in_error, OutputStreamPtr in_outputStream)
+      {
+         if (Impl::SharedThis sharedThis = weakThis.lock())
+            sharedThis->onStreamCreated(requestId, job, in_error, in_outputStream);
+      });
 }
 
 }
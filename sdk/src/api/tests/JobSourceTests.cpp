@@ -0,0 +1,239 @@
+/*
+ * JobSourceTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <TestMain.hpp>
+
+#include <api/IJobSource.hpp>
+#include <system/User.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace api {
+
+namespace {
+
+/**
+ * @brief Job source which only implements the synchronous interface.
+ */
+class SyncJobSource : public IJobSource
+{
+public:
+   SyncJobSource() :
+      IJobSource(nullptr, nullptr)
+   {
+   }
+
+   Error initialize() override
+   {
+      return Success();
+   }
+
+   bool cancelJob(JobPtr, bool&, std::string&) override
+   {
+      return false;
+   }
+
+   Error getConfiguration(const system::User&, JobSourceConfiguration& out_configuration) const override
+   {
+      out_configuration.Queues.insert("default");
+      return Success();
+   }
+
+   Error getNetworkInfo(JobPtr in_job, NetworkInfo& out_networkInfo) const override
+   {
+      if (in_job->Host.empty())
+         return systemError(ENOENT, ERROR_LOCATION);
+
+      out_networkInfo.Hostname = in_job->Host;
+      return Success();
+   }
+
+   bool killJob(JobPtr in_job, bool& out_isComplete, std::string& out_statusMessage) override
+   {
+      in_job->Status = Job::State::KILLED;
+      out_isComplete = true;
+      out_statusMessage = "Killed";
+      return true;
+   }
+
+   bool resumeJob(JobPtr, bool&, std::string&) override
+   {
+      return false;
+   }
+
+   bool stopJob(JobPtr, bool&, std::string&) override
+   {
+      return false;
+   }
+
+   bool suspendJob(JobPtr, bool&, std::string&) override
+   {
+      return false;
+   }
+
+   Error submitJob(JobPtr io_job, bool& out_wasInvalidRequest) const override
+   {
+      if (io_job->Command.empty())
+      {
+         out_wasInvalidRequest = true;
+         return systemError(EINVAL, ERROR_LOCATION);
+      }
+
+      io_job->Id = "1";
+      io_job->Status = Job::State::PENDING;
+      return Success();
+   }
+
+   Error createOutputStream(
+      OutputType,
+      JobPtr,
+      AbstractOutputStream::OnOutput,
+      AbstractOutputStream::OnComplete,
+      AbstractOutputStream::OnError,
+      OutputStreamPtr&) override
+   {
+      return systemError(ENOENT, ERROR_LOCATION);
+   }
+
+   Error createResourceStream(
+      ConstJobPtr,
+      comms::AbstractLauncherCommunicatorPtr,
+      AbstractResourceStreamPtr&) override
+   {
+      return Success();
+   }
+};
+
+} // anonymous namespace
+
+TEST_CASE("Asynchronous operations adapt synchronous job sources")
+{
+   SyncJobSource jobSource;
+   JobPtr job(new Job());
+
+   SECTION("Submit job")
+   {
+      bool isInvoked = false;
+      jobSource.submitJobAsync(job, [&](const Error& in_error, bool in_wasInvalidRequest)
+      {
+         isInvoked = true;
+         CHECK(in_error);
+         CHECK(in_wasInvalidRequest);
+      });
+      CHECK(isInvoked);
+
+      job->Command = "echo";
+      isInvoked = false;
+      jobSource.submitJobAsync(job, [&](const Error& in_error, bool in_wasInvalidRequest)
+      {
+         isInvoked = true;
+         CHECK_FALSE(in_error);
+         CHECK_FALSE(in_wasInvalidRequest);
+      });
+      CHECK(isInvoked);
+      CHECK(job->Id == "1");
+   }
+
+   SECTION("Control job")
+   {
+      job->Status = Job::State::RUNNING;
+      bool isInvoked = false;
+      jobSource.killJobAsync(job, [&](ControlJobResult in_result, const std::string& in_message)
+      {
+         isInvoked = true;
+         CHECK(in_result == ControlJobResult::COMPLETE);
+         CHECK(in_message == "Killed");
+      });
+      CHECK(isInvoked);
+      CHECK(job->Status == Job::State::KILLED);
+
+      // The job is no longer running, so it isn't killed again.
+      job->Status = Job::State::FINISHED;
+      isInvoked = false;
+      jobSource.killJobAsync(job, [&](ControlJobResult in_result, const std::string& in_message)
+      {
+         isInvoked = true;
+         CHECK(in_result == ControlJobResult::INVALID_STATE);
+         CHECK(in_message.empty());
+      });
+      CHECK(isInvoked);
+      CHECK(job->Status == Job::State::FINISHED);
+
+      job->Status = Job::State::RUNNING;
+      isInvoked = false;
+      jobSource.suspendJobAsync(job, [&](ControlJobResult in_result, const std::string& in_message)
+      {
+         isInvoked = true;
+         CHECK(in_result == ControlJobResult::NOT_SUPPORTED);
+         CHECK(in_message.empty());
+      });
+      CHECK(isInvoked);
+   }
+
+   SECTION("Network info and configuration")
+   {
+      job->Host = "host1";
+      bool isInvoked = false;
+      jobSource.getNetworkInfoAsync(job, [&](const Error& in_error, const NetworkInfo& in_networkInfo)
+      {
+         isInvoked = true;
+         CHECK_FALSE(in_error);
+         CHECK(in_networkInfo.Hostname == "host1");
+      });
+      CHECK(isInvoked);
+
+      isInvoked = false;
+      jobSource.getConfigurationAsync(
+         system::User(),
+         [&](const Error& in_error, const JobSourceConfiguration& in_configuration)
+         {
+            isInvoked = true;
+            CHECK_FALSE(in_error);
+            CHECK(in_configuration.Queues.count("default") == 1);
+         });
+      CHECK(isInvoked);
+   }
+
+   SECTION("Output stream")
+   {
+      bool isInvoked = false;
+      jobSource.createOutputStreamAsync(
+         OutputType::BOTH,
+         job,
+         [](const std::string&, OutputType, uint64_t) { },
+         [](uint64_t) { },
+         [](const Error&) { },
+         [&](const Error& in_error, OutputStreamPtr in_outputStream)
+         {
+            isInvoked = true;
+            CHECK(in_error);
+            CHECK(in_outputStream == nullptr);
+         });
+      CHECK(isInvoked);
+   }
+}
+
+} // namespace api
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -0,0 +1,162 @@
+/*
+ * JobStatusStreamTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <TestMain.hpp>
+
+#include <map>
+#include <vector>
+
+#include <Error.hpp>
+#include <comms/AbstractLauncherCommunicator.hpp>
+#include <jobs/AbstractJobRepository.hpp>
+#include <json/Json.hpp>
+#include <system/User.hpp>
+
+#include "../Constants.hpp"
+#include "../stream/JobStatusStream.hpp"
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace api {
+
+namespace {
+
+/** The sequence IDs sent to a request, by job ID. */
+typedef std::map<std::string, std::vector<uint64_t> > JobSequences;
+
+/** The responses sent to each request. */
+typedef std::map<uint64_t, JobSequences> RequestResponses;
+
+class MockCommunicator : public comms::AbstractLauncherCommunicator
+{
+public:
+   MockCommunicator() :
+      AbstractLauncherCommunicator(5242880, [](const Error& in_error) { logging::logError(in_error); })
+   {
+   }
+
+   RequestResponses Responses;
+
+private:
+   void writeResponse(const std::string& in_responseMessage) override
+   {
+      // Skip the message size header.
+      json::Object response;
+      REQUIRE_FALSE(response.parse(in_responseMessage.substr(4)));
+
+      std::string jobId = response[FIELD_ID].getString();
+      json::Array sequences = response[FIELD_SEQUENCES].getArray();
+      for (size_t i = 0, n = sequences.getSize(); i < n; ++i)
+      {
+         json::Object sequence = sequences[i].getObject();
+         Responses[sequence[FIELD_REQUEST_ID].getUInt64()][jobId].push_back(sequence[FIELD_SEQUENCE_ID].getUInt64());
+      }
+   }
+};
+
+class MockJobRepo : public jobs::AbstractJobRepository
+{
+public:
+   explicit MockJobRepo(const jobs::JobStatusNotifierPtr& in_notifier) :
+      AbstractJobRepository(in_notifier)
+   {
+   }
+
+private:
+   Error loadJobs(JobList&) const override
+   {
+      return Success();
+   }
+};
+
+JobPtr makeJob(const std::string& in_id, const system::User& in_user)
+{
+   JobPtr job(new Job());
+   job->Id = in_id;
+   job->User = in_user;
+   job->Status = Job::State::PENDING;
+   return job;
+}
+
+} // anonymous namespace
+
+TEST_CASE("All job status stream")
+{
+   system::User user1, user2, allUsers;
+   REQUIRE_FALSE(system::User::getUserFromIdentifier(USER_ONE, user1));
+   REQUIRE_FALSE(system::User::getUserFromIdentifier(USER_TWO, user2));
+
+   jobs::JobStatusNotifierPtr notifier(new jobs::JobStatusNotifier());
+   std::shared_ptr<MockJobRepo> repo(new MockJobRepo(notifier));
+   std::shared_ptr<MockCommunicator> comms(new MockCommunicator());
+
+   JobPtr job1 = makeJob("1", user1), job2 = makeJob("2", user1), job3 = makeJob("3", user2);
+   repo->addJob(job1);
+   repo->addJob(job2);
+   repo->addJob(job3);
+
+   std::shared_ptr<AllJobStatusStream> stream(new AllJobStatusStream(repo, notifier, comms));
+   REQUIRE_FALSE(stream->initialize());
+
+   stream->addRequest(11, user1);
+   stream->addRequest(12, user2);
+   stream->addRequest(13, allUsers);
+
+   // Each request is sent the current state of the jobs it may see.
+   CHECK(comms->Responses[11] == JobSequences({ { "1", { 1 } }, { "2", { 2 } } }));
+   CHECK(comms->Responses[12] == JobSequences({ { "3", { 1 } } }));
+   CHECK(comms->Responses[13] == JobSequences({ { "1", { 1 } }, { "2", { 2 } }, { "3", { 3 } } }));
+
+   SECTION("Updates are only sent to permitted requests")
+   {
+      comms->Responses.clear();
+      notifier->updateJob(job1, Job::State::RUNNING);
+      notifier->updateJob(job3, Job::State::RUNNING);
+
+      CHECK(comms->Responses[11] == JobSequences({ { "1", { 3 } } }));
+      CHECK(comms->Responses[12] == JobSequences({ { "3", { 2 } } }));
+      CHECK(comms->Responses[13] == JobSequences({ { "1", { 4 } }, { "3", { 5 } } }));
+   }
+
+   SECTION("Removed requests are not sent updates")
+   {
+      stream->removeRequest(11);
+      stream->removeRequest(13);
+      CHECK_FALSE(stream->isEmpty());
+
+      comms->Responses.clear();
+      notifier->updateJob(job1, Job::State::RUNNING);
+      notifier->updateJob(job3, Job::State::RUNNING);
+
+      CHECK(comms->Responses.count(11) == 0);
+      CHECK(comms->Responses.count(13) == 0);
+      CHECK(comms->Responses[12] == JobSequences({ { "3", { 2 } } }));
+
+      stream->removeRequest(12);
+      CHECK(stream->isEmpty());
+   }
+}
+
+} // namespace api
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -2232,6 +2232,49 @@ TEST_CASE("Matches tags")
    }
 }
 
+TEST_CASE("Interned job fields")
+{
+   size_t startCount = utils::InternedString::getInternedCount();
+
+   {
+      json::Object jobObj;
+      jobObj["command"] = "run-tests";
+      jobObj["name"] = "Interned Job";
+      jobObj["user"] = USER_ONE;
+      jobObj["host"] = "interned-test-host";
+      jobObj["cluster"] = "interned-test-cluster";
+      jobObj["queues"] = json::toJsonArray(std::vector<std::string>{ "interned-queue-1", "interned-queue-2" });
+      jobObj["tags"] = json::toJsonArray(std::vector<std::string>{ "interned-tag" });
+
+      Job job1, job2;
+      REQUIRE_FALSE(Job::fromJson(jobObj, job1));
+      REQUIRE_FALSE(Job::fromJson(jobObj, job2));
+
+      // Repeated values are stored once.
+      CHECK(job1.Host == job2.Host);
+      CHECK(job1.Host.c_str() == job2.Host.c_str());
+      CHECK(job1.Cluster.c_str() == job2.Cluster.c_str());
+      CHECK(job1.Queues.begin()->c_str() == job2.Queues.begin()->c_str());
+      CHECK(job1.Tags.begin()->c_str() == job2.Tags.begin()->c_str());
+      CHECK(&job1.User.getUsername() == &job2.User.getUsername());
+      CHECK(job1.User == job2.User);
+      CHECK(utils::InternedString::getInternedCount() == startCount + 5);
+
+      // Assigned values share the parsed values.
+      Job job3;
+      job3.Host = std::string("interned-test-host");
+      CHECK(job3.Host == job1.Host);
+      CHECK(job3.Host.c_str() == job1.Host.c_str());
+      CHECK(job3.Host != job1.Cluster);
+      CHECK(job1.Host == "interned-test-host");
+      CHECK(job1.Queues.count("interned-queue-2") == 1);
+      CHECK(job1.toJson()["host"].getString() == "interned-test-host");
+   }
+
+   // Values are released with the last job which refers to them.
+   CHECK(utils::InternedString::getInternedCount() == startCount);
+}
+
 } // namespace api
 } // namespace launcher_plugins
 } // namespace rstudio
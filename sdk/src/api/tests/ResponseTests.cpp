@@ -620,6 +620,49 @@ TEST_CASE("ResourceUtilStream Response")
    }
 }
 
+TEST_CASE("Write Output Stream Response")
+{
+   // Output with bytes which must be escaped at every offset within and across 16 and 32 byte blocks.
+   std::vector<std::string> outputs;
+   std::string allBytes;
+   for (int i = 1; i < 256; ++i)
+      allBytes.push_back(static_cast<char>(i));
+   outputs.push_back(allBytes);
+
+   for (size_t length: { 1, 15, 16, 17, 31, 32, 33, 64, 100 })
+   {
+      for (size_t pos = 0; pos < length; ++pos)
+      {
+         for (char escaped: { '"', '\\', '\n', '\x01', '\x1f' })
+         {
+            std::string output(length, 'a');
+            output[pos] = escaped;
+            outputs.push_back(output);
+         }
+      }
+   }
+
+   outputs.push_back(std::string(1000, 'x') + "\"quoted\"\r\n" + std::string(1000, '\t') + "\xc3\xa9\x7f");
+
+   for (const std::string& output: outputs)
+   {
+      OutputStreamResponse response(76, 3, output, OutputType::STDOUT);
+      std::string written = response.write();
+
+      // The output is escaped exactly as the JSON writer would escape it.
+      std::string expectedOutput = ",\"" + std::string(FIELD_OUTPUT) + "\":" + json::Value(output).write() + "}";
+      REQUIRE(written.size() > expectedOutput.size());
+      CHECK(written.substr(written.size() - expectedOutput.size()) == expectedOutput);
+
+      json::Object parsed;
+      REQUIRE_FALSE(parsed.parse(written));
+      CHECK(parsed == response.toJson());
+   }
+
+   OutputStreamResponse complete(76, 4);
+   CHECK(complete.write() == complete.toJson().write());
+}
+
 } // namespace api
 } // namespace launcher_plugins
 } // namespace rstudio
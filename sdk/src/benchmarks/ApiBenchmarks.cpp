@@ -0,0 +1,254 @@
+/*
+ * ApiBenchmarks.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <Benchmark.hpp>
+
+#include <iostream>
+
+#include <Error.hpp>
+#include <api/Constants.hpp>
+#include <api/Job.hpp>
+#include <api/Request.hpp>
+#include <api/Response.hpp>
+#include <system/User.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace benchmarks {
+
+namespace {
+
+api::JobPtr makeJob(size_t in_index, const system::User& in_user)
+{
+   api::JobPtr job(new api::Job());
+   job->Id = "job-" + std::to_string(in_index);
+   job->Name = "Benchmark Job " + std::to_string(in_index);
+   job->User = in_user;
+   job->Command = "echo";
+   job->Arguments = { "-e", "Hello, world!" };
+   job->Environment = { { "ENV_VAR", "value" }, { "OTHER_VAR", "other value" } };
+   job->Host = "localhost";
+   job->Pid = 1000 + static_cast<pid_t>(in_index);
+   job->Status = api::Job::State::RUNNING;
+   job->StatusMessage = "Running";
+   job->LastUpdateTime = system::DateTime();
+   job->Tags = { "benchmark", "tag " + std::to_string(in_index % 10) };
+   job->WorkingDirectory = "/home/" + in_user.getUsername();
+   job->StandardOutFile = job->WorkingDirectory + "/" + job->Id + ".stdout";
+   job->StandardErrFile = job->WorkingDirectory + "/" + job->Id + ".stderr";
+
+   api::ResourceLimit limit(api::ResourceLimit::Type::MEMORY);
+   limit.Value = "250";
+   job->ResourceLimits.push_back(limit);
+
+   return job;
+}
+
+json::Object makeUserRequest(api::Request::Type in_type, const system::User& in_user)
+{
+   json::Object request;
+   request[api::FIELD_MESSAGE_TYPE] = static_cast<int>(in_type);
+   request[api::FIELD_REQUEST_ID] = 42;
+   request[api::FIELD_REAL_USER] = in_user.getUsername();
+   request[api::FIELD_REQUEST_USERNAME] = in_user.getUsername();
+   return request;
+}
+
+json::Object makeJobRequest(api::Request::Type in_type, const system::User& in_user)
+{
+   json::Object request = makeUserRequest(in_type, in_user);
+   request[api::FIELD_JOB_ID] = "job-1";
+   request[api::FIELD_ENCODED_JOB_ID] = "";
+   return request;
+}
+
+std::vector<std::pair<std::string, json::Object> > makeRequests(const system::User& in_user)
+{
+   std::vector<std::pair<std::string, json::Object> > requests;
+
+   json::Object heartbeat;
+   heartbeat[api::FIELD_MESSAGE_TYPE] = static_cast<int>(api::Request::Type::HEARTBEAT);
+   heartbeat[api::FIELD_REQUEST_ID] = 0;
+   requests.emplace_back("heartbeat", heartbeat);
+
+   json::Object version;
+   version[api::FIELD_VERSION_MAJOR] = api::API_VERSION_MAJOR;
+   version[api::FIELD_VERSION_MINOR] = api::API_VERSION_MINOR;
+   version[api::FIELD_VERSION_PATCH] = api::API_VERSION_PATCH;
+   json::Object bootstrap;
+   bootstrap[api::FIELD_MESSAGE_TYPE] = static_cast<int>(api::Request::Type::BOOTSTRAP);
+   bootstrap[api::FIELD_REQUEST_ID] = 0;
+   bootstrap[api::FIELD_VERSION] = version;
+   requests.emplace_back("bootstrap", bootstrap);
+
+   json::Object submit = makeUserRequest(api::Request::Type::SUBMIT_JOB, in_user);
+   submit[api::FIELD_JOB] = makeJob(1, in_user)->toJson();
+   requests.emplace_back("submit_job", submit);
+
+   json::Object getJob = makeJobRequest(api::Request::Type::GET_JOB, in_user);
+   getJob[api::FIELD_JOB_ID] = "*";
+   getJob[api::FIELD_JOB_TAGS] = json::toJsonArray(std::vector<std::string>{ "benchmark" });
+   requests.emplace_back("get_job", getJob);
+
+   json::Object getJobStatus = makeJobRequest(api::Request::Type::GET_JOB_STATUS, in_user);
+   getJobStatus[api::FIELD_CANCEL_STREAM] = false;
+   requests.emplace_back("get_job_status", getJobStatus);
+
+   json::Object controlJob = makeJobRequest(api::Request::Type::CONTROL_JOB, in_user);
+   controlJob[api::FIELD_OPERATION] = static_cast<int>(api::ControlJobRequest::Operation::CANCEL);
+   requests.emplace_back("control_job", controlJob);
+
+   json::Object getJobOutput = makeJobRequest(api::Request::Type::GET_JOB_OUTPUT, in_user);
+   getJobOutput[api::FIELD_OUTPUT_TYPE] = static_cast<int>(api::OutputType::BOTH);
+   getJobOutput[api::FIELD_CANCEL_STREAM] = false;
+   requests.emplace_back("get_job_output", getJobOutput);
+
+   json::Object getJobResourceUtil = makeJobRequest(api::Request::Type::GET_JOB_RESOURCE_UTIL, in_user);
+   getJobResourceUtil[api::FIELD_CANCEL_STREAM] = false;
+   requests.emplace_back("get_job_resource_util", getJobResourceUtil);
+
+   requests.emplace_back("get_job_network", makeJobRequest(api::Request::Type::GET_JOB_NETWORK, in_user));
+   requests.emplace_back("get_cluster_info", makeUserRequest(api::Request::Type::GET_CLUSTER_INFO, in_user));
+
+   return requests;
+}
+
+} // anonymous namespace
+
+void addApiBenchmarks(BenchmarkRunner& io_runner)
+{
+   system::User user;
+   Error error = system::User::getCurrentUser(user);
+   if (error)
+   {
+      std::cerr << "Skipping api benchmarks: " << error.asString() << std::endl;
+      return;
+   }
+
+   // JSON
+   std::shared_ptr<json::Object> jobJson = std::make_shared<json::Object>(makeJob(1, user)->toJson());
+   std::shared_ptr<std::string> jobJsonStr = std::make_shared<std::string>(jobJson->write());
+   io_runner.add(
+      "json/Object/parse",
+      [jobJsonStr](BenchmarkState& io_state)
+      {
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+         {
+            json::Object object;
+            doNotOptimize(object.parse(*jobJsonStr));
+            doNotOptimize(object);
+         }
+      },
+      jobJsonStr->size());
+
+   io_runner.add(
+      "json/Object/write",
+      [jobJson](BenchmarkState& io_state)
+      {
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            doNotOptimize(jobJson->write());
+      },
+      jobJsonStr->size());
+
+   // Requests
+   for (const auto& request: makeRequests(user))
+   {
+      json::Object requestJson = request.second;
+      io_runner.add(
+         "api/Request/fromJson/" + request.first,
+         [requestJson](BenchmarkState& io_state)
+         {
+            for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            {
+               std::shared_ptr<api::Request> parsed;
+               doNotOptimize(api::Request::fromJson(requestJson, parsed));
+               doNotOptimize(parsed);
+            }
+         });
+   }
+
+   // Jobs
+   api::JobPtr job = makeJob(1, user);
+   io_runner.add(
+      "api/Job/toJson",
+      [job](BenchmarkState& io_state)
+      {
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            doNotOptimize(job->toJson());
+      });
+
+   io_runner.add(
+      "api/Job/fromJson",
+      [jobJson](BenchmarkState& io_state)
+      {
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+         {
+            api::Job parsed;
+            doNotOptimize(api::Job::fromJson(*jobJson, parsed));
+            doNotOptimize(parsed);
+         }
+      });
+
+   // Job state responses, including serialization, as they are sent to the Launcher.
+   for (size_t jobCount: { 1, 100, 1000 })
+   {
+      api::JobList jobs;
+      for (size_t i = 0; i < jobCount; ++i)
+         jobs.push_back(makeJob(i, user));
+
+      io_runner.add(
+         "api/JobStateResponse/jobs:" + std::to_string(jobCount),
+         [jobs](BenchmarkState& io_state)
+         {
+            for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+               doNotOptimize(api::JobStateResponse(42, jobs).toJson().write());
+         });
+   }
+
+   // Job output responses, as they are sent to the Launcher. Log-like output with a newline every 80 bytes.
+   std::shared_ptr<std::string> output = std::make_shared<std::string>();
+   while (output->size() < 64 * 1024)
+      output->append(std::string(79, 'x')).push_back('\n');
+
+   io_runner.add(
+      "api/OutputStreamResponse/write/bytes:" + std::to_string(output->size()),
+      [output](BenchmarkState& io_state)
+      {
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            doNotOptimize(api::OutputStreamResponse(42, i, *output, api::OutputType::STDOUT).write());
+      },
+      output->size());
+
+   io_runner.add(
+      "api/OutputStreamResponse/toJson/bytes:" + std::to_string(output->size()),
+      [output](BenchmarkState& io_state)
+      {
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            doNotOptimize(api::OutputStreamResponse(42, i, *output, api::OutputType::STDOUT).toJson().write());
+      },
+      output->size());
+}
+
+} // namespace benchmarks
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -0,0 +1,170 @@
+/*
+ * Benchmark.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <Benchmark.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include <system/DateTime.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace benchmarks {
+
+namespace {
+
+/** The maximum number of iterations a single repetition may run. */
+constexpr uint64_t s_maxIterations = 1000000000;
+
+std::chrono::nanoseconds runOnce(const BenchmarkFunction& in_function, uint64_t in_iterations)
+{
+   BenchmarkState state(in_iterations);
+   state.startTimer();
+   in_function(state);
+   state.stopTimer();
+   return state.getElapsed();
+}
+
+} // anonymous namespace
+
+BenchmarkState::BenchmarkState(uint64_t in_iterations) :
+   m_iterations(in_iterations),
+   m_isRunning(false),
+   m_elapsed(0)
+{
+}
+
+uint64_t BenchmarkState::getIterations() const
+{
+   return m_iterations;
+}
+
+std::chrono::nanoseconds BenchmarkState::getElapsed() const
+{
+   return m_elapsed;
+}
+
+void BenchmarkState::startTimer()
+{
+   if (!m_isRunning)
+   {
+      m_isRunning = true;
+      m_startTime = std::chrono::steady_clock::now();
+   }
+}
+
+void BenchmarkState::stopTimer()
+{
+   if (m_isRunning)
+   {
+      m_elapsed += std::chrono::steady_clock::now() - m_startTime;
+      m_isRunning = false;
+   }
+}
+
+BenchmarkRunner::BenchmarkRunner(
+   std::string in_filter,
+   std::chrono::nanoseconds in_minTime,
+   unsigned int in_repetitions) :
+      m_filter(std::move(in_filter)),
+      m_minTime(in_minTime),
+      m_repetitions(std::max(1u, in_repetitions))
+{
+}
+
+void BenchmarkRunner::add(const std::string& in_name, const BenchmarkFunction& in_function, uint64_t in_bytesPerIteration)
+{
+   m_benchmarks.push_back(Benchmark{ in_name, in_function, in_bytesPerIteration });
+}
+
+json::Object BenchmarkRunner::run() const
+{
+   json::Array results;
+   for (const Benchmark& benchmark: m_benchmarks)
+   {
+      if (!m_filter.empty() && (benchmark.Name.find(m_filter) == std::string::npos))
+         continue;
+
+      // Find the number of iterations which takes at least the minimum time.
+      uint64_t iterations = 1;
+      std::chrono::nanoseconds elapsed = runOnce(benchmark.Function, iterations);
+      while ((elapsed < m_minTime) && (iterations < s_maxIterations))
+      {
+         double scale = (elapsed.count() > 0) ? 1.4 * m_minTime.count() / elapsed.count() : 10.0;
+         iterations = std::min(
+            s_maxIterations,
+            std::max(iterations + 1, static_cast<uint64_t>(iterations * std::min(scale, 10.0))));
+         elapsed = runOnce(benchmark.Function, iterations);
+      }
+
+      std::vector<double> nsPerOp;
+      for (unsigned int i = 0; i < m_repetitions; ++i)
+         nsPerOp.push_back(static_cast<double>(runOnce(benchmark.Function, iterations).count()) / iterations);
+
+      std::sort(nsPerOp.begin(), nsPerOp.end());
+      double mean = 0;
+      for (double value: nsPerOp)
+         mean += value / nsPerOp.size();
+
+      double median = nsPerOp[nsPerOp.size() / 2];
+      json::Object result;
+      result["name"] = benchmark.Name;
+      result["iterations"] = iterations;
+      result["repetitions"] = m_repetitions;
+      result["nsPerOpMin"] = nsPerOp.front();
+      result["nsPerOpMedian"] = median;
+      result["nsPerOpMean"] = mean;
+      result["nsPerOpMax"] = nsPerOp.back();
+      if (benchmark.BytesPerIteration > 0)
+         result["bytesPerSecond"] = benchmark.BytesPerIteration * 1e9 / median;
+
+      std::cerr << std::left << std::setw(64) << benchmark.Name
+                << std::right << std::fixed << std::setprecision(1) << std::setw(14) << median << " ns/op"
+                << std::setw(12) << iterations << " iterations" << std::endl;
+
+      results.push_back(result);
+   }
+
+   char hostname[256] = { 0 };
+   ::gethostname(hostname, sizeof(hostname) - 1);
+
+   json::Object context;
+   context["date"] = system::DateTime().toString();
+   context["host"] = std::string(hostname);
+   context["cpus"] = std::thread::hardware_concurrency();
+   context["minTimeNs"] = static_cast<uint64_t>(m_minTime.count());
+
+   json::Object output;
+   output["context"] = context;
+   output["benchmarks"] = results;
+   return output;
+}
+
+} // namespace benchmarks
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -0,0 +1,179 @@
+/*
+ * Benchmark.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_BENCHMARK_HPP
+#define LAUNCHER_PLUGINS_BENCHMARK_HPP
+
+#include <Noncopyable.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <json/Json.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace benchmarks {
+
+/**
+ * @brief Prevents the compiler from optimizing away the computation of a value.
+ *
+ * @param in_value      The value which must be computed.
+ */
+template <typename T>
+inline void doNotOptimize(const T& in_value)
+{
+   asm volatile("" : : "r,m"(in_value) : "memory");
+}
+
+/**
+ * @brief The state of a single run of a benchmark.
+ */
+class BenchmarkState final : public Noncopyable
+{
+public:
+   /**
+    * @brief Constructor.
+    *
+    * @param in_iterations      The number of iterations the benchmark should run.
+    */
+   explicit BenchmarkState(uint64_t in_iterations);
+
+   /**
+    * @brief Gets the number of iterations the benchmark should run.
+    *
+    * @return The number of iterations the benchmark should run.
+    */
+   uint64_t getIterations() const;
+
+   /**
+    * @brief Gets the total amount of time which has been measured.
+    *
+    * @return The total amount of time which has been measured.
+    */
+   std::chrono::nanoseconds getElapsed() const;
+
+   /**
+    * @brief Resumes measuring time. The timer is started before the benchmark is invoked.
+    */
+   void startTimer();
+
+   /**
+    * @brief Stops measuring time, e.g. while setting up or tearing down state which shouldn't be measured. The timer is
+    *        stopped after the benchmark returns, if it is still running.
+    */
+   void stopTimer();
+
+private:
+   uint64_t m_iterations;
+   bool m_isRunning;
+   std::chrono::steady_clock::time_point m_startTime;
+   std::chrono::nanoseconds m_elapsed;
+};
+
+/**
+ * @brief A benchmark function. It should perform the measured operation BenchmarkState::getIterations() times.
+ */
+typedef std::function<void(BenchmarkState&)> BenchmarkFunction;
+
+/**
+ * @brief Runs benchmarks and collects their results as JSON.
+ */
+class BenchmarkRunner final : public Noncopyable
+{
+public:
+   /**
+    * @brief Constructor.
+    *
+    * @param in_filter          Only benchmarks whose names contain this string will be run. Empty to run all.
+    * @param in_minTime         The minimum amount of time each repetition of a benchmark should run.
+    * @param in_repetitions     The number of times each benchmark should be repeated.
+    */
+   BenchmarkRunner(std::string in_filter, std::chrono::nanoseconds in_minTime, unsigned int in_repetitions);
+
+   /**
+    * @brief Adds a benchmark.
+    *
+    * @param in_name                The name of the benchmark, e.g. "comms/MessageHandler/processBytes/chunk:64".
+    * @param in_function            The benchmark function.
+    * @param in_bytesPerIteration   The number of bytes processed by each iteration, if throughput should be reported.
+    */
+   void add(const std::string& in_name, const BenchmarkFunction& in_function, uint64_t in_bytesPerIteration = 0);
+
+   /**
+    * @brief Runs every benchmark which matches the filter and prints a summary of each to stderr.
+    *
+    * @return The results of each benchmark.
+    */
+   json::Object run() const;
+
+private:
+   struct Benchmark
+   {
+      std::string Name;
+      BenchmarkFunction Function;
+      uint64_t BytesPerIteration;
+   };
+
+   std::string m_filter;
+   std::chrono::nanoseconds m_minTime;
+   unsigned int m_repetitions;
+   std::vector<Benchmark> m_benchmarks;
+};
+
+/**
+ * @brief Adds the benchmarks of the api and json code.
+ *
+ * @param io_runner     The runner to which the benchmarks should be added.
+ */
+void addApiBenchmarks(BenchmarkRunner& io_runner);
+
+/**
+ * @brief Adds the benchmarks of the comms code.
+ *
+ * @param io_runner     The runner to which the benchmarks should be added.
+ */
+void addCommsBenchmarks(BenchmarkRunner& io_runner);
+
+/**
+ * @brief Adds the benchmarks of the jobs code.
+ *
+ * @param io_runner     The runner to which the benchmarks should be added.
+ */
+void addJobsBenchmarks(BenchmarkRunner& io_runner);
+
+/**
+ * @brief Adds the benchmarks of the system code.
+ *
+ * @param io_runner     The runner to which the benchmarks should be added.
+ */
+void addSystemBenchmarks(BenchmarkRunner& io_runner);
+
+} // namespace benchmarks
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
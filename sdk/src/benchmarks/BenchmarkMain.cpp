@@ -0,0 +1,93 @@
+/*
+ * BenchmarkMain.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <Benchmark.hpp>
+
+#include <iostream>
+
+#include <Error.hpp>
+#include <system/FilePath.hpp>
+#include <utils/FileUtils.hpp>
+
+using namespace rstudio::launcher_plugins;
+using namespace rstudio::launcher_plugins::benchmarks;
+
+/**
+ * @brief The main function.
+ *
+ * @param in_argc      The number of arguments supplied to the program.
+ * @param in_argv      The list of arguments supplied to the program.
+ *
+ * @return 0 on success; non-zero exit code otherwise.
+ */
+int main(int in_argc, char** in_argv)
+{
+   std::string filter, outputFile;
+   unsigned int minTimeMs = 200, repetitions = 5;
+   for (int i = 1; i < in_argc; ++i)
+   {
+      std::string arg = in_argv[i];
+      try
+      {
+         if (arg.compare(0, 9, "--filter=") == 0)
+            filter = arg.substr(9);
+         else if (arg.compare(0, 9, "--output=") == 0)
+            outputFile = arg.substr(9);
+         else if (arg.compare(0, 14, "--min-time-ms=") == 0)
+            minTimeMs = std::stoul(arg.substr(14));
+         else if (arg.compare(0, 14, "--repetitions=") == 0)
+            repetitions = std::stoul(arg.substr(14));
+         else
+            throw std::invalid_argument("unknown argument");
+      }
+      catch (const std::exception& e)
+      {
+         std::cerr << "Invalid argument (" << arg << "): " << e.what() << std::endl
+                   << "Usage: ./rlps-benchmarks [--filter=<substring>] [--output=<file.json>] [--min-time-ms=<ms>] "
+                   << "[--repetitions=<count>]" << std::endl;
+         return 1;
+      }
+   }
+
+   BenchmarkRunner runner(filter, std::chrono::milliseconds(minTimeMs), repetitions);
+   addApiBenchmarks(runner);
+   addCommsBenchmarks(runner);
+   addJobsBenchmarks(runner);
+   addSystemBenchmarks(runner);
+
+   std::string results = runner.run().writeFormatted();
+   if (outputFile.empty())
+   {
+      std::cout << results << std::endl;
+      return 0;
+   }
+
+   Error error = utils::writeStringToFile(results, system::FilePath(outputFile));
+   if (error)
+   {
+      std::cerr << "Could not write results: " << error.asString() << std::endl;
+      return 1;
+   }
+
+   return 0;
+}
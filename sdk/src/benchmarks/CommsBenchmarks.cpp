@@ -0,0 +1,102 @@
+/*
+ * CommsBenchmarks.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <Benchmark.hpp>
+
+#include <Error.hpp>
+#include <comms/MessageHandler.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace benchmarks {
+
+namespace {
+
+/** The number of messages in the framed input. */
+constexpr size_t s_messageCount = 64;
+
+std::string makeMessage(size_t in_index)
+{
+   // A representative request body of roughly 1 KiB.
+   std::string message = "{\"messageType\":2,\"requestId\":" + std::to_string(in_index) +
+      ",\"requestUsername\":\"rlpstestusrone\",\"username\":\"*\",\"job\":{\"command\":\"echo\",\"args\":[";
+   while (message.size() < 1000)
+      message += "\"argument " + std::to_string(message.size()) + "\",";
+   message += "\"end\"]}}";
+   return message;
+}
+
+} // anonymous namespace
+
+void addCommsBenchmarks(BenchmarkRunner& io_runner)
+{
+   std::shared_ptr<std::string> framedInput = std::make_shared<std::string>();
+   {
+      comms::MessageHandler formatter;
+      for (size_t i = 0; i < s_messageCount; ++i)
+         framedInput->append(formatter.formatMessage(makeMessage(i)));
+   }
+
+   for (size_t chunkSize: { 64, 512, 4096, 65536 })
+   {
+      io_runner.add(
+         "comms/MessageHandler/processBytes/chunk:" + std::to_string(chunkSize),
+         [framedInput, chunkSize](BenchmarkState& io_state)
+         {
+            comms::MessageHandler handler;
+            std::vector<std::string> messages;
+            messages.reserve(s_messageCount);
+
+            for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            {
+               messages.clear();
+               for (size_t offset = 0; offset < framedInput->size(); offset += chunkSize)
+               {
+                  Error error = handler.processBytes(
+                     framedInput->data() + offset,
+                     std::min(chunkSize, framedInput->size() - offset),
+                     messages);
+                  doNotOptimize(error);
+               }
+
+               doNotOptimize(messages);
+            }
+         },
+         framedInput->size());
+   }
+
+   std::shared_ptr<std::string> message = std::make_shared<std::string>(makeMessage(0));
+   io_runner.add(
+      "comms/MessageHandler/formatMessage",
+      [message](BenchmarkState& io_state)
+      {
+         comms::MessageHandler handler;
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            doNotOptimize(handler.formatMessage(*message));
+      },
+      message->size());
+}
+
+} // namespace benchmarks
+} // namespace launcher_plugins
+} // namespace rstudio
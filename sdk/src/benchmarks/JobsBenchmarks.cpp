@@ -0,0 +1,317 @@
+/*
+ * JobsBenchmarks.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <Benchmark.hpp>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+#include <Error.hpp>
+#include <jobs/AbstractJobRepository.hpp>
+#include <jobs/JobStatusNotifier.hpp>
+#include <system/User.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace benchmarks {
+
+namespace {
+
+class BenchmarkJobRepo : public jobs::AbstractJobRepository
+{
+public:
+   explicit BenchmarkJobRepo(const jobs::JobStatusNotifierPtr& in_notifier) :
+      AbstractJobRepository(in_notifier)
+   {
+   }
+
+private:
+   Error loadJobs(api::JobList&) const override
+   {
+      return Success();
+   }
+};
+
+/**
+ * @brief Threads which repeatedly read from, and optionally write to, a job repository until they are destroyed.
+ */
+class RepositoryContention
+{
+public:
+   RepositoryContention(
+      const std::shared_ptr<BenchmarkJobRepo>& in_repo,
+      const api::JobPtr& in_job,
+      size_t in_readers,
+      size_t in_writers) :
+         m_isStopped(false)
+   {
+      for (size_t i = 0; i < in_readers; ++i)
+         m_threads.emplace_back([this, in_repo]()
+         {
+            while (!m_isStopped.load(std::memory_order_relaxed))
+               doNotOptimize(in_repo->getJobs());
+         });
+
+      for (size_t i = 0; i < in_writers; ++i)
+         m_threads.emplace_back([this, in_repo, in_job]()
+         {
+            // Re-adding an existing job takes the write lock without changing the repository.
+            while (!m_isStopped.load(std::memory_order_relaxed))
+               in_repo->addJob(in_job);
+         });
+   }
+
+   ~RepositoryContention()
+   {
+      m_isStopped = true;
+      for (std::thread& thread: m_threads)
+         thread.join();
+   }
+
+private:
+   std::atomic_bool m_isStopped;
+   std::vector<std::thread> m_threads;
+};
+
+} // anonymous namespace
+
+void addJobsBenchmarks(BenchmarkRunner& io_runner)
+{
+   system::User user;
+   Error error = system::User::getCurrentUser(user);
+   if (error)
+   {
+      std::cerr << "Skipping jobs benchmarks: " << error.asString() << std::endl;
+      return;
+   }
+
+   // Repository reads, with and without other threads contending for the repository lock.
+   std::shared_ptr<BenchmarkJobRepo> repo(new BenchmarkJobRepo(std::make_shared<jobs::JobStatusNotifier>()));
+   for (size_t i = 0; i < 1000; ++i)
+   {
+      api::JobPtr job(new api::Job());
+      job->Id = "job-" + std::to_string(i);
+      job->User = user;
+      job->Status = api::Job::State::RUNNING;
+      repo->addJob(job);
+   }
+
+   api::JobPtr existingJob = repo->getJob("job-0");
+   const std::pair<size_t, size_t> contentionLevels[] = { { 0, 0 }, { 3, 0 }, { 3, 1 } };
+   for (const auto& contention: contentionLevels)
+   {
+      size_t readers = contention.first, writers = contention.second;
+      io_runner.add(
+         "jobs/AbstractJobRepository/getJobs/jobs:1000/readers:" + std::to_string(readers) +
+            "/writers:" + std::to_string(writers),
+         [repo, existingJob, user, readers, writers](BenchmarkState& io_state)
+         {
+            io_state.stopTimer();
+            RepositoryContention background(repo, existingJob, readers, writers);
+            io_state.startTimer();
+
+            for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+               doNotOptimize(repo->getJobs(user));
+
+            io_state.stopTimer();
+         });
+   }
+
+   // Status update fan out to all-jobs subscribers, such as job status streams.
+   for (size_t subscriberCount: { 1, 16, 256 })
+   {
+      io_runner.add(
+         "jobs/JobStatusNotifier/updateJob/subscribers:" + std::to_string(subscriberCount),
+         [subscriberCount](BenchmarkState& io_state)
+         {
+            io_state.stopTimer();
+            jobs::JobStatusNotifierPtr notifier = std::make_shared<jobs::JobStatusNotifier>();
+            std::shared_ptr<std::atomic_uint64_t> notifications = std::make_shared<std::atomic_uint64_t>(0);
+            std::vector<jobs::SubscriptionHandle> handles;
+            for (size_t i = 0; i < subscriberCount; ++i)
+               handles.push_back(notifier->subscribe([notifications](const api::JobPtr&) { ++*notifications; }));
+
+            api::JobPtr job(new api::Job());
+            job->Id = "job-1";
+            job->Status = api::Job::State::PENDING;
+            system::DateTime updateTime;
+            io_state.startTimer();
+
+            for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            {
+               // Clear the last update time so every update is considered new.
+               job->LastUpdateTime = Optional<system::DateTime>();
+               notifier->updateJob(
+                  job,
+                  (i % 2 == 0) ? api::Job::State::RUNNING : api::Job::State::SUSPENDED,
+                  "",
+                  updateTime);
+            }
+
+            doNotOptimize(notifications->load());
+            io_state.stopTimer();
+         });
+   }
+
+   // A poll which changes 5000 jobs, posted one job at a time or as a single batch, to an all-jobs stream.
+   constexpr size_t batchJobCount = 5000;
+   for (bool isBatch: { false, true })
+   {
+      io_runner.add(
+         std::string("jobs/JobStatusNotifier/") + (isBatch ? "updateJobs" : "updateJob") + "/jobs:" +
+            std::to_string(batchJobCount),
+         [isBatch](BenchmarkState& io_state)
+         {
+            io_state.stopTimer();
+            jobs::JobStatusNotifierPtr notifier = std::make_shared<jobs::JobStatusNotifier>();
+            std::shared_ptr<std::atomic_uint64_t> notifications = std::make_shared<std::atomic_uint64_t>(0);
+            jobs::SubscriptionHandle handle = notifier->subscribeBatch(
+               [notifications](const api::JobList& in_jobs) { *notifications += in_jobs.size(); });
+
+            api::JobList jobs;
+            for (size_t i = 0; i < batchJobCount; ++i)
+            {
+               api::JobPtr job(new api::Job());
+               job->Id = "job-" + std::to_string(i);
+               job->Status = api::Job::State::PENDING;
+               jobs.push_back(job);
+            }
+
+            system::DateTime updateTime;
+            io_state.startTimer();
+
+            for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            {
+               io_state.stopTimer();
+               api::Job::State status = (i % 2 == 0) ? api::Job::State::RUNNING : api::Job::State::SUSPENDED;
+               jobs::JobStatusUpdates updates;
+               for (const api::JobPtr& job: jobs)
+               {
+                  // Clear the last update time so every update is considered new.
+                  job->LastUpdateTime = Optional<system::DateTime>();
+                  updates.emplace_back(job->Id, status, "", updateTime);
+               }
+               io_state.startTimer();
+
+               if (isBatch)
+                  notifier->updateJobs(jobs, updates);
+               else
+               {
+                  for (const api::JobPtr& job: jobs)
+                     notifier->updateJob(job, status, "", updateTime);
+               }
+            }
+
+            doNotOptimize(notifications->load());
+            io_state.stopTimer();
+         });
+   }
+
+   // Per-job subscriptions, such as output and resource streams, with 10000 jobs subscribed to at once.
+   constexpr size_t jobSubscriptionCount = 10000;
+   io_runner.add(
+      "jobs/JobStatusNotifier/subscribe/jobs:" + std::to_string(jobSubscriptionCount),
+      [](BenchmarkState& io_state)
+      {
+         io_state.stopTimer();
+         jobs::JobStatusNotifierPtr notifier = std::make_shared<jobs::JobStatusNotifier>();
+         std::vector<std::string> jobIds;
+         for (size_t i = 0; i < jobSubscriptionCount; ++i)
+            jobIds.push_back("job-" + std::to_string(i));
+
+         std::vector<jobs::SubscriptionHandle> handles;
+         handles.reserve(jobSubscriptionCount);
+         io_state.startTimer();
+
+         // Each iteration subscribes to and then unsubscribes from every job.
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+         {
+            for (const std::string& jobId: jobIds)
+               handles.push_back(notifier->subscribe(jobId, [](const api::JobPtr&) { }));
+
+            handles.clear();
+         }
+
+         io_state.stopTimer();
+      });
+
+   for (size_t threadCount: { 1, 4 })
+   {
+      io_runner.add(
+         "jobs/JobStatusNotifier/updateJob/jobSubscriptions:" + std::to_string(jobSubscriptionCount) +
+            "/threads:" + std::to_string(threadCount),
+         [threadCount](BenchmarkState& io_state)
+         {
+            io_state.stopTimer();
+            jobs::JobStatusNotifierPtr notifier = std::make_shared<jobs::JobStatusNotifier>();
+            std::shared_ptr<std::atomic_uint64_t> notifications = std::make_shared<std::atomic_uint64_t>(0);
+
+            std::vector<api::JobPtr> jobs;
+            std::vector<jobs::SubscriptionHandle> handles;
+            for (size_t i = 0; i < jobSubscriptionCount; ++i)
+            {
+               api::JobPtr job(new api::Job());
+               job->Id = "job-" + std::to_string(i);
+               job->Status = api::Job::State::PENDING;
+               jobs.push_back(job);
+               handles.push_back(
+                  notifier->subscribe(job->Id, [notifications](const api::JobPtr&) { ++*notifications; }));
+            }
+
+            system::DateTime updateTime;
+            const uint64_t iterations = io_state.getIterations();
+            io_state.startTimer();
+
+            // The iterations are split between the threads.
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < threadCount; ++t)
+            {
+               threads.emplace_back([&, t]()
+               {
+                  for (uint64_t i = t; i < iterations; i += threadCount)
+                  {
+                     // The job count is a multiple of the thread count, so no two threads update the same job.
+                     const api::JobPtr& job = jobs[i % jobSubscriptionCount];
+                     job->LastUpdateTime = Optional<system::DateTime>();
+                     notifier->updateJob(
+                        job,
+                        (i % 2 == 0) ? api::Job::State::RUNNING : api::Job::State::SUSPENDED,
+                        "",
+                        updateTime);
+                  }
+               });
+            }
+
+            for (std::thread& thread: threads)
+               thread.join();
+
+            doNotOptimize(notifications->load());
+            io_state.stopTimer();
+         });
+   }
+}
+
+} // namespace benchmarks
+} // namespace launcher_plugins
+} // namespace rstudio
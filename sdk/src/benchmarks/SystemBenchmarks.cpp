@@ -0,0 +1,60 @@
+/*
+ * SystemBenchmarks.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <Benchmark.hpp>
+
+#include <Error.hpp>
+#include <system/DateTime.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace benchmarks {
+
+void addSystemBenchmarks(BenchmarkRunner& io_runner)
+{
+   io_runner.add(
+      "system/DateTime/toString",
+      [](BenchmarkState& io_state)
+      {
+         system::DateTime dateTime;
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+            doNotOptimize(dateTime.toString());
+      });
+
+   std::string dateTimeStr = system::DateTime().toString();
+   io_runner.add(
+      "system/DateTime/fromString",
+      [dateTimeStr](BenchmarkState& io_state)
+      {
+         for (uint64_t i = 0; i < io_state.getIterations(); ++i)
+         {
+            system::DateTime dateTime;
+            doNotOptimize(system::DateTime::fromString(dateTimeStr, dateTime));
+            doNotOptimize(dateTime);
+         }
+      });
+}
+
+} // namespace benchmarks
+} // namespace launcher_plugins
+} // namespace rstudio
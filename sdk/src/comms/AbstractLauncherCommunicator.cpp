@@ -23,16 +23,19 @@
 
 #include <comms/AbstractLauncherCommunicator.hpp>
 
+#include <chrono>
 #include <map>
 #include <sstream>
 
 #include <boost/system/error_code.hpp>
 
 #include <Error.hpp>
+#include <api/Constants.hpp>
 #include <api/Request.hpp>
 #include <api/Response.hpp>
 #include <logging/Logger.hpp>
 #include <json/Json.hpp>
+#include <metrics/Metrics.hpp>
 #include <system/Asio.hpp>
 #include <utils/MutexUtils.hpp>
 
@@ -45,6 +48,63 @@ namespace comms {
 typedef std::shared_ptr<AbstractLauncherCommunicator> SharedThis;
 typedef std::weak_ptr<AbstractLauncherCommunicator> WeakThis;
 
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * @brief The times at which a request reached each stage of handling. These are only set if metrics are enabled.
+ */
+struct RequestTimes
+{
+   /** The time at which the frame containing the request was received. */
+   Clock::time_point ReceiveTime;
+
+   /** The time at which the request was posted to the AsioService. */
+   Clock::time_point PostTime;
+};
+
+uint64_t getMicroseconds(const Clock::time_point& in_start, const Clock::time_point& in_end)
+{
+   return std::chrono::duration_cast<std::chrono::microseconds>(in_end - in_start).count();
+}
+
+/**
+ * @brief Gets the priority lane in which a request should be handled.
+ *
+ * Heartbeats, bootstraps, and job control requests are handled first so they are never queued behind bulk work.
+ * Wildcard job state requests may scan every job in the system, so they yield to all other requests.
+ *
+ * @param in_requestJson    The JSON object which represents the request.
+ *
+ * @return The priority lane in which the request should be handled.
+ */
+system::AsioPriority getRequestPriority(const json::Object& in_requestJson)
+{
+   int messageTypeVal = -1;
+   Error error = json::readObject(in_requestJson, api::FIELD_MESSAGE_TYPE, messageTypeVal);
+   if (error)
+      return system::AsioPriority::NORMAL;
+
+   switch (static_cast<api::Request::Type>(messageTypeVal))
+   {
+      case api::Request::Type::HEARTBEAT:
+      case api::Request::Type::BOOTSTRAP:
+      case api::Request::Type::CONTROL_JOB:
+         return system::AsioPriority::HIGH;
+      case api::Request::Type::GET_JOB:
+      {
+         std::string jobId;
+         error = json::readObject(in_requestJson, api::FIELD_JOB_ID, jobId);
+         return (!error && (jobId == "*")) ? system::AsioPriority::LOW : system::AsioPriority::NORMAL;
+      }
+      default:
+         return system::AsioPriority::NORMAL;
+   }
+}
+
+} // anonymous namespace
+
 struct AbstractLauncherCommunicator::Impl
 {
    /**
@@ -98,9 +158,10 @@ void AbstractLauncherCommunicator::registerRequestHandler(std::unique_ptr<Reques
 
 void AbstractLauncherCommunicator::sendResponse(const api::Response& in_response)
 {
-   std::string jsonStr = in_response.toJson().write();
+   std::string jsonStr = in_response.write();
    std::string message = m_baseImpl->MsgHandler.formatMessage(jsonStr);
 
+   metrics::recordFrameSent(message.size());
    logging::logDebugMessage("Sending message to the Launcher: " + jsonStr);
    writeResponse(message);
 }
@@ -137,30 +198,20 @@ void AbstractLauncherCommunicator::reportError(const Error& in_error)
 void AbstractLauncherCommunicator::onDataReceived(const char* in_data, size_t in_length)
 {
    WeakThis weakThis = shared_from_this();
-   std::function<void(const std::string&)> parseMessage =
-      [weakThis](const std::string& in_message)
+   std::function<void(const std::string&, const json::Object&, const RequestTimes&)> handleMessage =
+      [weakThis](const std::string& in_message, const json::Object& in_jsonRequest, const RequestTimes& in_times)
       {
          // If we can't lock the weak pointer, the communicator has been destroyed and there's nothing left to do.
          SharedThis sharedThis = weakThis.lock();
          if (!sharedThis)
             return;
 
-         // Parse the JSON object.
-         json::Object jsonRequest;
-         Error error = jsonRequest.parse(in_message);
-         if (error)
-         {
-            sharedThis->reportError(
-               systemError(boost::system::errc::protocol_error,
-                  "Received malformed launcher message: " + in_message,
-                  error,
-                  ERROR_LOCATION));
-            return;
-         }
+         bool recordMetrics = metrics::isEnabled();
+         Clock::time_point startTime = recordMetrics ? Clock::now() : Clock::time_point();
 
          // Try to construct a request object.
          std::shared_ptr<api::Request> request;
-         error = api::Request::fromJson(jsonRequest, request);
+         Error error = api::Request::fromJson(in_jsonRequest, request);
          if (error)
          {
             Error specificError;
@@ -179,13 +230,37 @@ void AbstractLauncherCommunicator::onDataReceived(const char* in_data, size_t in
             return;
          }
 
+         Clock::time_point handleTime = recordMetrics ? Clock::now() : Clock::time_point();
+
          // Send the object to the request handler, or send an error to the launcher;
          if (sharedThis->m_baseImpl->RequestHandlerPtr == nullptr)
             Impl::defaultRequestHandler(sharedThis, request);
          else
             (*sharedThis->m_baseImpl->RequestHandlerPtr)(request);
+
+         if (recordMetrics)
+         {
+            using namespace metrics;
+            Clock::time_point endTime = Clock::now();
+            api::Request::Type type = request->getType();
+            recordRequestStage(
+               type,
+               RequestStage::PARSE,
+               getMicroseconds(in_times.ReceiveTime, in_times.PostTime) + getMicroseconds(startTime, handleTime));
+            recordRequestStage(type, RequestStage::QUEUE, getMicroseconds(in_times.PostTime, startTime));
+            recordRequestStage(type, RequestStage::HANDLE, getMicroseconds(handleTime, endTime));
+            recordRequestStage(type, RequestStage::TOTAL, getMicroseconds(in_times.ReceiveTime, endTime));
+         }
       };
 
+   bool recordMetrics = metrics::isEnabled();
+   RequestTimes times;
+   if (recordMetrics)
+   {
+      times.ReceiveTime = Clock::now();
+      metrics::recordBytesReceived(in_length);
+   }
+
    std::vector<std::string> messages;
    Error error;
 
@@ -200,9 +275,29 @@ void AbstractLauncherCommunicator::onDataReceived(const char* in_data, size_t in
       return;
    }
 
+   metrics::recordFramesReceived(messages.size());
    for (const std::string& message: messages)
    {
-      system::AsioService::post(std::bind(parseMessage, message));
+      // Parse the JSON object now so the request can be placed in the correct priority lane. Constructing the request
+      // object may require expensive user lookups, so that is deferred to the handler.
+      json::Object jsonRequest;
+      error = jsonRequest.parse(message);
+      if (error)
+      {
+         reportError(
+            systemError(boost::system::errc::protocol_error,
+               "Received malformed launcher message: " + message,
+               error,
+               ERROR_LOCATION));
+         continue;
+      }
+
+      if (recordMetrics)
+         times.PostTime = Clock::now();
+
+      system::AsioService::post(
+         std::bind(handleMessage, message, jsonRequest, times),
+         getRequestPriority(jsonRequest));
    }
 }
 
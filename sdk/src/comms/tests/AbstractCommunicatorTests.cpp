@@ -23,6 +23,7 @@
 
 #include <TestMain.hpp>
 
+#include <atomic>
 #include <queue>
 #include <sstream>
 
@@ -297,6 +298,46 @@ TEST_CASE("Bad request - invalid request")
    CHECK(logPtr->pop().Message.find("Received invalid launcher message: " + request.write()) != std::string::npos);
 }
 
+TEST_CASE("Bad request - not JSON, followed by a valid request")
+{
+   logging::MockLogPtr logPtr = logging::getMockLogDest();
+
+   json::Object version;
+   version.insert(api::FIELD_VERSION_MAJOR, json::Value(5));
+   version.insert(api::FIELD_VERSION_MINOR, json::Value(99));
+   version.insert(api::FIELD_VERSION_PATCH, json::Value(26));
+
+   json::Object requestObj;
+   requestObj.insert(api::FIELD_VERSION, version);
+   requestObj.insert(api::FIELD_REQUEST_ID, json::Value(34));
+   requestObj.insert(api::FIELD_MESSAGE_TYPE, json::Value(static_cast<int>(api::Request::Type::BOOTSTRAP)));
+   std::string requestMsg = requestObj.write();
+
+   std::atomic_bool isHandled(false);
+   std::unique_ptr<RequestHandler> handler(new RequestHandler(
+      [&isHandled](const std::shared_ptr<api::Request>& in_request)
+      {
+         if ((in_request != nullptr) && (in_request->getId() == 34))
+            isHandled = true;
+      }));
+
+   // Both messages arrive in the same batch. The malformed one must not prevent the valid one from being handled.
+   std::string data = convertHeader(20).append("This message is 20 B");
+   data.append(convertHeader(requestMsg.size())).append(requestMsg);
+
+   CommsPtr comms(new MockCommunicator());
+   comms->registerRequestHandler(std::move(handler));
+   comms->receiveData(data);
+
+   // Wait a couple of seconds to ensure the other threads finish.
+   sleep(2);
+
+   CHECK(isHandled.load());
+   REQUIRE(logPtr->getSize() == 1);
+   CHECK(logPtr->peek().Level == logging::LogLevel::ERR);
+   CHECK(logPtr->pop().Message.find("JsonParseError") != std::string::npos);
+}
+
 // This test case must always come last.
 TEST_CASE("Clean up")
 {
@@ -23,11 +23,23 @@
 
 #include <jobs/AbstractJobRepository.hpp>
 
+#include <signal.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <map>
 
 #include <Error.hpp>
+#include <jobs/JobCleanupExecutor.hpp>
 #include <jobs/JobPruner.hpp>
+#include <metrics/Metrics.hpp>
+#include <options/Options.hpp>
+#include <system/Asio.hpp>
+#include <system/DateTime.hpp>
 
+#include "JobTierStore.hpp"
 #include "../system/ReaderWriterMutex.hpp"
 
 using namespace rstudio::launcher_plugins::api;
@@ -39,6 +51,79 @@ namespace jobs {
 typedef std::shared_ptr<AbstractJobRepository> SharedThis;
 typedef std::weak_ptr<AbstractJobRepository> WeakThis;
 
+namespace {
+
+/**
+ * @brief Gets the name of this host.
+ *
+ * @return The name of this host, or an empty string if it could not be determined.
+ */
+std::string getHostname()
+{
+   char hostname[HOST_NAME_MAX + 1] = {};
+   if (::gethostname(hostname, HOST_NAME_MAX) != 0)
+      hostname[0] = '\0';
+
+   return hostname;
+}
+
+/**
+ * @brief Gets the directory of this process's cold tier.
+ *
+ * The scratch path may be shared by several hosts which are load balanced, so each process gets its own directory.
+ *
+ * @return The directory of this process's cold tier.
+ */
+system::FilePath getTierDirectory()
+{
+   return options::Options::getInstance().getScratchPath()
+      .completeChildPath("job-tiers")
+      .completeChildPath(getHostname() + "-" + std::to_string(::getpid()));
+}
+
+/**
+ * @brief Removes the cold tier directories of processes on this host which are no longer running.
+ *
+ * A process removes its directory when it stops, but the directory is left behind if the process crashes or is killed.
+ */
+void removeStaleTierDirectories()
+{
+   system::FilePath tiersDirectory = getTierDirectory().getParent();
+   if (!tiersDirectory.exists())
+      return;
+
+   std::vector<system::FilePath> children;
+   Error error = tiersDirectory.getChildren(children);
+   if (error)
+   {
+      logging::logError(error);
+      return;
+   }
+
+   // Only directories named <hostname>-<pid> belong to this host. Other hosts' processes can't be checked from here.
+   const std::string prefix = getHostname() + "-";
+   for (const system::FilePath& child: children)
+   {
+      const std::string name = child.getFilename();
+      if (!child.isDirectory() ||
+         (name.size() <= prefix.size()) ||
+         (name.compare(0, prefix.size(), prefix) != 0) ||
+         (name.find_first_not_of("0123456789", prefix.size()) != std::string::npos))
+         continue;
+
+      pid_t pid = static_cast<pid_t>(std::strtol(name.c_str() + prefix.size(), nullptr, 10));
+      if ((::kill(pid, 0) == 0) || (errno != ESRCH))
+         continue;
+
+      logging::logDebugMessage("Removing the job tier directory of stopped process " + std::to_string(pid) + ".");
+      error = child.remove();
+      if (error)
+         logging::logError(error);
+   }
+}
+
+} // anonymous namespace
+
 struct AbstractJobRepository::Impl
 {
    explicit Impl(JobStatusNotifierPtr in_jobStatusNotifier) :
@@ -46,8 +131,189 @@ struct AbstractJobRepository::Impl
    {
    }
 
+   /**
+    * @brief Moves the full details of completed jobs which have not changed for the idle time to the cold tier.
+    *
+    * Only jobs which are not referenced outside of the repository are moved, so no one can be using the full details.
+    */
+   void demoteIdleJobs()
+   {
+      system::DateTime now;
+      JobList candidates;
+      READ_LOCK_BEGIN(Mutex)
+      {
+         for (const auto& entry: JobMap)
+         {
+            if ((entry.second.use_count() > 1) || (ColdJobs.find(entry.first) != ColdJobs.end()))
+               continue;
+
+            // Leave jobs which were read recently in memory, since they're likely to be read again.
+            auto promotedItr = PromotionTimes.find(entry.first);
+            if ((promotedItr != PromotionTimes.end()) && (promotedItr->second + TieringIdleTime > now))
+               continue;
+
+            candidates.push_back(entry.second);
+         }
+      }
+      RW_LOCK_END(true)
+
+      // Write the candidates to the cold tier without the repository lock held.
+      struct Demotion
+      {
+         JobPtr Summary;
+         ColdJobLocation Location;
+      };
+
+      std::map<JobPtr, Demotion> demotions;
+      for (const JobPtr& job: candidates)
+      {
+         std::string jobData;
+         JobPtr summary;
+         LOCK_JOB(job)
+         {
+            if (job->isCompleted() && (job->LastUpdateTime.getValueOr(job->SubmissionTime) + TieringIdleTime <= now))
+            {
+               jobData = job->toJson().write();
+               summary = job->getSummary();
+            }
+         }
+         END_LOCK_JOB
+
+         if (summary == nullptr)
+            continue;
+
+         ColdJobLocation location;
+         Error error = TierStore->store(jobData, location);
+         if (error)
+         {
+            logging::logError(error);
+            break;
+         }
+
+         demotions[job] = Demotion{ summary, location };
+      }
+
+      WRITE_LOCK_BEGIN(Mutex)
+      {
+         for (const auto& demotion: demotions)
+         {
+            const JobPtr& job = demotion.first;
+            auto itr = JobMap.find(job->Id);
+
+            // If the job was removed or is now being used elsewhere, leave it as it is. The only other references are
+            // in candidates and demotions.
+            if ((itr == JobMap.end()) || (itr->second != job) || (job.use_count() > 3))
+            {
+               TierStore->release(demotion.second.Location);
+               continue;
+            }
+
+            itr->second = demotion.second.Summary;
+            ColdJobs[job->Id] = demotion.second.Location;
+            PromotionTimes.erase(job->Id);
+         }
+
+         updateTierMetrics();
+      }
+      RW_LOCK_END(true)
+   }
+
+   /**
+    * @brief Reads the full details of a job from the cold tier.
+    *
+    * @param in_location    The location of the full details of the job.
+    * @param out_job        The job with its full details.
+    *
+    * @return Success if the full details of the job could be read; Error otherwise.
+    */
+   Error readColdJob(const ColdJobLocation& in_location, JobPtr& out_job) const
+   {
+      std::string jobData;
+      Error error = TierStore->load(in_location, jobData);
+
+      json::Object jobObj;
+      if (!error)
+         error = jobObj.parse(jobData);
+
+      JobPtr job(new Job());
+      if (!error)
+         error = Job::fromJson(jobObj, *job);
+
+      if (!error)
+         out_job = job;
+
+      return error;
+   }
+
+   /**
+    * @brief Loads the full details of a job in the cold tier. The mutex must be held.
+    *
+    * @param in_summary     The summary of the job.
+    * @param in_location    The location of the full details of the job.
+    *
+    * @return The job with its full details, or in_summary if they could not be loaded.
+    */
+   JobPtr loadColdJob(const JobPtr& in_summary, const ColdJobLocation& in_location) const
+   {
+      JobPtr job;
+      Error error = readColdJob(in_location, job);
+      if (error)
+      {
+         error.addProperty("job-id", in_summary->Id);
+         logging::logError(error);
+         return in_summary;
+      }
+
+      return job;
+   }
+
+   /**
+    * @brief Loads the full details of jobs in the cold tier. The mutex must not be held. The jobs stay in the cold tier.
+    *
+    * @param in_coldJobs    The positions in io_jobs of the jobs to load, and the locations of their full details.
+    * @param io_jobs        The jobs. The summary of each job in in_coldJobs is replaced with its full details.
+    */
+   void loadColdJobs(const std::vector<std::pair<size_t, ColdJobLocation> >& in_coldJobs, JobList& io_jobs)
+   {
+      for (const auto& coldJob: in_coldJobs)
+      {
+         JobPtr& job = io_jobs[coldJob.first];
+         if (!readColdJob(coldJob.second, job))
+            continue;
+
+         // The job may have been moved back into memory or removed since it was found, which can release its
+         // location. Look it up again with the mutex held.
+         READ_LOCK_BEGIN(Mutex)
+         {
+            auto itr = JobMap.find(job->Id);
+            auto coldItr = ColdJobs.find(job->Id);
+            if ((itr != JobMap.end()) && (coldItr == ColdJobs.end()))
+               job = itr->second;
+            else if (itr != JobMap.end())
+               job = loadColdJob(itr->second, coldItr->second);
+         }
+         RW_LOCK_END(true)
+      }
+   }
+
+   /**
+    * @brief Updates the job tier metrics. The mutex must be held.
+    */
+   void updateTierMetrics() const
+   {
+      metrics::setJobTierSizes(
+         JobMap.size() - ColdJobs.size(),
+         ColdJobs.size(),
+         (TierStore == nullptr) ? 0 : TierStore->getLiveBytes());
+   }
+
    SubscriptionHandle AllJobsSubHandle;
 
+   JobCleanupExecutorPtr CleanupExecutor;
+
+   /** The locations of the full details of the jobs in the cold tier. The jobs in JobMap are their summaries. */
+   std::map<std::string, ColdJobLocation> ColdJobs;
+
    std::map<std::string, JobPtr> JobMap;
 
    JobPrunerPtr JobPruneTimer;
@@ -55,6 +321,18 @@ struct AbstractJobRepository::Impl
    system::ReaderWriterMutex Mutex;
 
    JobStatusNotifierPtr Notifier;
+
+   /** The times at which jobs were last moved from the cold tier back into memory. */
+   std::map<std::string, system::DateTime> PromotionTimes;
+
+   /** How long completed jobs must go unchanged before they are moved to the cold tier. */
+   system::TimeDuration TieringIdleTime;
+
+   /** The timer which moves idle jobs to the cold tier. */
+   system::AsyncTimedEvent TieringTimer;
+
+   /** The store of the cold tier, if tiering is enabled. */
+   JobTierStorePtr TierStore;
 };
 
 PRIVATE_IMPL_DELETER_IMPL(AbstractJobRepository)
@@ -73,26 +351,153 @@ void AbstractJobRepository::addJob(const JobPtr& in_job)
       {
          m_impl->JobMap[in_job->Id] = in_job;
          onJobAdded(in_job);
+         m_impl->updateTierMetrics();
       }
    }
    RW_LOCK_END(true)
 }
 
+void AbstractJobRepository::flush()
+{
+   // Finish cleaning up removed jobs first, since that may queue more changes for the inheriting class to persist.
+   if (m_impl->CleanupExecutor)
+      m_impl->CleanupExecutor->drain();
+
+   onFlush();
+}
+
+Error AbstractJobRepository::enableTiering(const system::FilePath& in_directory, const system::TimeDuration& in_idleTime)
+{
+   if (m_impl->TierStore != nullptr)
+      return Success();
+
+   JobTierStorePtr tierStore(new JobTierStore(in_directory));
+   Error error = tierStore->initialize();
+   if (error)
+      return error;
+
+   WRITE_LOCK_BEGIN(m_impl->Mutex)
+   {
+      m_impl->TierStore = std::move(tierStore);
+      m_impl->TieringIdleTime = in_idleTime;
+   }
+   RW_LOCK_END(true)
+
+   // Look for idle jobs at least once a second, or as often as jobs may become idle.
+   WeakThis weakThis = shared_from_this();
+   m_impl->TieringTimer.start(
+      std::max(in_idleTime, system::TimeDuration::Seconds(1)),
+      [weakThis]()
+      {
+         if (SharedThis sharedThis = weakThis.lock())
+            sharedThis->m_impl->demoteIdleJobs();
+      });
+
+   return Success();
+}
+
 JobPtr AbstractJobRepository::getJob(const std::string& in_jobId, const system::User& in_user) const
 {
+   JobPtr job, summary;
    READ_LOCK_BEGIN(m_impl->Mutex)
    {
       auto itr = m_impl->JobMap.find(in_jobId);
-      if ((itr != m_impl->JobMap.end()) &&
-          (in_user.isAllUsers() || (itr->second->User == in_user)))
+      if ((itr == m_impl->JobMap.end()) || (!in_user.isAllUsers() && (itr->second->User != in_user)))
+         return JobPtr();
+
+      auto coldItr = m_impl->ColdJobs.find(in_jobId);
+      if (coldItr == m_impl->ColdJobs.end())
          return itr->second;
+
+      summary = itr->second;
+      job = m_impl->loadColdJob(summary, coldItr->second);
    }
    RW_LOCK_END(true)
 
-   return JobPtr();
+   if (job == summary)
+      return job;
+
+   // Move the job back into memory, since it's likely to be used again soon.
+   WRITE_LOCK_BEGIN(m_impl->Mutex)
+   {
+      auto itr = m_impl->JobMap.find(in_jobId);
+      auto coldItr = m_impl->ColdJobs.find(in_jobId);
+      if ((itr != m_impl->JobMap.end()) && (itr->second == summary) && (coldItr != m_impl->ColdJobs.end()))
+      {
+         itr->second = job;
+         m_impl->TierStore->release(coldItr->second);
+         m_impl->ColdJobs.erase(coldItr);
+         m_impl->PromotionTimes[in_jobId] = system::DateTime();
+         m_impl->updateTierMetrics();
+      }
+      else if (itr != m_impl->JobMap.end())
+      {
+         // Another thread moved the job back into memory first.
+         job = itr->second;
+      }
+   }
+   RW_LOCK_END(true)
+
+   return job;
 }
 
 JobList AbstractJobRepository::getJobs(const system::User& in_user) const
+{
+   JobList jobs;
+   std::vector<std::pair<size_t, ColdJobLocation> > coldJobs;
+
+   READ_LOCK_BEGIN(m_impl->Mutex)
+   {
+      // Get all values if this request has admin privileges.
+      const auto end = m_impl->JobMap.end();
+      for (auto itr = m_impl->JobMap.begin(); itr != end; ++itr)
+      {
+         if (!in_user.isAllUsers() && (itr->second->User != in_user))
+            continue;
+
+         auto coldItr = m_impl->ColdJobs.find(itr->first);
+         if (coldItr != m_impl->ColdJobs.end())
+            coldJobs.emplace_back(jobs.size(), coldItr->second);
+
+         jobs.push_back(itr->second);
+      }
+   }
+   RW_LOCK_END(true)
+
+   // Jobs in the cold tier are loaded for the caller without the lock held, but stay in the cold tier.
+   m_impl->loadColdJobs(coldJobs, jobs);
+   return jobs;
+}
+
+JobList AbstractJobRepository::getJobs(const std::vector<std::string>& in_jobIds) const
+{
+   JobList jobs(in_jobIds.size());
+   std::vector<std::pair<size_t, ColdJobLocation> > coldJobs;
+
+   READ_LOCK_BEGIN(m_impl->Mutex)
+   {
+      for (size_t i = 0; i < in_jobIds.size(); ++i)
+      {
+         auto itr = m_impl->JobMap.find(in_jobIds[i]);
+         if (itr == m_impl->JobMap.end())
+            continue;
+
+         auto coldItr = m_impl->ColdJobs.find(in_jobIds[i]);
+         if (coldItr != m_impl->ColdJobs.end())
+            coldJobs.emplace_back(i, coldItr->second);
+
+         jobs[i] = itr->second;
+      }
+   }
+   RW_LOCK_END(true)
+
+   // Jobs in the cold tier are loaded for the caller without the lock held, but stay in the cold tier. Status
+   // watchers read jobs this way on every poll, so moving them back into memory would keep idle jobs from staying out.
+   m_impl->loadColdJobs(coldJobs, jobs);
+   return jobs;
+}
+
+JobList AbstractJobRepository::getJobSummaries(const system::User& in_user) const
 {
    JobList jobs;
 
@@ -132,6 +537,14 @@ Error AbstractJobRepository::initialize()
       }
    };
 
+   m_impl->CleanupExecutor.reset(
+      new JobCleanupExecutor(
+         [weakThis](const JobList& in_jobs)
+         {
+            if (SharedThis sharedThis = weakThis.lock())
+               sharedThis->onJobsRemoved(in_jobs);
+         }));
+
    JobList jobs;
    error = loadJobs(jobs);
    if (error)
@@ -140,6 +553,8 @@ Error AbstractJobRepository::initialize()
    for (const JobPtr& job: jobs)
       m_impl->JobMap[job->Id] = job;
 
+   m_impl->updateTierMetrics();
+
    m_impl->AllJobsSubHandle = m_impl->Notifier->subscribe(onJobStatusUpdate);
 
    m_impl->JobPruneTimer.reset(new JobPruner(shared_from_this(), m_impl->Notifier));
@@ -153,22 +568,51 @@ Error AbstractJobRepository::initialize()
 
    logging::logInfoMessage("Pruned " + std::to_string(pruned) + " jobs...");
 
+   const options::Options& options = options::Options::getInstance();
+   if (options.getJobTieringIdleSeconds() > system::TimeDuration())
+   {
+      removeStaleTierDirectories();
+      return enableTiering(getTierDirectory(), options.getJobTieringIdleSeconds());
+   }
+
    return Success();
 }
 
 void AbstractJobRepository::removeJob(const std::string& in_jobId)
 {
+   JobPtr removedJob;
    WRITE_LOCK_BEGIN(m_impl->Mutex)
    {
       auto itr = m_impl->JobMap.find(in_jobId);
       if (itr != m_impl->JobMap.end())
       {
-         // Keep the lock while invoking the inheriting class impl.
-         onJobRemoved(itr->second);
+         removedJob = itr->second;
+
+         // The job is cleaned up with its full details, so load them if the job is in the cold tier.
+         auto coldItr = m_impl->ColdJobs.find(in_jobId);
+         if (coldItr != m_impl->ColdJobs.end())
+         {
+            removedJob = m_impl->loadColdJob(removedJob, coldItr->second);
+            m_impl->TierStore->release(coldItr->second);
+            m_impl->ColdJobs.erase(coldItr);
+         }
+
+         m_impl->PromotionTimes.erase(in_jobId);
          m_impl->JobMap.erase(itr);
+         m_impl->updateTierMetrics();
       }
    }
    RW_LOCK_END(true)
+
+   if (removedJob == nullptr)
+      return;
+
+   // Clean up the job in the background, without any locks held. If the repository hasn't been initialized, there's
+   // no executor, so clean up immediately instead.
+   if (m_impl->CleanupExecutor)
+      m_impl->CleanupExecutor->post(removedJob);
+   else
+      onJobsRemoved({ removedJob });
 }
 
 void AbstractJobRepository::onJobAdded(const JobPtr&)
@@ -181,11 +625,22 @@ void AbstractJobRepository::onJobRemoved(const JobPtr&)
    // Do nothing.
 }
 
+void AbstractJobRepository::onJobsRemoved(const JobList& in_jobs)
+{
+   for (const JobPtr& job: in_jobs)
+      onJobRemoved(job);
+}
+
 Error AbstractJobRepository::onInitialize()
 {
    return Success();
 }
 
+void AbstractJobRepository::onFlush()
+{
+   // Do nothing.
+}
+
 } // namespace jobs
 } // namespace launcher_plugins
 } // namespace rstudio
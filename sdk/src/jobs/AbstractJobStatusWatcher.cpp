@@ -23,10 +23,59 @@
 
 #include <jobs/AbstractJobStatusWatcher.hpp>
 
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include <utils/MutexUtils.hpp>
+
 namespace rstudio {
 namespace launcher_plugins {
 namespace jobs {
 
+namespace {
+
+/** How long fetched job details are reused for other updates to the same job. */
+const system::TimeDuration s_detailsCacheTime = system::TimeDuration::Seconds(5);
+
+/**
+ * @brief A fetch of a job's details which other callers may wait on.
+ */
+struct DetailsFetch
+{
+   DetailsFetch() :
+      IsComplete(false)
+   {
+   }
+
+   /** Whether the fetch has completed. */
+   bool IsComplete;
+
+   /** The job, if its details could be fetched. */
+   api::JobPtr Job;
+
+   /** The error which occurred while fetching the job's details, if any. */
+   Error Result;
+};
+
+typedef std::shared_ptr<DetailsFetch> DetailsFetchPtr;
+
+/**
+ * @brief Job details which were fetched recently.
+ */
+struct CachedDetails
+{
+   /** The time after which the details should be fetched again. */
+   system::DateTime ExpiryTime;
+
+   /** The job. */
+   api::JobPtr Job;
+};
+
+} // anonymous namespace
+
 struct AbstractJobStatusWatcher::Impl
 {
    /**
@@ -41,11 +90,181 @@ struct AbstractJobStatusWatcher::Impl
    {
    }
 
+   /**
+    * @brief Gets the details of jobs which are not in the repository.
+    *
+    * Only one fetch is made for a job at a time: callers which need the details of a job that is already being fetched
+    * wait for that fetch instead. Details which were fetched recently are reused.
+    *
+    * @param in_watcher     The watcher which should fetch the details.
+    * @param in_jobIds      The IDs of the jobs to retrieve.
+    * @param out_jobs       The jobs which could be retrieved, by ID.
+    *
+    * @return Success if every job could be retrieved; Error otherwise.
+    */
+   Error getJobDetails(
+      const AbstractJobStatusWatcher& in_watcher,
+      const std::vector<std::string>& in_jobIds,
+      std::map<std::string, api::JobPtr>& out_jobs)
+   {
+      std::vector<std::string> fetchJobIds;
+      std::vector<std::pair<std::string, DetailsFetchPtr> > ownFetches, otherFetches;
+      LOCK_MUTEX(DetailsMutex)
+      {
+         pruneDetailsCache();
+         for (const std::string& jobId: in_jobIds)
+         {
+            auto cachedItr = RecentDetails.find(jobId);
+            if (cachedItr != RecentDetails.end())
+            {
+               out_jobs[jobId] = cachedItr->second.Job;
+               continue;
+            }
+
+            DetailsFetchPtr& fetch = InFlightDetails[jobId];
+            if (fetch)
+               otherFetches.emplace_back(jobId, fetch);
+            else
+            {
+               fetch.reset(new DetailsFetch());
+               ownFetches.emplace_back(jobId, fetch);
+               fetchJobIds.push_back(jobId);
+            }
+         }
+      }
+      END_LOCK_MUTEX
+
+      Error error;
+      if (!ownFetches.empty())
+      {
+         // The fetches must be completed even if this throws, or the callers waiting on them would wait forever.
+         api::JobList jobs;
+         Error fetchError;
+         try
+         {
+            fetchError = in_watcher.getBatchJobDetails(fetchJobIds, jobs);
+         }
+         catch (const std::exception& e)
+         {
+            fetchError = unknownError("Unexpected exception: " + std::string(e.what()), ERROR_LOCATION);
+         }
+         catch (...)
+         {
+            fetchError = unknownError("Unexpected exception while retrieving job details.", ERROR_LOCATION);
+         }
+
+         std::map<std::string, api::JobPtr> fetchedJobs;
+         for (const api::JobPtr& job: jobs)
+         {
+            if (job)
+               fetchedJobs[job->Id] = job;
+         }
+
+         LOCK_MUTEX(DetailsMutex)
+         {
+            system::DateTime expiryTime = system::DateTime() + s_detailsCacheTime;
+            for (const auto& fetch: ownFetches)
+            {
+               auto itr = fetchedJobs.find(fetch.first);
+               if (itr != fetchedJobs.end())
+               {
+                  fetch.second->Job = itr->second;
+                  RecentDetails[fetch.first] = CachedDetails{ expiryTime, itr->second };
+                  DetailsExpiry.emplace_back(expiryTime, fetch.first);
+               }
+               else if (fetchError)
+                  fetch.second->Result = fetchError;
+               else
+                  fetch.second->Result = unknownError(
+                     "Could not retrieve the details of job " + fetch.first,
+                     ERROR_LOCATION);
+
+               fetch.second->IsComplete = true;
+               InFlightDetails.erase(fetch.first);
+            }
+         }
+         END_LOCK_MUTEX
+
+         DetailsFetched.notify_all();
+         collectResults(ownFetches, out_jobs, error);
+      }
+
+      if (!otherFetches.empty())
+      {
+         UNIQUE_LOCK_MUTEX(DetailsMutex)
+         {
+            for (const auto& fetch: otherFetches)
+            {
+               const DetailsFetchPtr& details = fetch.second;
+               DetailsFetched.wait(uniqueLock, [&details]() { return details->IsComplete; });
+            }
+         }
+         END_LOCK_MUTEX
+
+         collectResults(otherFetches, out_jobs, error);
+      }
+
+      return error;
+   }
+
+   /**
+    * @brief Collects the results of completed fetches.
+    *
+    * @param in_fetches     The completed fetches, by job ID.
+    * @param io_jobs        The jobs which could be retrieved, by ID.
+    * @param io_error       The first error which occurred, if any.
+    */
+   static void collectResults(
+      const std::vector<std::pair<std::string, DetailsFetchPtr> >& in_fetches,
+      std::map<std::string, api::JobPtr>& io_jobs,
+      Error& io_error)
+   {
+      for (const auto& fetch: in_fetches)
+      {
+         if (fetch.second->Job)
+            io_jobs[fetch.first] = fetch.second->Job;
+         else if (!io_error)
+            io_error = fetch.second->Result;
+      }
+   }
+
+   /**
+    * @brief Removes expired details from the cache. The details mutex must be held.
+    */
+   void pruneDetailsCache()
+   {
+      // Details are always cached for the same length of time, so they expire in the order they were added.
+      system::DateTime now;
+      while (!DetailsExpiry.empty() && (DetailsExpiry.front().first <= now))
+      {
+         auto itr = RecentDetails.find(DetailsExpiry.front().second);
+         if ((itr != RecentDetails.end()) && (itr->second.ExpiryTime <= now))
+            RecentDetails.erase(itr);
+
+         DetailsExpiry.pop_front();
+      }
+   }
+
+   /** The expiry times of the cached job details, in the order they were added. */
+   std::deque<std::pair<system::DateTime, std::string> > DetailsExpiry;
+
+   /** Notified when fetches of job details complete. */
+   std::condition_variable DetailsFetched;
+
+   /** Mutex to protect the in-flight and recently fetched job details. */
+   std::mutex DetailsMutex;
+
+   /** The fetches of job details which are in progress, by job ID. */
+   std::map<std::string, DetailsFetchPtr> InFlightDetails;
+
    /** The job repository. */
    JobRepositoryPtr  JobRepo;
 
    /** The job status notifier. */
    JobStatusNotifierPtr Notifier;
+
+   /** The job details which were fetched recently, by job ID. */
+   std::map<std::string, CachedDetails> RecentDetails;
 };
 
 PRIVATE_IMPL_DELETER_IMPL(AbstractJobStatusWatcher)
@@ -63,18 +282,117 @@ Error AbstractJobStatusWatcher::updateJobStatus(
    const std::string& in_statusMessage,
    const system::DateTime& in_invocationTime)
 {
+   if (!isStatusChanged(in_jobId, in_newStatus, in_statusMessage))
+      return Success();
+
    api::JobPtr job = m_baseImpl->JobRepo->getJob(in_jobId);
    if (!job)
    {
-      Error error = getJobDetails(in_jobId, job);
+      std::map<std::string, api::JobPtr> jobs;
+      Error error = m_baseImpl->getJobDetails(*this, { in_jobId }, jobs);
       if (error)
          return error;
+
+      job = jobs[in_jobId];
    }
 
    m_baseImpl->Notifier->updateJob(job, in_newStatus, in_statusMessage, in_invocationTime);
+   onStatusUpdated(in_jobId, in_newStatus, in_statusMessage);
    return Success();
 }
 
+Error AbstractJobStatusWatcher::updateJobStatuses(const JobStatusUpdates& in_updates)
+{
+   JobStatusUpdates updates;
+   std::vector<std::string> jobIds;
+   for (const JobStatusUpdate& update: in_updates)
+   {
+      if (isStatusChanged(update.JobId, update.Status, update.StatusMessage))
+      {
+         updates.push_back(update);
+         jobIds.push_back(update.JobId);
+      }
+   }
+
+   if (updates.empty())
+      return Success();
+
+   api::JobList jobs = m_baseImpl->JobRepo->getJobs(jobIds);
+
+   std::vector<std::string> missingJobIds;
+   for (size_t i = 0; i < jobs.size(); ++i)
+   {
+      if (!jobs[i])
+         missingJobIds.push_back(jobIds[i]);
+   }
+
+   Error error;
+   if (!missingJobIds.empty())
+   {
+      std::map<std::string, api::JobPtr> details;
+      error = m_baseImpl->getJobDetails(*this, missingJobIds, details);
+      for (size_t i = 0; i < jobs.size(); ++i)
+      {
+         if (jobs[i])
+            continue;
+
+         auto itr = details.find(jobIds[i]);
+         if (itr != details.end())
+            jobs[i] = itr->second;
+      }
+   }
+
+   // Drop the updates for any jobs which still could not be found.
+   api::JobList foundJobs;
+   JobStatusUpdates foundUpdates;
+   foundJobs.reserve(jobs.size());
+   foundUpdates.reserve(updates.size());
+   for (size_t i = 0; i < jobs.size(); ++i)
+   {
+      if (jobs[i])
+      {
+         foundJobs.push_back(std::move(jobs[i]));
+         foundUpdates.push_back(std::move(updates[i]));
+      }
+   }
+
+   m_baseImpl->Notifier->updateJobs(foundJobs, foundUpdates);
+   for (const JobStatusUpdate& update: foundUpdates)
+      onStatusUpdated(update.JobId, update.Status, update.StatusMessage);
+
+   return error;
+}
+
+Error AbstractJobStatusWatcher::getBatchJobDetails(
+   const std::vector<std::string>& in_jobIds,
+   api::JobList& out_jobs) const
+{
+   Error result;
+   for (const std::string& jobId: in_jobIds)
+   {
+      api::JobPtr job;
+      Error error = getJobDetails(jobId, job);
+      if (error)
+      {
+         if (!result)
+            result = error;
+      }
+      else if (job)
+         out_jobs.push_back(std::move(job));
+   }
+
+   return result;
+}
+
+bool AbstractJobStatusWatcher::isStatusChanged(const std::string&, api::Job::State, const std::string&)
+{
+   return true;
+}
+
+void AbstractJobStatusWatcher::onStatusUpdated(const std::string&, api::Job::State, const std::string&)
+{
+}
+
 } // namespace jobs
 } // namespace launcher_plugins
 } // namespace rstudio
@@ -24,6 +24,10 @@
 
 #include <jobs/AbstractTimedJobStatusWatcher.hpp>
 
+#include <map>
+#include <mutex>
+#include <random>
+
 #include <system/Asio.hpp>
 #include <utils/MutexUtils.hpp>
 
@@ -34,17 +38,162 @@ namespace jobs {
 typedef std::shared_ptr<AbstractTimedJobStatusWatcher> SharedThis;
 typedef std::weak_ptr<AbstractTimedJobStatusWatcher> WeakThis;
 
+namespace {
+
+int64_t toMicroseconds(const system::TimeDuration& in_duration)
+{
+   return ((in_duration.getHours() * 60 + in_duration.getMinutes()) * 60 + in_duration.getSeconds()) * 1000000 +
+      in_duration.getMicroseconds();
+}
+
+} // anonymous namespace
+
 struct AbstractTimedJobStatusWatcher::Impl
 {
-   explicit Impl(system::TimeDuration in_frequency) :
-      Frequency(std::move(in_frequency))
+   /**
+    * @brief The most recent status which was posted for a job.
+    */
+   struct PostedStatus
    {
+      /** The status. */
+      api::Job::State Status;
+
+      /** The status message. */
+      std::string StatusMessage;
 
+      /** The number of the poll which last reported this status. */
+      uint64_t PollNumber;
+   };
+
+   Impl(system::TimeDuration in_minFrequency, system::TimeDuration in_maxFrequency) :
+      ChangeCount(0),
+      Frequency(in_minFrequency),
+      IsFullPoll(true),
+      IsStopped(false),
+      MaxFrequency(std::max(in_minFrequency, in_maxFrequency)),
+      MinFrequency(std::move(in_minFrequency)),
+      PollNumber(0),
+      Random(std::random_device()())
+   {
    }
 
+   /**
+    * @brief Gets the time until the next poll, based on whether the last poll found any changes. The mutex must be held.
+    *
+    * @return The time until the next poll.
+    */
+   system::TimeDuration getNextWaitTime()
+   {
+      if (MinFrequency == MaxFrequency)
+         return MinFrequency;
+
+      int64_t frequency = std::min(
+         (ChangeCount > 0) ? toMicroseconds(MinFrequency) : toMicroseconds(Frequency) * 2,
+         toMicroseconds(MaxFrequency));
+      Frequency = system::TimeDuration::Microseconds(frequency);
+
+      std::uniform_int_distribution<int64_t> jitter(-frequency / 10, frequency / 10);
+      return system::TimeDuration::Microseconds(frequency + jitter(Random));
+   }
+
+   /**
+    * @brief Polls job statuses and schedules the next poll.
+    *
+    * @param in_watcher     The watcher which owns this object.
+    *
+    * @return Success if the jobs could be polled; Error if an unrecoverable polling issue occurred.
+    */
+   Error poll(AbstractTimedJobStatusWatcher& in_watcher)
+   {
+      std::string cursor;
+      LOCK_MUTEX(Mutex)
+      {
+         if (IsStopped)
+            return Success();
+
+         cursor = Cursor;
+         IsFullPoll = cursor.empty();
+         ChangeCount = 0;
+         ++PollNumber;
+      }
+      END_LOCK_MUTEX
+
+      std::string nextCursor;
+      Error error = in_watcher.pollJobStatusChanges(cursor, nextCursor);
+      if (error)
+         return error;
+
+      LOCK_MUTEX(Mutex)
+      {
+         Cursor = nextCursor;
+
+         // After a full poll, forget jobs which weren't reported, since they've been removed from the Job Scheduling
+         // System. After a poll of changes, the next full poll will re-populate the statuses.
+         for (auto itr = PostedStatuses.begin(); itr != PostedStatuses.end();)
+         {
+            if (!IsFullPoll || (itr->second.PollNumber != PollNumber))
+               itr = PostedStatuses.erase(itr);
+            else
+               ++itr;
+         }
+
+         if (IsStopped)
+            return Success();
+
+         WeakThis weakThis = in_watcher.shared_from_this();
+         NextPoll.reset(new system::AsyncDeadlineEvent(
+            [weakThis]()
+            {
+               if (SharedThis sharedThis = weakThis.lock())
+               {
+                  Error error = sharedThis->m_timedBaseImpl->poll(*sharedThis);
+                  if (error)
+                     logging::logError(error);
+               }
+            },
+            getNextWaitTime()));
+         NextPoll->start();
+      }
+      END_LOCK_MUTEX
+
+      return Success();
+   }
+
+   /** The number of updates which changed a job during the current poll. */
+   size_t ChangeCount;
+
+   /** The cursor returned by the previous poll. */
+   std::string Cursor;
+
+   /** The time between the previous poll and the next, before jitter. */
    system::TimeDuration Frequency;
 
-   system::AsyncTimedEvent TimedEvent;
+   /** Whether the current poll reports every job. */
+   bool IsFullPoll;
+
+   /** Whether the watcher has been stopped. */
+   bool IsStopped;
+
+   /** The longest time between polls. */
+   const system::TimeDuration MaxFrequency;
+
+   /** The shortest time between polls. */
+   const system::TimeDuration MinFrequency;
+
+   /** The mutex which protects this object. */
+   std::mutex Mutex;
+
+   /** The event which will perform the next poll. */
+   std::unique_ptr<system::AsyncDeadlineEvent> NextPoll;
+
+   /** The number of the current poll. */
+   uint64_t PollNumber;
+
+   /** The most recent status posted for each job, by job ID. Only used for full polls. */
+   std::map<std::string, PostedStatus> PostedStatuses;
+
+   /** The random number generator for jitter. */
+   std::mt19937_64 Random;
 };
 
 PRIVATE_IMPL_DELETER_IMPL(AbstractTimedJobStatusWatcher)
@@ -63,30 +212,24 @@ AbstractTimedJobStatusWatcher::~AbstractTimedJobStatusWatcher() noexcept
 
 Error AbstractTimedJobStatusWatcher::start()
 {
-   // First poll is immediately, and then every Frequency time.
-   Error error = pollJobStatus();
-   if (error)
-      return error;
-
-   // Success full first poll, set up the timed event.
-   WeakThis weakThis = shared_from_this();
-   system::AsioFunction onTimer = [weakThis]()
+   LOCK_MUTEX(m_timedBaseImpl->Mutex)
    {
-      if (SharedThis sharedThis = weakThis.lock())
-      {
-         Error error = sharedThis->pollJobStatus();
-         if (error)
-            sharedThis->m_timedBaseImpl->TimedEvent.reportError(error);
-      }
-   };
-   m_timedBaseImpl->TimedEvent.start(m_timedBaseImpl->Frequency, onTimer);
+      m_timedBaseImpl->IsStopped = false;
+   }
+   END_LOCK_MUTEX
 
-   return Success();
+   // First poll is immediately. Each poll schedules the next, unless it fails.
+   return m_timedBaseImpl->poll(*this);
 }
 
 void AbstractTimedJobStatusWatcher::stop()
 {
-   m_timedBaseImpl->TimedEvent.cancel();
+   LOCK_MUTEX(m_timedBaseImpl->Mutex)
+   {
+      m_timedBaseImpl->IsStopped = true;
+      m_timedBaseImpl->NextPoll.reset();
+   }
+   END_LOCK_MUTEX
 }
 
 AbstractTimedJobStatusWatcher::AbstractTimedJobStatusWatcher(
@@ -94,8 +237,75 @@ AbstractTimedJobStatusWatcher::AbstractTimedJobStatusWatcher(
    JobRepositoryPtr in_jobRepository,
    JobStatusNotifierPtr in_jobStatusNotifier) :
       AbstractJobStatusWatcher(std::move(in_jobRepository), std::move(in_jobStatusNotifier)),
-      m_timedBaseImpl(new Impl(std::move(in_frequency)))
+      m_timedBaseImpl(new Impl(in_frequency, in_frequency))
+{
+}
+
+AbstractTimedJobStatusWatcher::AbstractTimedJobStatusWatcher(
+   system::TimeDuration in_minFrequency,
+   system::TimeDuration in_maxFrequency,
+   JobRepositoryPtr in_jobRepository,
+   JobStatusNotifierPtr in_jobStatusNotifier) :
+      AbstractJobStatusWatcher(std::move(in_jobRepository), std::move(in_jobStatusNotifier)),
+      m_timedBaseImpl(new Impl(std::move(in_minFrequency), std::move(in_maxFrequency)))
+{
+}
+
+bool AbstractTimedJobStatusWatcher::isStatusChanged(
+   const std::string& in_jobId,
+   api::Job::State in_newStatus,
+   const std::string& in_statusMessage)
+{
+   bool isChanged = true;
+   LOCK_MUTEX(m_timedBaseImpl->Mutex)
+   {
+      if (m_timedBaseImpl->IsFullPoll)
+      {
+         auto itr = m_timedBaseImpl->PostedStatuses.find(in_jobId);
+         if ((itr != m_timedBaseImpl->PostedStatuses.end()) &&
+            (itr->second.Status == in_newStatus) &&
+            (itr->second.StatusMessage == in_statusMessage))
+         {
+            itr->second.PollNumber = m_timedBaseImpl->PollNumber;
+            isChanged = false;
+         }
+      }
+   }
+   END_LOCK_MUTEX
+
+   return isChanged;
+}
+
+void AbstractTimedJobStatusWatcher::onStatusUpdated(
+   const std::string& in_jobId,
+   api::Job::State in_newStatus,
+   const std::string& in_statusMessage)
+{
+   LOCK_MUTEX(m_timedBaseImpl->Mutex)
+   {
+      ++m_timedBaseImpl->ChangeCount;
+      if (m_timedBaseImpl->IsFullPoll)
+      {
+         Impl::PostedStatus& posted = m_timedBaseImpl->PostedStatuses[in_jobId];
+         posted.Status = in_newStatus;
+         posted.StatusMessage = in_statusMessage;
+         posted.PollNumber = m_timedBaseImpl->PollNumber;
+      }
+   }
+   END_LOCK_MUTEX
+}
+
+Error AbstractTimedJobStatusWatcher::pollJobStatus()
+{
+   return unknownError(
+      "Timed job status watchers must implement pollJobStatus or pollJobStatusChanges.",
+      ERROR_LOCATION);
+}
+
+Error AbstractTimedJobStatusWatcher::pollJobStatusChanges(const std::string&, std::string& out_nextCursor)
 {
+   out_nextCursor.clear();
+   return pollJobStatus();
 }
 
 } // namespace jobs
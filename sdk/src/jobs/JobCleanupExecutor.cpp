@@ -0,0 +1,210 @@
+/*
+ * JobCleanupExecutor.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "JobCleanupExecutor.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+#include <Error.hpp>
+#include <system/Asio.hpp>
+#include <utils/MutexUtils.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace jobs {
+
+struct JobCleanupExecutor::Impl : public std::enable_shared_from_this<JobCleanupExecutor::Impl>
+{
+   typedef std::shared_ptr<JobCleanupExecutor::Impl> SharedThis;
+   typedef std::weak_ptr<JobCleanupExecutor::Impl> WeakThis;
+
+   Impl(CleanupFunction&& in_cleanup, size_t in_maxConcurrency, size_t in_maxBatchSize) :
+      Cleanup(std::move(in_cleanup)),
+      MaxBatchSize((in_maxBatchSize == 0) ? 1 : in_maxBatchSize),
+      MaxConcurrency((in_maxConcurrency == 0) ? 1 : in_maxConcurrency),
+      RunningBatches(0),
+      ScheduledWorkers(0)
+   {
+   }
+
+   /**
+    * @brief Takes the next batch of jobs from the queue. The mutex must be held by the caller.
+    *
+    * @return The next batch of jobs, which will be empty if the queue is empty.
+    */
+   api::JobList takeBatch()
+   {
+      api::JobList batch;
+      while (!Queue.empty() && (batch.size() < MaxBatchSize))
+      {
+         batch.push_back(Queue.front());
+         Queue.pop_front();
+      }
+
+      if (!batch.empty())
+         ++RunningBatches;
+
+      return batch;
+   }
+
+   /**
+    * @brief Cleans up a batch of jobs and marks it as finished.
+    *
+    * @param in_batch   The batch to clean up.
+    */
+   void runBatch(const api::JobList& in_batch)
+   {
+      try
+      {
+         Cleanup(in_batch);
+      }
+      CATCH_UNEXPECTED_EXCEPTION
+
+      LOCK_MUTEX(Mutex)
+      {
+         --RunningBatches;
+      }
+      END_LOCK_MUTEX
+
+      BatchFinished.notify_all();
+   }
+
+   /**
+    * @brief Schedules a worker on the AsioService.
+    */
+   void schedule()
+   {
+      WeakThis weakThis = shared_from_this();
+      system::AsioService::post(
+         [weakThis]()
+         {
+            if (SharedThis sharedThis = weakThis.lock())
+               sharedThis->work();
+         },
+         system::AsioPriority::LOW);
+   }
+
+   /**
+    * @brief Cleans up one batch, then reschedules itself if more jobs are queued so that other low priority work can
+    *        run in between batches.
+    */
+   void work()
+   {
+      api::JobList batch;
+      LOCK_MUTEX(Mutex)
+      {
+         batch = takeBatch();
+         if (batch.empty())
+            --ScheduledWorkers;
+      }
+      END_LOCK_MUTEX
+
+      if (batch.empty())
+         return;
+
+      runBatch(batch);
+      schedule();
+   }
+
+   /** The function which cleans up a batch of removed jobs. */
+   const CleanupFunction Cleanup;
+
+   /** The maximum number of jobs to clean up in one batch. */
+   const size_t MaxBatchSize;
+
+   /** The maximum number of workers which may be scheduled at once. */
+   const size_t MaxConcurrency;
+
+   /** Protects the members below. */
+   std::mutex Mutex;
+
+   /** Notified when a batch finishes being cleaned up. */
+   std::condition_variable BatchFinished;
+
+   /** The jobs waiting to be cleaned up. */
+   std::deque<api::JobPtr> Queue;
+
+   /** The number of batches being cleaned up right now. */
+   size_t RunningBatches;
+
+   /** The number of workers which are scheduled or running on the AsioService. */
+   size_t ScheduledWorkers;
+};
+
+JobCleanupExecutor::JobCleanupExecutor(
+   CleanupFunction in_cleanup,
+   size_t in_maxConcurrency,
+   size_t in_maxBatchSize) :
+   m_impl(new Impl(std::move(in_cleanup), in_maxConcurrency, in_maxBatchSize))
+{
+}
+
+void JobCleanupExecutor::drain()
+{
+   while (true)
+   {
+      api::JobList batch;
+      UNIQUE_LOCK_MUTEX(m_impl->Mutex)
+      {
+         batch = m_impl->takeBatch();
+
+         // Once nothing is queued, wait for batches being cleaned up by workers. Scheduled workers which haven't started
+         // aren't waited for, since the AsioService may already be stopped; they'll find the queue empty if they run.
+         if (batch.empty())
+         {
+            m_impl->BatchFinished.wait(uniqueLock, [this]() { return m_impl->RunningBatches == 0; });
+            return;
+         }
+      }
+      END_LOCK_MUTEX
+
+      if (batch.empty())
+         return;
+
+      m_impl->runBatch(batch);
+   }
+}
+
+void JobCleanupExecutor::post(const api::JobPtr& in_job)
+{
+   bool scheduleWorker = false;
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      m_impl->Queue.push_back(in_job);
+      if (m_impl->ScheduledWorkers < m_impl->MaxConcurrency)
+      {
+         ++m_impl->ScheduledWorkers;
+         scheduleWorker = true;
+      }
+   }
+   END_LOCK_MUTEX
+
+   if (scheduleWorker)
+      m_impl->schedule();
+}
+
+} // namespace jobs
+} // namespace launcher_plugins
+} // namespace rstudio
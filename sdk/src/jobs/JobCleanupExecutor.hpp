@@ -0,0 +1,86 @@
+/*
+ * JobCleanupExecutor.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_JOB_CLEANUP_EXECUTOR_HPP
+#define LAUNCHER_PLUGINS_JOB_CLEANUP_EXECUTOR_HPP
+
+#include <Noncopyable.hpp>
+
+#include <functional>
+
+#include <PImpl.hpp>
+#include <api/Job.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace jobs {
+
+/**
+ * @brief Runs the clean up of removed jobs in the background, in batches.
+ *
+ * Removed jobs are queued and cleaned up on the low priority lane of the AsioService, so that slow clean up (e.g.
+ * deleting output files) doesn't happen while locks are held. At most a fixed number of batches are cleaned up at
+ * once.
+ */
+class JobCleanupExecutor final : public Noncopyable
+{
+public:
+   /** The function which cleans up a batch of removed jobs. */
+   typedef std::function<void(const api::JobList&)> CleanupFunction;
+
+   /**
+    * @brief Constructor.
+    *
+    * @param in_cleanup             The function which cleans up a batch of removed jobs.
+    * @param in_maxConcurrency      The maximum number of batches to clean up at once.
+    * @param in_maxBatchSize        The maximum number of jobs to clean up in one batch.
+    */
+   explicit JobCleanupExecutor(CleanupFunction in_cleanup, size_t in_maxConcurrency = 2, size_t in_maxBatchSize = 32);
+
+   /**
+    * @brief Cleans up any queued jobs on the calling thread and waits for any batches being cleaned up to finish.
+    *
+    * This does not depend on the AsioService running, so it may be used during shut down.
+    */
+   void drain();
+
+   /**
+    * @brief Queues a removed job to be cleaned up.
+    *
+    * @param in_job     The job which was removed.
+    */
+   void post(const api::JobPtr& in_job);
+
+private:
+   // The private implementation of JobCleanupExecutor.
+   PRIVATE_IMPL_SHARED(m_impl);
+};
+
+/** Convenience Typedef. */
+typedef std::unique_ptr<JobCleanupExecutor> JobCleanupExecutorPtr;
+
+} // namespace jobs
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
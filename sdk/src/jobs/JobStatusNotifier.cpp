@@ -24,10 +24,12 @@
 
 #include <jobs/JobStatusNotifier.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <mutex>
-
-#include <boost/signals2.hpp>
+#include <unordered_map>
+#include <vector>
 
 #include <utils/MutexUtils.hpp>
 
@@ -42,10 +44,191 @@ typedef std::shared_ptr<JobStatusNotifier> SharedThis;
 typedef std::shared_ptr<JobStatusNotifier> Parent;
 typedef std::weak_ptr<JobStatusNotifier> WeakParent;
 
-// Convenience typedefs for signals.
-typedef boost::signals2::connection Connection;
-typedef boost::signals2::signal<void(api::JobPtr)> Signal;
-typedef std::map<std::string, Signal> SignalMap;
+/** The number of shards across which per-job subscribers are spread. */
+constexpr size_t s_shardCount = 16;
+
+/**
+ * @brief A subscriber's callback.
+ */
+struct Subscriber
+{
+   explicit Subscriber(const OnJobStatusUpdate& in_onJobStatusUpdate) :
+      IsConnected(true),
+      OnUpdate(in_onJobStatusUpdate)
+   {
+   }
+
+   explicit Subscriber(const OnJobStatusBatchUpdate& in_onJobStatusUpdates) :
+      IsConnected(true),
+      OnBatchUpdate(in_onJobStatusUpdates)
+   {
+   }
+
+   /** Whether the subscription is still active. A disconnected subscriber may still be in a list being notified. */
+   std::atomic_bool IsConnected;
+
+   /** The function to invoke with all the jobs changed by a batch of updates, if this is a batch subscriber. */
+   const OnJobStatusBatchUpdate OnBatchUpdate;
+
+   /** The function to invoke when a job is updated, if this is not a batch subscriber. */
+   const OnJobStatusUpdate OnUpdate;
+};
+
+// Subscriber lists are never modified once they have been published. Adding or removing a subscriber replaces the
+// list, so notifying subscribers only requires taking a reference to the current list. Old lists are freed once the
+// last notification using them completes.
+typedef std::shared_ptr<Subscriber> SubscriberPtr;
+typedef std::vector<SubscriberPtr> SubscriberList;
+typedef std::shared_ptr<const SubscriberList> SubscriberListPtr;
+
+/**
+ * @brief Creates a copy of a subscriber list with the specified subscriber added.
+ *
+ * @param in_list            The list to copy. May be null.
+ * @param in_subscriber      The subscriber to add.
+ *
+ * @return The new list.
+ */
+SubscriberListPtr addSubscriber(const SubscriberListPtr& in_list, const SubscriberPtr& in_subscriber)
+{
+   std::shared_ptr<SubscriberList> newList = std::make_shared<SubscriberList>();
+   if (in_list)
+   {
+      newList->reserve(in_list->size() + 1);
+      newList->insert(newList->end(), in_list->begin(), in_list->end());
+   }
+
+   newList->push_back(in_subscriber);
+   return newList;
+}
+
+/**
+ * @brief Creates a copy of a subscriber list with the specified subscriber removed.
+ *
+ * @param in_list            The list to copy. May be null.
+ * @param in_subscriber      The subscriber to remove.
+ *
+ * @return The new list, or null if the new list would be empty.
+ */
+SubscriberListPtr removeSubscriber(const SubscriberListPtr& in_list, const SubscriberPtr& in_subscriber)
+{
+   if (!in_list || ((in_list->size() == 1) && (in_list->front() == in_subscriber)))
+      return SubscriberListPtr();
+
+   std::shared_ptr<SubscriberList> newList = std::make_shared<SubscriberList>();
+   newList->reserve(in_list->size());
+   for (const SubscriberPtr& subscriber: *in_list)
+   {
+      if (subscriber != in_subscriber)
+         newList->push_back(subscriber);
+   }
+
+   return newList;
+}
+
+/**
+ * @brief Notifies every connected subscriber in the list.
+ *
+ * @param in_list    The subscribers to notify. May be null.
+ * @param in_job     The job that was updated.
+ */
+void notifySubscribers(const SubscriberListPtr& in_list, const api::JobPtr& in_job)
+{
+   if (!in_list)
+      return;
+
+   for (const SubscriberPtr& subscriber: *in_list)
+   {
+      if (!subscriber->IsConnected.load(std::memory_order_acquire))
+         continue;
+
+      if (subscriber->OnBatchUpdate)
+         subscriber->OnBatchUpdate({ in_job });
+      else
+         subscriber->OnUpdate(in_job);
+   }
+}
+
+/**
+ * @brief Notifies every connected subscriber in the list of a batch of updated jobs.
+ *
+ * @param in_list    The subscribers to notify. May be null.
+ * @param in_jobs    The jobs that were updated.
+ */
+void notifySubscribers(const SubscriberListPtr& in_list, const api::JobList& in_jobs)
+{
+   if (!in_list)
+      return;
+
+   for (const SubscriberPtr& subscriber: *in_list)
+   {
+      if (!subscriber->IsConnected.load(std::memory_order_acquire))
+         continue;
+
+      if (subscriber->OnBatchUpdate)
+         subscriber->OnBatchUpdate(in_jobs);
+      else
+      {
+         for (const api::JobPtr& job: in_jobs)
+         {
+            // The subscription may end part way through the batch.
+            if (!subscriber->IsConnected.load(std::memory_order_acquire))
+               break;
+
+            subscriber->OnUpdate(job);
+         }
+      }
+   }
+}
+
+/**
+ * @brief Sets the status of a job. The job's lock must be held.
+ *
+ * @param io_job                 The job to update.
+ * @param in_newStatus           The new status of the job.
+ * @param in_statusMessage       The new status message of the job.
+ * @param in_invocationTime      The time at which the job was updated.
+ *
+ * @return True if the status or status message of the job changed; false otherwise.
+ */
+bool setJobStatus(
+   api::Job& io_job,
+   api::Job::State in_newStatus,
+   const std::string& in_statusMessage,
+   const system::DateTime& in_invocationTime)
+{
+   // Do nothing if the job has a newer status than this status.
+   if (io_job.LastUpdateTime && (io_job.LastUpdateTime.getValueOr(system::DateTime()) >= in_invocationTime))
+      return false;
+
+   bool isChanged = (io_job.Status != in_newStatus) || (io_job.StatusMessage != in_statusMessage);
+
+   io_job.LastUpdateTime = in_invocationTime;
+   io_job.Status = in_newStatus;
+   io_job.StatusMessage = in_statusMessage;
+
+   return isChanged;
+}
+
+/**
+ * @brief The subscribers of a subset of jobs.
+ */
+struct SubscriberShard
+{
+   SubscriberShard() :
+      JobCount(0)
+   {
+   }
+
+   /** The number of jobs in this shard with subscribers. Allows notifying to skip empty shards without locking. */
+   std::atomic<size_t> JobCount;
+
+   /** Mutex to protect the subscriber map. Only held while looking up or replacing a list of subscribers. */
+   std::mutex Mutex;
+
+   /** The subscribers of each job in this shard. */
+   std::unordered_map<std::string, SubscriberListPtr> JobSubscribers;
+};
 
 } // anonymous namespace
 
@@ -54,14 +237,68 @@ typedef std::map<std::string, Signal> SignalMap;
  */
 struct JobStatusNotifier::Impl
 {
-   /** Signal to be used when something subscribes to all jobs. */
-   Signal AllJobsSignal;
+   /**
+    * @brief Gets the shard which contains the subscribers of the specified job.
+    *
+    * @param in_jobId   The ID of the job.
+    *
+    * @return The shard for the job.
+    */
+   SubscriberShard& getShard(const std::string& in_jobId)
+   {
+      return Shards[std::hash<std::string>()(in_jobId) % s_shardCount];
+   }
+
+   /**
+    * @brief Gets the subscribers of the specified job.
+    *
+    * Only holds the shard lock long enough to take a reference to the job's subscribers, so subscribers may subscribe
+    * or unsubscribe while being notified.
+    *
+    * @param in_jobId   The ID of the job.
+    *
+    * @return The subscribers of the job, if any; null otherwise.
+    */
+   SubscriberListPtr getJobSubscribers(const std::string& in_jobId)
+   {
+      SubscriberListPtr jobSubscribers;
+      SubscriberShard& shard = getShard(in_jobId);
+      if (shard.JobCount.load(std::memory_order_relaxed) > 0)
+      {
+         LOCK_MUTEX(shard.Mutex)
+         {
+            auto itr = shard.JobSubscribers.find(in_jobId);
+            if (itr != shard.JobSubscribers.end())
+               jobSubscribers = itr->second;
+         }
+         END_LOCK_MUTEX
+      }
+
+      return jobSubscribers;
+   }
+
+   /**
+    * @brief Adds a subscriber to all jobs.
+    *
+    * @param in_subscriber      The subscriber to add.
+    */
+   void addAllJobsSubscriber(const SubscriberPtr& in_subscriber)
+   {
+      LOCK_MUTEX(AllJobsMutex)
+      {
+         std::atomic_store(&AllJobsSubscribers, addSubscriber(std::atomic_load(&AllJobsSubscribers), in_subscriber));
+      }
+      END_LOCK_MUTEX
+   }
 
-   /** Map of every signal per job. */
-   SignalMap JobSignalMap;
+   /** The subscribers to all jobs. Must be read and written with std::atomic_load and std::atomic_store. */
+   SubscriberListPtr AllJobsSubscribers;
 
-   /** Mutex to protect map access. */
-   std::recursive_mutex Mutex;
+   /** Mutex to serialize changes to the subscribers to all jobs. */
+   std::mutex AllJobsMutex;
+
+   /** The subscribers to specific jobs. */
+   SubscriberShard Shards[s_shardCount];
 };
 
 PRIVATE_IMPL_DELETER_IMPL(JobStatusNotifier)
@@ -75,13 +312,13 @@ struct Subscription
     * @brief Constructor.
     *
     * @param in_parent          The JobStatusNotifier which created this subscription.
-    * @param in_jobId           The ID of the job  for which this subscription was created.
-    * @param in_connection      The boost signal connection.
+    * @param in_jobId           The ID of the job for which this subscription was created, or empty for all jobs.
+    * @param in_subscriber      The subscriber.
     */
-   Subscription(WeakParent in_parent, std::string in_jobId, Connection in_connection) :
+   Subscription(WeakParent in_parent, std::string in_jobId, SubscriberPtr in_subscriber) :
       m_parent(std::move(in_parent)),
       m_jobId(std::move(in_jobId)),
-      m_connection(std::move(in_connection))
+      m_subscriber(std::move(in_subscriber))
    {
    }
 
@@ -90,19 +327,37 @@ struct Subscription
     */
    ~Subscription()
    {
+      // Stop notifications which are already in progress from reaching the subscriber.
+      m_subscriber->IsConnected.store(false, std::memory_order_release);
+
       if (Parent parent = m_parent.lock())
       {
-         m_connection.disconnect();
-
-         if (!m_jobId.empty())
+         JobStatusNotifier::Impl& impl = *parent->m_impl;
+         if (m_jobId.empty())
+         {
+            LOCK_MUTEX(impl.AllJobsMutex)
+            {
+               std::atomic_store(
+                  &impl.AllJobsSubscribers,
+                  removeSubscriber(std::atomic_load(&impl.AllJobsSubscribers), m_subscriber));
+            }
+            END_LOCK_MUTEX
+         }
+         else
          {
-            UNIQUE_LOCK_RECURSIVE_MUTEX(parent->m_impl->Mutex)
+            SubscriberShard& shard = impl.getShard(m_jobId);
+            LOCK_MUTEX(shard.Mutex)
             {
-               // Check if this is the last subscription to m_jobId. If so, remove the entry from the map.
-               auto itr = parent->m_impl->JobSignalMap.find(m_jobId);
-               if (itr != parent->m_impl->JobSignalMap.end() && itr->second.empty())
+               // If this is the last subscription to m_jobId, remove the entry from the map.
+               auto itr = shard.JobSubscribers.find(m_jobId);
+               if (itr != shard.JobSubscribers.end())
                {
-                  parent->m_impl->JobSignalMap.erase(itr);
+                  itr->second = removeSubscriber(itr->second, m_subscriber);
+                  if (!itr->second)
+                  {
+                     shard.JobSubscribers.erase(itr);
+                     shard.JobCount.fetch_sub(1, std::memory_order_relaxed);
+                  }
                }
             }
             END_LOCK_MUTEX
@@ -114,13 +369,25 @@ private:
    /** The JobStatusNotifier which created this subscription. */
    WeakParent m_parent;
 
-   /** The ID of the job  for which this subscription was created. */
+   /** The ID of the job for which this subscription was created, or empty for all jobs. */
    std::string m_jobId;
 
-   /** The boost signal connection. */
-   Connection m_connection;
+   /** The subscriber. */
+   SubscriberPtr m_subscriber;
 };
 
+JobStatusUpdate::JobStatusUpdate(
+   std::string in_jobId,
+   api::Job::State in_newStatus,
+   std::string in_statusMessage,
+   system::DateTime in_invocationTime) :
+      JobId(std::move(in_jobId)),
+      Status(in_newStatus),
+      StatusMessage(std::move(in_statusMessage)),
+      InvocationTime(std::move(in_invocationTime))
+{
+}
+
 JobStatusNotifier::JobStatusNotifier() :
    m_impl(new Impl())
 {
@@ -128,10 +395,10 @@ JobStatusNotifier::JobStatusNotifier() :
 
 SubscriptionHandle JobStatusNotifier::subscribe(const OnJobStatusUpdate& in_onJobStatusUpdate)
 {
-   return std::make_shared<Subscription>(
-      shared_from_this(),
-      "",
-      m_impl->AllJobsSignal.connect(in_onJobStatusUpdate));
+   SubscriberPtr subscriber = std::make_shared<Subscriber>(in_onJobStatusUpdate);
+   m_impl->addAllJobsSubscriber(subscriber);
+
+   return std::make_shared<Subscription>(shared_from_this(), "", subscriber);
 }
 
 SubscriptionHandle JobStatusNotifier::subscribe(
@@ -143,25 +410,27 @@ SubscriptionHandle JobStatusNotifier::subscribe(
    if (in_jobId.empty() || in_jobId == "*")
       return subscribe(in_onJobStatusUpdate);
 
-   Connection connection;
-
-   // Get a connection. This requires accessing the map, so hold the lock.
-   UNIQUE_LOCK_RECURSIVE_MUTEX(m_impl->Mutex)
+   SubscriberPtr subscriber = std::make_shared<Subscriber>(in_onJobStatusUpdate);
+   SubscriberShard& shard = m_impl->getShard(in_jobId);
+   LOCK_MUTEX(shard.Mutex)
    {
-      auto itr = m_impl->JobSignalMap.find(in_jobId);
-      if (itr == m_impl->JobSignalMap.end())
-      {
-         // If there's no entry for in_jobId yet, make one.
-         auto signalPair = m_impl->JobSignalMap.insert(std::make_pair(in_jobId, Signal()));
-         if (signalPair.second) // Check that insertion was successful. Should always be true because we have the lock.
-            connection = signalPair.first->second.connect(in_onJobStatusUpdate);
-      }
-      else
-         connection = itr->second.connect(in_onJobStatusUpdate);
+      SubscriberListPtr& subscribers = shard.JobSubscribers[in_jobId];
+      if (!subscribers)
+         shard.JobCount.fetch_add(1, std::memory_order_relaxed);
+
+      subscribers = addSubscriber(subscribers, subscriber);
    }
    END_LOCK_MUTEX
 
-   return std::make_shared<Subscription>(shared_from_this(), in_jobId, connection);
+   return std::make_shared<Subscription>(shared_from_this(), in_jobId, subscriber);
+}
+
+SubscriptionHandle JobStatusNotifier::subscribeBatch(const OnJobStatusBatchUpdate& in_onJobStatusUpdates)
+{
+   SubscriberPtr subscriber = std::make_shared<Subscriber>(in_onJobStatusUpdates);
+   m_impl->addAllJobsSubscriber(subscriber);
+
+   return std::make_shared<Subscription>(shared_from_this(), "", subscriber);
 }
 
 void JobStatusNotifier::updateJob(
@@ -172,34 +441,42 @@ void JobStatusNotifier::updateJob(
 {
    LOCK_JOB(in_job)
    {
-      // Do nothing if the job has a newer status than this status.
-      if (in_job->LastUpdateTime &&
-         (in_job->LastUpdateTime.getValueOr(system::DateTime()) >= in_invocationTime))
-         return;
-
-      bool notify = (in_job->Status != in_newStatus) || (in_job->StatusMessage != in_statusMessage);
-
-      in_job->LastUpdateTime = in_invocationTime;
-      in_job->Status = in_newStatus;
-      in_job->StatusMessage = in_statusMessage;
-
       // If there was a meaningful change to the job, notify the listeners.
-      if (notify)
+      if (setJobStatus(*in_job, in_newStatus, in_statusMessage, in_invocationTime))
       {
-         m_impl->AllJobsSignal(in_job);
-
-         UNIQUE_LOCK_RECURSIVE_MUTEX(m_impl->Mutex)
-         {
-            auto itr = m_impl->JobSignalMap.find(in_job->Id);
-            if (itr != m_impl->JobSignalMap.end())
-               itr->second(in_job);
-         }
-         END_LOCK_MUTEX
+         notifySubscribers(std::atomic_load(&m_impl->AllJobsSubscribers), in_job);
+         notifySubscribers(m_impl->getJobSubscribers(in_job->Id), in_job);
       }
    }
    END_LOCK_JOB
 }
 
+void JobStatusNotifier::updateJobs(const api::JobList& in_jobs, const JobStatusUpdates& in_updates)
+{
+   api::JobList changedJobs;
+   const size_t count = std::min(in_jobs.size(), in_updates.size());
+   for (size_t i = 0; i < count; ++i)
+   {
+      const api::JobPtr& job = in_jobs[i];
+      const JobStatusUpdate& update = in_updates[i];
+      LOCK_JOB(job)
+      {
+         if (setJobStatus(*job, update.Status, update.StatusMessage, update.InvocationTime))
+            changedJobs.push_back(job);
+      }
+      END_LOCK_JOB
+   }
+
+   if (changedJobs.empty())
+      return;
+
+   // Subscribers lock each job they read, so the jobs' locks aren't held while notifying them. Otherwise a large batch
+   // would hold every job's lock at once.
+   notifySubscribers(std::atomic_load(&m_impl->AllJobsSubscribers), changedJobs);
+   for (const api::JobPtr& job: changedJobs)
+      notifySubscribers(m_impl->getJobSubscribers(job->Id), job);
+}
+
 } // namespace jobs
 } // namespace launcher_plugins
 } // namespace rstudio
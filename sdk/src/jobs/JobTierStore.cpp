@@ -0,0 +1,307 @@
+/*
+ * JobTierStore.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "JobTierStore.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <Error.hpp>
+#include <logging/Logger.hpp>
+#include <utils/MutexUtils.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace jobs {
+
+namespace {
+
+/**
+ * @brief A memory mapped segment file.
+ */
+struct Segment
+{
+   Segment() : Fd(-1), Mapping(nullptr), Capacity(0), Size(0), LiveBytes(0) { }
+
+   ~Segment()
+   {
+      if (Mapping != nullptr)
+         ::munmap(Mapping, Capacity);
+      if (Fd >= 0)
+         ::close(Fd);
+
+      Error error = File.removeIfExists();
+      if (error)
+         logging::logError(error);
+   }
+
+   /** The file descriptor of the segment file. */
+   int Fd;
+
+   /** The read only mapping of the whole segment file. */
+   char* Mapping;
+
+   /** The size of the segment file and its mapping. */
+   uint64_t Capacity;
+
+   /** The number of bytes which have been written to the segment. */
+   uint64_t Size;
+
+   /** The number of bytes of records which have not been released. */
+   uint64_t LiveBytes;
+
+   /** The segment file. */
+   system::FilePath File;
+};
+
+Error writeAll(int in_fd, const std::string& in_data, uint64_t in_offset)
+{
+   size_t written = 0;
+   while (written < in_data.size())
+   {
+      ssize_t ret = ::pwrite(
+         in_fd,
+         in_data.data() + written,
+         in_data.size() - written,
+         static_cast<off_t>(in_offset + written));
+      if (ret < 0)
+      {
+         if (errno == EINTR)
+            continue;
+         return systemError(errno, ERROR_LOCATION);
+      }
+
+      written += static_cast<size_t>(ret);
+   }
+
+   return Success();
+}
+
+} // anonymous namespace
+
+struct JobTierStore::Impl
+{
+   Impl(system::FilePath in_directory, uint64_t in_maxSegmentSize) :
+      ActiveSegmentId(0),
+      Directory(std::move(in_directory)),
+      LiveBytes(0),
+      MaxSegmentSize(in_maxSegmentSize),
+      NextSegmentId(1)
+   {
+   }
+
+   /**
+    * @brief Creates a new segment and makes it the active segment. The mutex must be held.
+    *
+    * @param in_capacity    The size of the new segment file.
+    *
+    * @return Success if the segment could be created; Error otherwise.
+    */
+   Error startSegment(uint64_t in_capacity)
+   {
+      std::unique_ptr<Segment> segment(new Segment());
+      uint32_t segmentId = 0;
+      while (segment->Fd < 0)
+      {
+         segmentId = NextSegmentId++;
+         system::FilePath file = Directory.completeChildPath("segment-" + std::to_string(segmentId));
+
+         // Never open a file this store didn't create: another store may have it mapped.
+         segment->Fd = ::open(file.getAbsolutePath().c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, S_IRUSR | S_IWUSR);
+         if (segment->Fd >= 0)
+            segment->File = file;
+         else if (errno != EEXIST)
+            return systemError(errno, ERROR_LOCATION);
+      }
+
+      // The file is sparse, so only the written records use disk space.
+      if (::ftruncate(segment->Fd, static_cast<off_t>(in_capacity)) != 0)
+         return systemError(errno, ERROR_LOCATION);
+
+      void* mapping = ::mmap(nullptr, in_capacity, PROT_READ, MAP_SHARED, segment->Fd, 0);
+      if (mapping == MAP_FAILED)
+         return systemError(errno, ERROR_LOCATION);
+
+      segment->Mapping = static_cast<char*>(mapping);
+      segment->Capacity = in_capacity;
+
+      // The previous active segment may be deleted as soon as it has no live records.
+      uint32_t previousId = ActiveSegmentId;
+      ActiveSegmentId = segmentId;
+      Segments[segmentId] = std::move(segment);
+      removeIfUnused(previousId);
+
+      return Success();
+   }
+
+   /**
+    * @brief Deletes a segment if it has no live records and is not the active segment. The mutex must be held.
+    *
+    * @param in_segmentId   The ID of the segment.
+    */
+   void removeIfUnused(uint32_t in_segmentId)
+   {
+      auto itr = Segments.find(in_segmentId);
+      if ((itr != Segments.end()) && (in_segmentId != ActiveSegmentId) && (itr->second->LiveBytes == 0))
+         Segments.erase(itr);
+   }
+
+   /** The segment to which records are appended. */
+   uint32_t ActiveSegmentId;
+
+   /** The directory in which the segment files are created. */
+   system::FilePath Directory;
+
+   /** The number of bytes of records which have not been released, in all segments. */
+   uint64_t LiveBytes;
+
+   /** The size at which to start a new segment file. */
+   uint64_t MaxSegmentSize;
+
+   /** Mutex to protect the segments. */
+   mutable std::mutex Mutex;
+
+   /** The ID of the next segment to create. */
+   uint32_t NextSegmentId;
+
+   /** The segments which may have live records, by ID. */
+   std::map<uint32_t, std::unique_ptr<Segment> > Segments;
+};
+
+PRIVATE_IMPL_DELETER_IMPL(JobTierStore)
+
+JobTierStore::JobTierStore(system::FilePath in_directory, uint64_t in_maxSegmentSize) :
+   m_impl(new Impl(std::move(in_directory), in_maxSegmentSize))
+{
+}
+
+JobTierStore::~JobTierStore()
+{
+   try
+   {
+      // Closes and deletes the segment files, then the directory if nothing else is using it.
+      m_impl->Segments.clear();
+
+      std::vector<system::FilePath> children;
+      Error error = m_impl->Directory.getChildren(children);
+      if (!error && children.empty())
+         error = m_impl->Directory.remove();
+      if (error)
+         logging::logError(error);
+   }
+   catch (...)
+   {
+      // Don't allow exceptions in destructors.
+   }
+}
+
+uint64_t JobTierStore::getLiveBytes() const
+{
+   uint64_t liveBytes = 0;
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      liveBytes = m_impl->LiveBytes;
+   }
+   END_LOCK_MUTEX
+
+   return liveBytes;
+}
+
+Error JobTierStore::initialize()
+{
+   return m_impl->Directory.ensureDirectory();
+}
+
+Error JobTierStore::load(const ColdJobLocation& in_location, std::string& out_data) const
+{
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      auto itr = m_impl->Segments.find(in_location.SegmentId);
+      if ((itr == m_impl->Segments.end()) || (in_location.Offset + in_location.Size > itr->second->Size))
+         return systemError(ENOENT, "Job record not found in the cold tier.", ERROR_LOCATION);
+
+      out_data.assign(itr->second->Mapping + in_location.Offset, in_location.Size);
+   }
+   END_LOCK_MUTEX
+
+   return Success();
+}
+
+void JobTierStore::release(const ColdJobLocation& in_location)
+{
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      auto itr = m_impl->Segments.find(in_location.SegmentId);
+      if (itr == m_impl->Segments.end())
+         return;
+
+      itr->second->LiveBytes -= std::min<uint64_t>(in_location.Size, itr->second->LiveBytes);
+      m_impl->LiveBytes -= std::min<uint64_t>(in_location.Size, m_impl->LiveBytes);
+      m_impl->removeIfUnused(in_location.SegmentId);
+   }
+   END_LOCK_MUTEX
+}
+
+Error JobTierStore::store(const std::string& in_data, ColdJobLocation& out_location)
+{
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      auto itr = m_impl->Segments.find(m_impl->ActiveSegmentId);
+      if ((itr == m_impl->Segments.end()) || (itr->second->Size + in_data.size() > itr->second->Capacity))
+      {
+         Error error = m_impl->startSegment(std::max<uint64_t>(m_impl->MaxSegmentSize, in_data.size()));
+         if (error)
+            return error;
+
+         itr = m_impl->Segments.find(m_impl->ActiveSegmentId);
+      }
+
+      Segment& segment = *itr->second;
+      Error error = writeAll(segment.Fd, in_data, segment.Size);
+      if (error)
+         return error;
+
+      out_location.SegmentId = m_impl->ActiveSegmentId;
+      out_location.Size = static_cast<uint32_t>(in_data.size());
+      out_location.Offset = segment.Size;
+
+      segment.Size += in_data.size();
+      segment.LiveBytes += in_data.size();
+      m_impl->LiveBytes += in_data.size();
+   }
+   END_LOCK_MUTEX
+
+   return Success();
+}
+
+} // namespace jobs
+} // namespace launcher_plugins
+} // namespace rstudio
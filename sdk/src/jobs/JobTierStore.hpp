@@ -0,0 +1,133 @@
+/*
+ * JobTierStore.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef LAUNCHER_PLUGINS_JOB_TIER_STORE_HPP
+#define LAUNCHER_PLUGINS_JOB_TIER_STORE_HPP
+
+#include <Noncopyable.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <PImpl.hpp>
+#include <system/FilePath.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace jobs {
+
+/**
+ * @brief The location of a record in a JobTierStore.
+ */
+struct ColdJobLocation
+{
+   /** The segment in which the record is stored. */
+   uint32_t SegmentId;
+
+   /** The size of the record, in bytes. */
+   uint32_t Size;
+
+   /** The offset of the record within its segment. */
+   uint64_t Offset;
+};
+
+/**
+ * @brief Stores the full details of jobs which are in the cold tier on disk.
+ *
+ * Records are appended to memory mapped segment files in a directory and read back through the mapping. Segment files
+ * are deleted once all of their records have been released. The store is a cache of the job repository: the segment
+ * files it created are deleted when it is destroyed. The store never opens or deletes segment files which it did not
+ * create, so the directory should be unique to the process.
+ */
+class JobTierStore final : public Noncopyable
+{
+public:
+   /**
+    * @brief Constructor.
+    *
+    * @param in_directory           The directory in which to create the segment files.
+    * @param in_maxSegmentSize      The size at which to start a new segment file, in bytes.
+    */
+   explicit JobTierStore(system::FilePath in_directory, uint64_t in_maxSegmentSize = 64 * 1024 * 1024);
+
+   /**
+    * @brief Destructor. Deletes the segment files created by this store, and the directory if it is then empty.
+    */
+   ~JobTierStore();
+
+   /**
+    * @brief Gets the total size of the records which have not been released.
+    *
+    * @return The total size of the records which have not been released, in bytes.
+    */
+   uint64_t getLiveBytes() const;
+
+   /**
+    * @brief Initializes the store, creating its directory if it does not exist.
+    *
+    * @return Success if the directory could be created; Error otherwise.
+    */
+   Error initialize();
+
+   /**
+    * @brief Reads a record.
+    *
+    * @param in_location    The location of the record, as returned by store. The record must not have been released.
+    * @param out_data       The contents of the record.
+    *
+    * @return Success if the record could be read; Error otherwise.
+    */
+   Error load(const ColdJobLocation& in_location, std::string& out_data) const;
+
+   /**
+    * @brief Releases a record which is no longer needed.
+    *
+    * @param in_location    The location of the record, as returned by store.
+    */
+   void release(const ColdJobLocation& in_location);
+
+   /**
+    * @brief Appends a record.
+    *
+    * @param in_data        The contents of the record.
+    * @param out_location   The location of the record.
+    *
+    * @return Success if the record could be written; Error otherwise.
+    */
+   Error store(const std::string& in_data, ColdJobLocation& out_location);
+
+private:
+   // The private implementation of JobTierStore.
+   PRIVATE_IMPL(m_impl);
+};
+
+/** Convenience Typedef. */
+typedef std::unique_ptr<JobTierStore> JobTierStorePtr;
+
+} // namespace jobs
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
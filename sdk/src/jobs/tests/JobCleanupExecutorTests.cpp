@@ -0,0 +1,124 @@
+/*
+ * JobCleanupExecutorTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <TestMain.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <AsioRaii.hpp>
+
+#include "../JobCleanupExecutor.hpp"
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace jobs {
+
+namespace {
+
+api::JobPtr makeJob(int in_id)
+{
+   api::JobPtr job(new api::Job());
+   job->Id = std::to_string(in_id);
+   return job;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Drain without the AsioService")
+{
+   std::vector<size_t> batchSizes;
+   JobCleanupExecutor executor(
+      [&batchSizes](const api::JobList& in_jobs)
+      {
+         batchSizes.push_back(in_jobs.size());
+      },
+      1,
+      4);
+
+   for (int i = 0; i < 10; ++i)
+      executor.post(makeJob(i));
+
+   executor.drain();
+
+   REQUIRE(batchSizes.size() == 3);
+   CHECK(batchSizes[0] == 4);
+   CHECK(batchSizes[1] == 4);
+   CHECK(batchSizes[2] == 2);
+}
+
+TEST_CASE("Clean up in the background")
+{
+   system::AsioRaii init;
+
+   std::mutex mutex;
+   std::atomic<size_t> cleanedUp = { 0 }, running = { 0 }, maxRunning = { 0 };
+   std::vector<std::string> ids;
+   std::vector<size_t> batchSizes;
+
+   JobCleanupExecutor executor(
+      [&](const api::JobList& in_jobs)
+      {
+         size_t nowRunning = running.fetch_add(1) + 1;
+         size_t prevMax = maxRunning.load();
+         while ((nowRunning > prevMax) && !maxRunning.compare_exchange_weak(prevMax, nowRunning));
+
+         std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+         // Catch assertions aren't thread safe, so record what happened and check it once the executor is drained.
+         std::lock_guard<std::mutex> lock(mutex);
+         batchSizes.push_back(in_jobs.size());
+         for (const api::JobPtr& job: in_jobs)
+            ids.push_back(job->Id);
+
+         cleanedUp.fetch_add(in_jobs.size());
+         running.fetch_sub(1);
+      },
+      2,
+      3);
+
+   for (int i = 0; i < 20; ++i)
+      executor.post(makeJob(i));
+
+   for (int i = 0; (i < 100) && (cleanedUp.load() < 20); ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+   executor.drain();
+
+   CHECK(cleanedUp.load() == 20);
+   CHECK(maxRunning.load() <= 2);
+
+   std::lock_guard<std::mutex> lock(mutex);
+   for (size_t batchSize: batchSizes)
+      CHECK(batchSize <= 3);
+
+   std::sort(ids.begin(), ids.end());
+   CHECK(std::unique(ids.begin(), ids.end()) == ids.end());
+}
+
+} // namespace jobs
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -62,15 +62,23 @@ class MockJobRepo : public AbstractJobRepository
 {
 public:
    explicit MockJobRepo(const JobStatusNotifierPtr& in_notifier) :
-      AbstractJobRepository(in_notifier)
+      AbstractJobRepository(in_notifier),
+      FlushCount(0)
    {
    }
 
+   int FlushCount;
+
 private:
    Error loadJobs(api::JobList& out_jobs) const override
    {
       return Success();
    }
+
+   void onFlush() override
+   {
+      ++FlushCount;
+   }
 };
 
 } // anonymous namespace
@@ -214,6 +222,25 @@ TEST_CASE("Multiple jobs")
       CHECK(isEqual(repo->getJob(job5->Id, user2), nullptr));
       CHECK(isEqual(repo->getJobs(user2), expected));
    }
+
+   SECTION("Jobs by ID")
+   {
+      api::JobList expected;
+      expected.push_back(job3);
+      expected.push_back(nullptr);
+      expected.push_back(job1);
+
+      CHECK(isEqual(repo->getJobs(std::vector<std::string>{ job3->Id, "346", job1->Id }), expected));
+   }
+}
+
+TEST_CASE("Flush")
+{
+   JobStatusNotifierPtr notifier(new JobStatusNotifier());
+   std::shared_ptr<MockJobRepo> repo(new MockJobRepo(notifier));
+
+   repo->flush();
+   CHECK(repo->FlushCount == 1);
 }
 
 } // namespace jobs
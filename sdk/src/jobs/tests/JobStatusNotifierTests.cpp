@@ -212,6 +212,135 @@ TEST_CASE("Job Status Notifier")
 
 }
 
+TEST_CASE("Job Status Notifier subscriptions")
+{
+   JobStatusNotifierPtr notifier(new JobStatusNotifier());
+
+   api::JobPtr job1(new api::Job()), job2(new api::Job());
+   job1->Id = "1";
+   job2->Id = "2";
+   job1->Status = api::Job::State::PENDING;
+   job2->Status = api::Job::State::PENDING;
+
+   // Use increasing update times so no update is considered older than the last.
+   system::DateTime now;
+   int updates = 0;
+   auto nextTime = [&now, &updates]() { return now + system::TimeDuration::Seconds(++updates); };
+
+   int allCount = 0, job1CountA = 0, job1CountB = 0, job2Count = 0;
+   SubscriptionHandle allHandle = notifier->subscribe([&allCount](const api::JobPtr&) { ++allCount; });
+   SubscriptionHandle job1HandleA = notifier->subscribe("1", [&job1CountA](const api::JobPtr&) { ++job1CountA; });
+   SubscriptionHandle job1HandleB = notifier->subscribe("1", [&job1CountB](const api::JobPtr&) { ++job1CountB; });
+   SubscriptionHandle job2Handle = notifier->subscribe("2", [&job2Count](const api::JobPtr&) { ++job2Count; });
+
+   notifier->updateJob(job1, api::Job::State::RUNNING, "", nextTime());
+   notifier->updateJob(job2, api::Job::State::RUNNING, "", nextTime());
+
+   CHECK(allCount == 2);
+   CHECK(job1CountA == 1);
+   CHECK(job1CountB == 1);
+   CHECK(job2Count == 1);
+
+   SECTION("Ended subscriptions are not notified")
+   {
+      job1HandleA.reset();
+      allHandle.reset();
+
+      notifier->updateJob(job1, api::Job::State::FINISHED, "", nextTime());
+
+      CHECK(allCount == 2);
+      CHECK(job1CountA == 1);
+      CHECK(job1CountB == 2);
+      CHECK(job2Count == 1);
+   }
+
+   SECTION("Subscriptions may end while being notified")
+   {
+      // The first subscriber to job 2 ends both subscriptions to job 2, so the second shouldn't be notified.
+      int selfCount = 0;
+      SubscriptionHandle selfHandle = notifier->subscribe(
+         "2",
+         [&](const api::JobPtr&)
+         {
+            ++selfCount;
+            selfHandle.reset();
+            job2Handle.reset();
+         });
+
+      job2Handle.reset();
+      job2Handle = notifier->subscribe("2", [&job2Count](const api::JobPtr&) { ++job2Count; });
+
+      notifier->updateJob(job2, api::Job::State::FINISHED, "", nextTime());
+
+      CHECK(selfCount == 1);
+      CHECK(job2Count == 1);
+      CHECK(selfHandle == nullptr);
+      CHECK(job2Handle == nullptr);
+   }
+
+   SECTION("Subscriptions may start while being notified")
+   {
+      int newCount = 0;
+      SubscriptionHandle newHandle;
+      SubscriptionHandle subscribingHandle = notifier->subscribe(
+         "2",
+         [&](const api::JobPtr&)
+         {
+            if (newHandle == nullptr)
+               newHandle = notifier->subscribe("2", [&newCount](const api::JobPtr&) { ++newCount; });
+         });
+
+      notifier->updateJob(job2, api::Job::State::FINISHED, "", nextTime());
+      CHECK(newHandle != nullptr);
+
+      notifier->updateJob(job2, api::Job::State::KILLED, "", nextTime());
+      CHECK(newCount == 1);
+   }
+
+   SECTION("Batch updates")
+   {
+      std::vector<size_t> batchSizes;
+      SubscriptionHandle batchHandle = notifier->subscribeBatch(
+         [&batchSizes](const api::JobList& in_jobs) { batchSizes.push_back(in_jobs.size()); });
+
+      // Job 2's update is older than its current status, so only job 1 changes.
+      notifier->updateJobs(
+         { job1, job2 },
+         {
+            JobStatusUpdate("1", api::Job::State::FINISHED, "", nextTime()),
+            JobStatusUpdate("2", api::Job::State::FINISHED, "", now)
+         });
+
+      CHECK(job1->Status == api::Job::State::FINISHED);
+      CHECK(job2->Status == api::Job::State::RUNNING);
+      CHECK(allCount == 3);
+      CHECK(job1CountA == 2);
+      CHECK(job1CountB == 2);
+      CHECK(job2Count == 1);
+      REQUIRE(batchSizes.size() == 1);
+      CHECK(batchSizes[0] == 1);
+
+      system::DateTime batchTime = nextTime();
+      notifier->updateJobs(
+         { job1, job2 },
+         {
+            JobStatusUpdate("1", api::Job::State::KILLED, "Killed", batchTime),
+            JobStatusUpdate("2", api::Job::State::FINISHED, "", batchTime)
+         });
+
+      CHECK(allCount == 5);
+      CHECK(job1CountA == 3);
+      CHECK(job2Count == 2);
+      REQUIRE(batchSizes.size() == 2);
+      CHECK(batchSizes[1] == 2);
+
+      // Single updates are delivered to batch subscribers as a batch of one.
+      notifier->updateJob(job2, api::Job::State::KILLED, "", nextTime());
+      REQUIRE(batchSizes.size() == 3);
+      CHECK(batchSizes[2] == 1);
+   }
+}
+
 } // namespace jobs
 } // namespace launcher_plugins
 } // namespace rstudio
@@ -0,0 +1,228 @@
+/*
+ * JobTierTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <TestMain.hpp>
+
+#include <AsioRaii.hpp>
+#include <jobs/AbstractJobRepository.hpp>
+#include <system/Asio.hpp>
+#include <system/DateTime.hpp>
+#include <system/FilePath.hpp>
+
+#include "../JobTierStore.hpp"
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace jobs {
+
+namespace {
+
+class MockRepo : public AbstractJobRepository
+{
+public:
+   explicit MockRepo(const JobStatusNotifierPtr& in_notifier) :
+      AbstractJobRepository(in_notifier)
+   {
+   }
+
+private:
+   Error loadJobs(api::JobList&) const override
+   {
+      return Success();
+   }
+};
+
+api::JobPtr makeJob(const std::string& in_id, api::Job::State in_state)
+{
+   system::User user;
+   REQUIRE_FALSE(system::User::getUserFromIdentifier(USER_ONE, user));
+
+   system::DateTime submissionTime;
+   REQUIRE_FALSE(system::DateTime::fromString("2019-12-30T11:34:09.210984", submissionTime));
+
+   api::JobPtr job(new api::Job());
+   job->Id = in_id;
+   job->Name = "Job " + in_id;
+   job->Command = "echo " + in_id;
+   job->Status = in_state;
+   job->SubmissionTime = submissionTime;
+   job->LastUpdateTime = submissionTime;
+   job->User = user;
+   return job;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Job tier store")
+{
+   system::FilePath directory;
+   REQUIRE_FALSE(system::FilePath::uniqueFilePath("/tmp", directory));
+
+   {
+      // Small segments, so each one holds only a couple of records.
+      JobTierStore store(directory, 20);
+      REQUIRE_FALSE(store.initialize());
+
+      ColdJobLocation loc1, loc2, loc3;
+      REQUIRE_FALSE(store.store("first record", loc1));
+      REQUIRE_FALSE(store.store("second", loc2));
+      REQUIRE_FALSE(store.store("third record", loc3));
+      CHECK(store.getLiveBytes() == 30);
+      CHECK(loc1.SegmentId != loc3.SegmentId);
+
+      std::string data;
+      REQUIRE_FALSE(store.load(loc1, data));
+      CHECK(data == "first record");
+      REQUIRE_FALSE(store.load(loc2, data));
+      CHECK(data == "second");
+      REQUIRE_FALSE(store.load(loc3, data));
+      CHECK(data == "third record");
+
+      std::vector<system::FilePath> segments;
+      REQUIRE_FALSE(directory.getChildren(segments));
+      CHECK(segments.size() == 2);
+
+      // Releasing every record in a full segment deletes it.
+      store.release(loc1);
+      store.release(loc2);
+      CHECK(store.getLiveBytes() == 12);
+      segments.clear();
+      REQUIRE_FALSE(directory.getChildren(segments));
+      CHECK(segments.size() == 1);
+   }
+
+   // The store cleans up after itself.
+   CHECK_FALSE(directory.exists());
+}
+
+TEST_CASE("Job tier stores sharing a directory")
+{
+   system::FilePath directory;
+   REQUIRE_FALSE(system::FilePath::uniqueFilePath("/tmp", directory));
+   REQUIRE_FALSE(directory.ensureDirectory());
+
+   // A segment file left by some other store is never truncated or deleted.
+   system::FilePath otherSegment = directory.completeChildPath("segment-1");
+   REQUIRE_FALSE(otherSegment.ensureFile());
+
+   {
+      JobTierStore store1(directory, 20), store2(directory, 20);
+      REQUIRE_FALSE(store1.initialize());
+      REQUIRE_FALSE(store2.initialize());
+
+      ColdJobLocation loc1, loc2;
+      REQUIRE_FALSE(store1.store("first record", loc1));
+      REQUIRE_FALSE(store2.store("second record", loc2));
+
+      std::string data;
+      REQUIRE_FALSE(store1.load(loc1, data));
+      CHECK(data == "first record");
+      REQUIRE_FALSE(store2.load(loc2, data));
+      CHECK(data == "second record");
+
+      std::vector<system::FilePath> segments;
+      REQUIRE_FALSE(directory.getChildren(segments));
+      CHECK(segments.size() == 3);
+   }
+
+   std::vector<system::FilePath> segments;
+   REQUIRE_FALSE(directory.getChildren(segments));
+   REQUIRE(segments.size() == 1);
+   CHECK(segments[0] == otherSegment);
+   CHECK_FALSE(directory.removeIfExists());
+}
+
+TEST_CASE("Demote and promote idle jobs")
+{
+   system::AsioRaii init;
+
+   system::FilePath directory;
+   REQUIRE_FALSE(system::FilePath::uniqueFilePath("/tmp", directory));
+
+   JobStatusNotifierPtr notifier(new JobStatusNotifier());
+   JobRepositoryPtr jobRepo(new MockRepo(notifier));
+   REQUIRE_FALSE(jobRepo->initialize());
+   REQUIRE_FALSE(jobRepo->enableTiering(directory, system::TimeDuration::Seconds(1)));
+
+   jobRepo->addJob(makeJob("1", api::Job::State::FINISHED));
+   jobRepo->addJob(makeJob("2", api::Job::State::RUNNING));
+
+   // A job which is in use outside of the repository stays in memory.
+   api::JobPtr inUse = makeJob("3", api::Job::State::FAILED);
+   jobRepo->addJob(inUse);
+
+   sleep(2);
+
+   api::JobList summaries = jobRepo->getJobSummaries();
+   REQUIRE(summaries.size() == 3);
+   for (const api::JobPtr& job: summaries)
+   {
+      CHECK(job->Name == "Job " + job->Id);
+      if (job->Id == "1")
+         CHECK(job->Command.empty());
+      else
+         CHECK(job->Command == "echo " + job->Id);
+   }
+   summaries.clear();
+
+   // Reading every job loads the full details without moving them back into memory.
+   api::JobList jobs = jobRepo->getJobs();
+   REQUIRE(jobs.size() == 3);
+   for (const api::JobPtr& job: jobs)
+      CHECK(job->Command == "echo " + job->Id);
+   jobs.clear();
+
+   CHECK(jobRepo->getJobSummaries().front()->Command.empty());
+
+   // Reading jobs by ID, as the status watchers do, doesn't move them back into memory either.
+   jobs = jobRepo->getJobs(std::vector<std::string>{ "1", "4" });
+   REQUIRE(jobs.size() == 2);
+   REQUIRE(jobs[0] != nullptr);
+   CHECK(jobs[0]->Command == "echo 1");
+   CHECK(jobs[1] == nullptr);
+   jobs.clear();
+
+   CHECK(jobRepo->getJobSummaries().front()->Command.empty());
+
+   // Reading the job moves it back into memory.
+   api::JobPtr job = jobRepo->getJob("1");
+   REQUIRE(job != nullptr);
+   CHECK(job->Command == "echo 1");
+   CHECK(job->Status == api::Job::State::FINISHED);
+   CHECK(jobRepo->getJob("1") == job);
+   CHECK(jobRepo->getJobSummaries().front() == job);
+
+   system::User otherUser;
+   REQUIRE_FALSE(system::User::getUserFromIdentifier(USER_TWO, otherUser));
+   CHECK(jobRepo->getJob("1", otherUser) == nullptr);
+
+   job.reset();
+   inUse.reset();
+   jobRepo.reset();
+   CHECK_FALSE(directory.remove());
+}
+
+} // namespace jobs
+} // namespace launcher_plugins
+} // namespace rstudio
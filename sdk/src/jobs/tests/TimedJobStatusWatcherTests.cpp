@@ -25,6 +25,10 @@
 
 #include <jobs/AbstractTimedJobStatusWatcher.hpp>
 
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
 #include <AsioRaii.hpp>
 
 namespace rstudio {
@@ -100,15 +104,191 @@ private:
    }
 };
 
+class SnapshotJobStatusWatcher : public AbstractTimedJobStatusWatcher
+{
+public:
+   SnapshotJobStatusWatcher(uint64_t in_freqSeconds, JobRepositoryPtr in_jobRepo, JobStatusNotifierPtr in_notifier) :
+      AbstractTimedJobStatusWatcher(
+         system::TimeDuration::Seconds(in_freqSeconds),
+         std::move(in_jobRepo),
+         std::move(in_notifier)),
+      PollCount(0)
+   {
+   }
+
+   std::atomic<uint64_t> PollCount;
+
+private:
+   Error pollJobStatus() override
+   {
+      // The job finishes on the third poll. Every poll reports every job.
+      uint64_t pollCount = ++PollCount;
+      updateJobStatus("1", api::Job::State::RUNNING);
+      return updateJobStatus("2", (pollCount < 3) ? api::Job::State::RUNNING : api::Job::State::FINISHED);
+   }
+
+   Error getJobDetails(const std::string&, api::JobPtr&) const override
+   {
+      return Error("NotSupported", 1, "NotSupported", ERROR_LOCATION);
+   }
+};
+
+class DeltaJobStatusWatcher : public AbstractTimedJobStatusWatcher
+{
+public:
+   DeltaJobStatusWatcher(uint64_t in_freqSeconds, JobRepositoryPtr in_jobRepo, JobStatusNotifierPtr in_notifier) :
+      AbstractTimedJobStatusWatcher(
+         system::TimeDuration::Seconds(in_freqSeconds),
+         std::move(in_jobRepo),
+         std::move(in_notifier))
+   {
+   }
+
+   std::vector<std::string> Cursors;
+
+private:
+   Error pollJobStatusChanges(const std::string& in_cursor, std::string& out_nextCursor) override
+   {
+      Cursors.push_back(in_cursor);
+      out_nextCursor = "c" + std::to_string(Cursors.size());
+
+      return updateJobStatus("1", api::Job::State::RUNNING);
+   }
+
+   Error getJobDetails(const std::string&, api::JobPtr&) const override
+   {
+      return Error("NotSupported", 1, "NotSupported", ERROR_LOCATION);
+   }
+};
+
+class AdaptiveJobStatusWatcher : public AbstractTimedJobStatusWatcher
+{
+public:
+   AdaptiveJobStatusWatcher(JobRepositoryPtr in_jobRepo, JobStatusNotifierPtr in_notifier) :
+      AbstractTimedJobStatusWatcher(
+         system::TimeDuration::Seconds(1),
+         system::TimeDuration::Seconds(4),
+         std::move(in_jobRepo),
+         std::move(in_notifier)),
+      PollCount(0)
+   {
+   }
+
+   std::atomic<uint64_t> PollCount;
+
+private:
+   Error pollJobStatus() override
+   {
+      ++PollCount;
+      return Success();
+   }
+
+   Error getJobDetails(const std::string&, api::JobPtr&) const override
+   {
+      return Error("NotSupported", 1, "NotSupported", ERROR_LOCATION);
+   }
+};
+
+class BatchJobStatusWatcher : public AbstractTimedJobStatusWatcher
+{
+public:
+   BatchJobStatusWatcher(JobRepositoryPtr in_jobRepo, JobStatusNotifierPtr in_notifier) :
+      AbstractTimedJobStatusWatcher(
+         system::TimeDuration::Seconds(1),
+         std::move(in_jobRepo),
+         std::move(in_notifier))
+   {
+   }
+
+   Error post(const JobStatusUpdates& in_updates)
+   {
+      return updateJobStatuses(in_updates);
+   }
+
+   mutable std::vector<std::vector<std::string> > DetailsRequests;
+
+private:
+   Error pollJobStatus() override
+   {
+      return Success();
+   }
+
+   Error getJobDetails(const std::string&, api::JobPtr&) const override
+   {
+      return Error("NotSupported", 1, "NotSupported", ERROR_LOCATION);
+   }
+
+   Error getBatchJobDetails(const std::vector<std::string>& in_jobIds, api::JobList& out_jobs) const override
+   {
+      // Only job 10 exists in the scheduler.
+      DetailsRequests.push_back(in_jobIds);
+      for (const std::string& jobId: in_jobIds)
+      {
+         if (jobId == "10")
+         {
+            api::JobPtr job(new api::Job());
+            job->Id = jobId;
+            job->Status = api::Job::State::PENDING;
+            out_jobs.push_back(job);
+         }
+      }
+
+      return Success();
+   }
+};
+
+class SlowDetailsJobStatusWatcher : public AbstractTimedJobStatusWatcher
+{
+public:
+   SlowDetailsJobStatusWatcher(JobRepositoryPtr in_jobRepo, JobStatusNotifierPtr in_notifier) :
+      AbstractTimedJobStatusWatcher(
+         system::TimeDuration::Seconds(1),
+         std::move(in_jobRepo),
+         std::move(in_notifier)),
+      DetailsCount(0)
+   {
+   }
+
+   Error post(const std::string& in_jobId, api::Job::State in_status)
+   {
+      return updateJobStatus(in_jobId, in_status);
+   }
+
+   mutable std::atomic<int> DetailsCount;
+
+private:
+   Error pollJobStatus() override
+   {
+      return Success();
+   }
+
+   Error getJobDetails(const std::string& in_jobId, api::JobPtr& out_job) const override
+   {
+      ++DetailsCount;
+      sleep(1);
+      if (in_jobId == "missing")
+         return Error("NotFound", 1, "NotFound", ERROR_LOCATION);
+      if (in_jobId == "throws")
+         throw std::runtime_error("Could not reach the job scheduling system.");
+
+      out_job.reset(new api::Job());
+      out_job->Id = in_jobId;
+      out_job->Status = api::Job::State::PENDING;
+      return Success();
+   }
+};
+
 TEST_CASE("Timed Job Status Watcher Tests")
 {
+   // The Asio service can't be restarted once it has been stopped, so each scenario runs in sequence within a single
+   // test case instead of in separate sections.
    system::AsioRaii init;
 
    // Job repo and status notifier.
    JobStatusNotifierPtr notifier(new JobStatusNotifier());
    JobRepositoryPtr repo(new MockJobRepo(notifier));
 
-   SECTION("No polling errors")
+   // No polling errors.
    {
       std::shared_ptr<MockJobStatusWatcher> watcher(new MockJobStatusWatcher(2, repo, notifier));
       REQUIRE_FALSE(watcher->start());
@@ -118,13 +298,180 @@ TEST_CASE("Timed Job Status Watcher Tests")
       CHECK(watcher->PollCount == 4);
    }
 
-   SECTION("Polling errors")
+   // Polling errors.
    {
       std::shared_ptr<ErrorJobStatusWatcher> watcher(new ErrorJobStatusWatcher(1, repo, notifier));
       CHECK(watcher->start());; // Error on first poll.
       sleep(2); // Shouldn't be anymore polls.
       CHECK(watcher->PollCount == 1);
    }
+
+   api::JobPtr job1(new api::Job()), job2(new api::Job());
+   job1->Id = "1";
+   job1->Status = api::Job::State::PENDING;
+   job2->Id = "2";
+   job2->Status = api::Job::State::PENDING;
+   repo->addJob(job1);
+   repo->addJob(job2);
+
+   std::atomic<int> job1Updates(0), job2Updates(0);
+   SubscriptionHandle handle1 = notifier->subscribe("1", [&job1Updates](const api::JobPtr&) { ++job1Updates; });
+   SubscriptionHandle handle2 = notifier->subscribe("2", [&job2Updates](const api::JobPtr&) { ++job2Updates; });
+
+   // Unchanged statuses are not posted.
+   {
+      std::shared_ptr<SnapshotJobStatusWatcher> watcher(new SnapshotJobStatusWatcher(1, repo, notifier));
+      REQUIRE_FALSE(watcher->start());
+      sleep(4);
+      watcher->stop();
+      sleep(1);
+
+      CHECK(watcher->PollCount >= 4);
+      CHECK(job1Updates == 1);
+      CHECK(job2Updates == 2);
+      CHECK(job2->Status == api::Job::State::FINISHED);
+   }
+
+   // Delta polling.
+   {
+      std::shared_ptr<DeltaJobStatusWatcher> watcher(new DeltaJobStatusWatcher(1, repo, notifier));
+      REQUIRE_FALSE(watcher->start());
+      sleep(2);
+      watcher->stop();
+      sleep(1);
+
+      REQUIRE(watcher->Cursors.size() >= 2);
+      CHECK(watcher->Cursors[0].empty());
+      for (size_t i = 1; i < watcher->Cursors.size(); ++i)
+         CHECK(watcher->Cursors[i] == "c" + std::to_string(i));
+   }
+
+   // Adaptive frequency.
+   {
+      // Polls find no changes, so they happen at 0, ~2 and ~6 seconds.
+      std::shared_ptr<AdaptiveJobStatusWatcher> watcher(new AdaptiveJobStatusWatcher(repo, notifier));
+      REQUIRE_FALSE(watcher->start());
+      sleep(7);
+      watcher->stop();
+      CHECK(watcher->PollCount == 3);
+   }
+}
+
+TEST_CASE("Batch Job Status Updates")
+{
+   JobStatusNotifierPtr notifier(new JobStatusNotifier());
+   JobRepositoryPtr repo(new MockJobRepo(notifier));
+
+   api::JobPtr job1(new api::Job()), job2(new api::Job());
+   job1->Id = "1";
+   job1->Status = api::Job::State::PENDING;
+   job2->Id = "2";
+   job2->Status = api::Job::State::PENDING;
+   repo->addJob(job1);
+   repo->addJob(job2);
+
+   std::vector<size_t> batchSizes;
+   SubscriptionHandle handle = notifier->subscribeBatch(
+      [&batchSizes](const api::JobList& in_jobs) { batchSizes.push_back(in_jobs.size()); });
+
+   std::shared_ptr<BatchJobStatusWatcher> watcher(new BatchJobStatusWatcher(repo, notifier));
+
+   // Jobs 10 and 11 aren't in the repository, so their details are requested together. Job 11 can't be found.
+   Error error = watcher->post({
+      JobStatusUpdate("1", api::Job::State::RUNNING),
+      JobStatusUpdate("10", api::Job::State::RUNNING),
+      JobStatusUpdate("2", api::Job::State::FINISHED),
+      JobStatusUpdate("11", api::Job::State::RUNNING) });
+
+   CHECK(error);
+   REQUIRE(watcher->DetailsRequests.size() == 1);
+   CHECK(watcher->DetailsRequests[0] == std::vector<std::string>{ "10", "11" });
+   CHECK(job1->Status == api::Job::State::RUNNING);
+   CHECK(job2->Status == api::Job::State::FINISHED);
+   REQUIRE(batchSizes.size() == 1);
+   CHECK(batchSizes[0] == 3);
+
+   // Unchanged statuses don't notify subscribers.
+   CHECK_FALSE(watcher->post({
+      JobStatusUpdate("1", api::Job::State::RUNNING),
+      JobStatusUpdate("2", api::Job::State::FINISHED) }));
+   CHECK(batchSizes.size() == 1);
+}
+
+TEST_CASE("Concurrent Job Details Retrieval")
+{
+   JobStatusNotifierPtr notifier(new JobStatusNotifier());
+   JobRepositoryPtr repo(new MockJobRepo(notifier));
+   std::shared_ptr<SlowDetailsJobStatusWatcher> watcher(new SlowDetailsJobStatusWatcher(repo, notifier));
+
+   std::atomic<int> updates(0);
+   SubscriptionHandle handle = notifier->subscribe("5", [&updates](const api::JobPtr&) { ++updates; });
+
+   // Every thread sees the new job at once, but its details are only retrieved once.
+   std::atomic<int> errors(0);
+   std::vector<std::thread> threads;
+   for (int i = 0; i < 4; ++i)
+   {
+      threads.emplace_back([&watcher, &errors]()
+      {
+         if (watcher->post("5", api::Job::State::RUNNING))
+            ++errors;
+      });
+   }
+
+   for (std::thread& thread: threads)
+      thread.join();
+
+   CHECK(errors == 0);
+   CHECK(watcher->DetailsCount == 1);
+   CHECK(updates == 1);
+
+   // Recently retrieved details are reused.
+   CHECK_FALSE(watcher->post("5", api::Job::State::FINISHED));
+   CHECK(watcher->DetailsCount == 1);
+   CHECK(updates == 2);
+
+   // Failures are shared by the waiting callers, but aren't reused.
+   threads.clear();
+   for (int i = 0; i < 2; ++i)
+   {
+      threads.emplace_back([&watcher, &errors]()
+      {
+         if (watcher->post("missing", api::Job::State::RUNNING))
+            ++errors;
+      });
+   }
+
+   for (std::thread& thread: threads)
+      thread.join();
+
+   CHECK(errors == 2);
+   CHECK(watcher->DetailsCount == 2);
+
+   CHECK(watcher->post("missing", api::Job::State::RUNNING));
+   CHECK(watcher->DetailsCount == 3);
+
+   // If retrieving the details throws, the waiting callers get the error rather than waiting forever.
+   threads.clear();
+   errors = 0;
+   for (int i = 0; i < 2; ++i)
+   {
+      threads.emplace_back([&watcher, &errors]()
+      {
+         if (watcher->post("throws", api::Job::State::RUNNING))
+            ++errors;
+      });
+   }
+
+   for (std::thread& thread: threads)
+      thread.join();
+
+   CHECK(errors == 2);
+   CHECK(watcher->DetailsCount == 4);
+
+   // Nothing is left in flight, so the details are retrieved again.
+   CHECK(watcher->post("throws", api::Job::State::RUNNING));
+   CHECK(watcher->DetailsCount == 5);
 }
 
 } // namespace jobs
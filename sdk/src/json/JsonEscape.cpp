@@ -0,0 +1,201 @@
+/*
+ * JsonEscape.cpp
+ *
+ * Copyright (C) 2022 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include "JsonEscape.hpp"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace json {
+
+namespace {
+
+/** The hex digits used by \u escape sequences. */
+const char s_hexDigits[] = "0123456789ABCDEF";
+
+/** The character which follows the backslash when escaping each control character. */
+const char s_controlEscapes[0x20] = {
+   'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+   'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u'
+};
+
+/**
+ * @brief Function which finds the next byte of a string which must be escaped.
+ *
+ * @param in_value       The string to search.
+ * @param in_pos         The position from which to search.
+ * @param in_length      The length of the string.
+ *
+ * @return The position of the next byte which must be escaped, or in_length if there is none.
+ */
+typedef size_t (*FindEscapeFunc)(const char* in_value, size_t in_pos, size_t in_length);
+
+inline bool needsEscape(unsigned char in_char)
+{
+   return (in_char < 0x20) || (in_char == '"') || (in_char == '\\');
+}
+
+// Each of the following is a FindEscapeFunc. The vectorized searches check 16 or 32 bytes at a time and finish the last
+// partial block with the scalar search.
+size_t findEscapeScalar(const char* in_value, size_t in_pos, size_t in_length)
+{
+   while ((in_pos < in_length) && !needsEscape(static_cast<unsigned char>(in_value[in_pos])))
+      ++in_pos;
+
+   return in_pos;
+}
+
+#if defined(__SSE2__)
+
+size_t findEscapeSse2(const char* in_value, size_t in_pos, size_t in_length)
+{
+   const __m128i quote = _mm_set1_epi8('"');
+   const __m128i backslash = _mm_set1_epi8('\\');
+   const __m128i maxControl = _mm_set1_epi8(0x1F);
+
+   for (; in_pos + 16 <= in_length; in_pos += 16)
+   {
+      __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in_value + in_pos));
+
+      // There's no unsigned comparison, but a byte is a control character if it is unchanged by min(byte, 0x1F).
+      __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(chunk, maxControl), chunk);
+      __m128i isEscaped = _mm_or_si128(
+         _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+         isControl);
+
+      uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(isEscaped));
+      if (mask != 0)
+         return in_pos + __builtin_ctz(mask);
+   }
+
+   return findEscapeScalar(in_value, in_pos, in_length);
+}
+
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+
+__attribute__((target("avx2")))
+size_t findEscapeAvx2(const char* in_value, size_t in_pos, size_t in_length)
+{
+   const __m256i quote = _mm256_set1_epi8('"');
+   const __m256i backslash = _mm256_set1_epi8('\\');
+   const __m256i maxControl = _mm256_set1_epi8(0x1F);
+
+   for (; in_pos + 32 <= in_length; in_pos += 32)
+   {
+      __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in_value + in_pos));
+
+      __m256i isControl = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, maxControl), chunk);
+      __m256i isEscaped = _mm256_or_si256(
+         _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+         isControl);
+
+      uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(isEscaped));
+      if (mask != 0)
+         return in_pos + __builtin_ctz(mask);
+   }
+
+   return findEscapeScalar(in_value, in_pos, in_length);
+}
+
+#endif
+
+/**
+ * @brief Selects the fastest search which the CPU supports.
+ *
+ * @return The search function.
+ */
+FindEscapeFunc selectFindEscape()
+{
+#if defined(__x86_64__) || defined(__i386__)
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+      return &findEscapeAvx2;
+#endif
+
+#if defined(__SSE2__)
+   return &findEscapeSse2;
+#else
+   return &findEscapeScalar;
+#endif
+}
+
+/**
+ * @brief Appends the escape sequence of a byte which must be escaped.
+ *
+ * @param in_char        The byte to escape.
+ * @param io_json        The JSON document to which the escape sequence should be appended.
+ */
+void appendEscape(unsigned char in_char, std::string& io_json)
+{
+   if ((in_char == '"') || (in_char == '\\'))
+   {
+      const char escape[] = { '\\', static_cast<char>(in_char) };
+      io_json.append(escape, sizeof(escape));
+   }
+   else if (s_controlEscapes[in_char] != 'u')
+   {
+      const char escape[] = { '\\', s_controlEscapes[in_char] };
+      io_json.append(escape, sizeof(escape));
+   }
+   else
+   {
+      const char escape[] = { '\\', 'u', '0', '0', s_hexDigits[in_char >> 4], s_hexDigits[in_char & 0xF] };
+      io_json.append(escape, sizeof(escape));
+   }
+}
+
+} // anonymous namespace
+
+void appendEscapedString(const char* in_value, size_t in_length, std::string& io_json)
+{
+   static const FindEscapeFunc findEscape = selectFindEscape();
+
+   // Most output needs little escaping, so reserve a little more than the string itself.
+   io_json.reserve(io_json.size() + in_length + (in_length / 16) + 2);
+   io_json.push_back('"');
+
+   size_t pos = 0;
+   while (pos < in_length)
+   {
+      size_t escapePos = findEscape(in_value, pos, in_length);
+      io_json.append(in_value + pos, escapePos - pos);
+      if (escapePos == in_length)
+         break;
+
+      appendEscape(static_cast<unsigned char>(in_value[escapePos]), io_json);
+      pos = escapePos + 1;
+   }
+
+   io_json.push_back('"');
+}
+
+} // namespace json
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -0,0 +1,51 @@
+/*
+ * JsonEscape.hpp
+ *
+ * Copyright (C) 2022 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_JSON_ESCAPE_HPP
+#define LAUNCHER_PLUGINS_JSON_ESCAPE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace json {
+
+/**
+ * @brief Appends a string to a JSON document as a quoted and escaped JSON string.
+ *
+ * The string is escaped exactly as the JSON writer would escape it: quotes, backslashes, and control characters are
+ * escaped and all other bytes are copied as they are. Runs of bytes which do not need escaping are found 16 or 32 bytes
+ * at a time when the CPU supports it, and copied in bulk.
+ *
+ * @param in_value       The string to append.
+ * @param in_length      The length of the string to append, in bytes.
+ * @param io_json        The JSON document to which the string should be appended.
+ */
+void appendEscapedString(const char* in_value, size_t in_length, std::string& io_json);
+
+} // namespace json
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
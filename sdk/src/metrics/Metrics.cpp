@@ -0,0 +1,445 @@
+/*
+ * Metrics.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <metrics/Metrics.hpp>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <sstream>
+
+#include <Error.hpp>
+#include <logging/Logger.hpp>
+#include <system/Asio.hpp>
+#include <system/DateTime.hpp>
+#include <system/FilePath.hpp>
+#include <utils/FileUtils.hpp>
+#include <utils/MutexUtils.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace metrics {
+
+namespace {
+
+/** The number of linear sub-buckets per power of two, as a power of two. */
+constexpr unsigned int s_subBucketBits = 3;
+
+/** The number of linear sub-buckets per power of two. */
+constexpr uint64_t s_subBucketCount = 1 << s_subBucketBits;
+
+/** The number of bits of the largest trackable value. Larger values are counted in the last bucket. */
+constexpr unsigned int s_maxValueBits = 40;
+
+/** The total number of buckets. */
+constexpr size_t s_numBuckets = (s_maxValueBits - s_subBucketBits + 1) * s_subBucketCount;
+
+constexpr size_t s_numRequestTypes = static_cast<size_t>(api::Request::Type::INVALID);
+constexpr size_t s_numStages = static_cast<size_t>(RequestStage::TOTAL) + 1;
+
+size_t getBucketIndex(uint64_t in_value)
+{
+   if (in_value < s_subBucketCount)
+      return in_value;
+
+   unsigned int msb = 63 - __builtin_clzll(in_value);
+   if (msb >= s_maxValueBits)
+      return s_numBuckets - 1;
+
+   unsigned int shift = msb - s_subBucketBits;
+   return ((shift + 1) * s_subBucketCount) + ((in_value >> shift) - s_subBucketCount);
+}
+
+uint64_t getBucketUpperBound(size_t in_index)
+{
+   if (in_index < s_subBucketCount)
+      return in_index;
+
+   unsigned int shift = (in_index / s_subBucketCount) - 1;
+   uint64_t subBucket = (in_index % s_subBucketCount) + s_subBucketCount;
+   return ((subBucket + 1) << shift) - 1;
+}
+
+const char* getRequestTypeLabel(size_t in_type)
+{
+   switch (static_cast<api::Request::Type>(in_type))
+   {
+      case api::Request::Type::HEARTBEAT:
+         return "heartbeat";
+      case api::Request::Type::BOOTSTRAP:
+         return "bootstrap";
+      case api::Request::Type::SUBMIT_JOB:
+         return "submit_job";
+      case api::Request::Type::GET_JOB:
+         return "get_job";
+      case api::Request::Type::GET_JOB_STATUS:
+         return "get_job_status";
+      case api::Request::Type::CONTROL_JOB:
+         return "control_job";
+      case api::Request::Type::GET_JOB_OUTPUT:
+         return "get_job_output";
+      case api::Request::Type::GET_JOB_RESOURCE_UTIL:
+         return "get_job_resource_util";
+      case api::Request::Type::GET_JOB_NETWORK:
+         return "get_job_network";
+      case api::Request::Type::GET_CLUSTER_INFO:
+         return "get_cluster_info";
+      default:
+         return "invalid";
+   }
+}
+
+const char* getStageLabel(size_t in_stage)
+{
+   switch (static_cast<RequestStage>(in_stage))
+   {
+      case RequestStage::PARSE:
+         return "parse";
+      case RequestStage::QUEUE:
+         return "queue";
+      case RequestStage::HANDLE:
+         return "handle";
+      case RequestStage::TOTAL:
+         return "total";
+      default:
+         return "unknown";
+   }
+}
+
+/** Whether metrics collection is enabled. */
+std::atomic<bool> s_enabled(false);
+
+/** Throughput counters. */
+std::atomic<uint64_t> s_bytesReceived(0);
+std::atomic<uint64_t> s_framesReceived(0);
+std::atomic<uint64_t> s_bytesSent(0);
+std::atomic<uint64_t> s_framesSent(0);
+
+/** The number of blocks of data waiting to be written to AsioStreams. */
+std::atomic<int64_t> s_streamWriteQueueDepth(0);
+
+/** The sizes of the job repository tiers. */
+std::atomic<uint64_t> s_hotJobs(0);
+std::atomic<uint64_t> s_coldJobs(0);
+std::atomic<uint64_t> s_coldJobBytes(0);
+
+/**
+ * @brief The state of the metrics file exporter and the request latency histograms, which are only allocated when
+ *        metrics are enabled.
+ */
+struct MetricsState
+{
+   /** The request latency histograms, by request type and stage. */
+   std::array<std::array<std::unique_ptr<LatencyHistogram>, s_numStages>, s_numRequestTypes> Histograms;
+
+   /** The file to which metrics are written. */
+   system::FilePath MetricsFile;
+
+   /** The timed event which writes the metrics file. */
+   std::unique_ptr<system::AsyncTimedEvent> ExportEvent;
+
+   /** Mutex which ensures the metrics file is only written by one thread at a time. */
+   std::mutex Mutex;
+};
+
+MetricsState& getMetricsState()
+{
+   static MetricsState state;
+   return state;
+}
+
+Error writeMetricsFile()
+{
+   MetricsState& state = getMetricsState();
+   Error error;
+   LOCK_MUTEX(state.Mutex)
+   {
+      // Write to a temporary file and then move it, so that readers never see a partially written file.
+      system::FilePath tmpFile(state.MetricsFile.getAbsolutePath() + ".tmp");
+      error = utils::writeStringToFile(getPrometheusText(), tmpFile);
+      if (!error)
+         error = tmpFile.move(state.MetricsFile, system::FilePath::MoveDirect, true);
+   }
+   END_LOCK_MUTEX
+
+   return error;
+}
+
+void writeCounter(std::ostream& in_stream, const char* in_name, const char* in_help, uint64_t in_value)
+{
+   in_stream << "# HELP " << in_name << " " << in_help << "\n"
+             << "# TYPE " << in_name << " counter\n"
+             << in_name << " " << in_value << "\n";
+}
+
+} // anonymous namespace
+
+// LatencyHistogram ====================================================================================================
+struct LatencyHistogram::Impl
+{
+   Impl() :
+      Count(0),
+      Sum(0)
+   {
+      for (std::atomic<uint64_t>& bucket: Buckets)
+         bucket.store(0, std::memory_order_relaxed);
+   }
+
+   /** The number of values in each bucket. */
+   std::array<std::atomic<uint64_t>, s_numBuckets> Buckets;
+
+   /** The number of recorded values. */
+   std::atomic<uint64_t> Count;
+
+   /** The sum of the recorded values. */
+   std::atomic<uint64_t> Sum;
+};
+
+PRIVATE_IMPL_DELETER_IMPL(LatencyHistogram)
+
+LatencyHistogram::LatencyHistogram() :
+   m_impl(new Impl())
+{
+}
+
+void LatencyHistogram::record(uint64_t in_value)
+{
+   m_impl->Buckets[getBucketIndex(in_value)].fetch_add(1, std::memory_order_relaxed);
+   m_impl->Count.fetch_add(1, std::memory_order_relaxed);
+   m_impl->Sum.fetch_add(in_value, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+   return m_impl->Count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getSum() const
+{
+   return m_impl->Sum.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getValueAtQuantile(double in_quantile) const
+{
+   // The count may be updated while this is running, so take a snapshot of the buckets and count them instead.
+   std::array<uint64_t, s_numBuckets> snapshot;
+   uint64_t total = 0;
+   for (size_t i = 0; i < s_numBuckets; ++i)
+   {
+      snapshot[i] = m_impl->Buckets[i].load(std::memory_order_relaxed);
+      total += snapshot[i];
+   }
+
+   if (total == 0)
+      return 0;
+
+   double quantile = std::min(1.0, std::max(0.0, in_quantile));
+   uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * total)));
+
+   uint64_t seen = 0;
+   for (size_t i = 0; i < s_numBuckets; ++i)
+   {
+      seen += snapshot[i];
+      if (seen >= rank)
+         return getBucketUpperBound(i);
+   }
+
+   return getBucketUpperBound(s_numBuckets - 1);
+}
+
+// Metrics =============================================================================================================
+bool isEnabled()
+{
+   return s_enabled.load(std::memory_order_acquire);
+}
+
+Error start(const system::FilePath& in_metricsFile, const system::TimeDuration& in_interval)
+{
+   MetricsState& state = getMetricsState();
+   if (isEnabled())
+      return Success();
+
+   for (auto& stages: state.Histograms)
+      for (std::unique_ptr<LatencyHistogram>& histogram: stages)
+         histogram.reset(new LatencyHistogram());
+
+   s_enabled.store(true, std::memory_order_release);
+
+   if (in_metricsFile.isEmpty())
+      return Success();
+
+   state.MetricsFile = in_metricsFile;
+   Error error = writeMetricsFile();
+   if (error)
+      return error;
+
+   state.ExportEvent.reset(new system::AsyncTimedEvent());
+   state.ExportEvent->start(
+      in_interval,
+      []()
+      {
+         Error error = writeMetricsFile();
+         if (error)
+            logging::logError(error);
+      });
+
+   return Success();
+}
+
+void stop()
+{
+   MetricsState& state = getMetricsState();
+   if (!state.ExportEvent)
+      return;
+
+   state.ExportEvent->cancel();
+   Error error = writeMetricsFile();
+   if (error)
+      logging::logError(error);
+}
+
+std::string getPrometheusText()
+{
+   std::ostringstream stream;
+   writeCounter(stream, "rlps_bytes_received_total", "Bytes received from the Launcher.", s_bytesReceived.load());
+   writeCounter(stream, "rlps_frames_received_total", "Frames received from the Launcher.", s_framesReceived.load());
+   writeCounter(stream, "rlps_bytes_sent_total", "Bytes sent to the Launcher.", s_bytesSent.load());
+   writeCounter(stream, "rlps_frames_sent_total", "Frames sent to the Launcher.", s_framesSent.load());
+
+   stream << "# HELP rlps_stream_write_queue_depth Blocks of data waiting to be written to streams.\n"
+          << "# TYPE rlps_stream_write_queue_depth gauge\n"
+          << "rlps_stream_write_queue_depth " << s_streamWriteQueueDepth.load() << "\n";
+
+   stream << "# HELP rlps_jobs Jobs in the job repository, by storage tier.\n"
+          << "# TYPE rlps_jobs gauge\n"
+          << "rlps_jobs{tier=\"hot\"} " << s_hotJobs.load() << "\n"
+          << "rlps_jobs{tier=\"cold\"} " << s_coldJobs.load() << "\n"
+          << "# HELP rlps_job_cold_tier_bytes Bytes of job details stored in the cold tier.\n"
+          << "# TYPE rlps_job_cold_tier_bytes gauge\n"
+          << "rlps_job_cold_tier_bytes " << s_coldJobBytes.load() << "\n";
+
+   const std::pair<system::AsioPriority, const char*> lanes[] = {
+      { system::AsioPriority::HIGH, "high" },
+      { system::AsioPriority::NORMAL, "normal" },
+      { system::AsioPriority::LOW, "low" } };
+
+   std::ostringstream depth, runs, totalWait, maxWait;
+   for (const auto& lane: lanes)
+   {
+      system::AsioQueueStats stats = system::AsioService::getQueueStats(lane.first);
+      std::string label = std::string("{lane=\"") + lane.second + "\"} ";
+      depth << "rlps_asio_queue_depth" << label << stats.QueuedCount << "\n";
+      runs << "rlps_asio_queue_runs_total" << label << stats.CompletedCount << "\n";
+      totalWait << "rlps_asio_queue_wait_microseconds_total" << label << stats.TotalWaitMicroseconds << "\n";
+      maxWait << "rlps_asio_queue_max_wait_microseconds" << label << stats.MaxWaitMicroseconds << "\n";
+   }
+
+   stream << "# HELP rlps_asio_queue_depth Work items waiting in each AsioService priority lane.\n"
+          << "# TYPE rlps_asio_queue_depth gauge\n" << depth.str()
+          << "# HELP rlps_asio_queue_runs_total Work items run from each AsioService priority lane.\n"
+          << "# TYPE rlps_asio_queue_runs_total counter\n" << runs.str()
+          << "# HELP rlps_asio_queue_wait_microseconds_total Time work items spent waiting in each priority lane.\n"
+          << "# TYPE rlps_asio_queue_wait_microseconds_total counter\n" << totalWait.str()
+          << "# HELP rlps_asio_queue_max_wait_microseconds Longest time a work item spent waiting in each priority lane.\n"
+          << "# TYPE rlps_asio_queue_max_wait_microseconds gauge\n" << maxWait.str();
+
+   if (!isEnabled())
+      return stream.str();
+
+   stream << "# HELP rlps_request_duration_microseconds Time spent in each stage of handling Launcher requests.\n"
+          << "# TYPE rlps_request_duration_microseconds summary\n";
+
+   const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+   const MetricsState& state = getMetricsState();
+   for (size_t type = 0; type < s_numRequestTypes; ++type)
+   {
+      for (size_t stage = 0; stage < s_numStages; ++stage)
+      {
+         const LatencyHistogram& histogram = *state.Histograms[type][stage];
+         if (histogram.getCount() == 0)
+            continue;
+
+         std::string labels =
+            std::string("type=\"") + getRequestTypeLabel(type) + "\",stage=\"" + getStageLabel(stage) + "\"";
+         for (double quantile: quantiles)
+            stream << "rlps_request_duration_microseconds{" << labels << ",quantile=\"" << quantile << "\"} "
+                   << histogram.getValueAtQuantile(quantile) << "\n";
+
+         stream << "rlps_request_duration_microseconds_sum{" << labels << "} " << histogram.getSum() << "\n"
+                << "rlps_request_duration_microseconds_count{" << labels << "} " << histogram.getCount() << "\n";
+      }
+   }
+
+   return stream.str();
+}
+
+void recordRequestStage(api::Request::Type in_type, RequestStage in_stage, uint64_t in_microseconds)
+{
+   size_t type = static_cast<size_t>(in_type);
+   if (!isEnabled() || (type >= s_numRequestTypes))
+      return;
+
+   getMetricsState().Histograms[type][static_cast<size_t>(in_stage)]->record(in_microseconds);
+}
+
+void recordBytesReceived(size_t in_bytes)
+{
+   if (isEnabled())
+      s_bytesReceived.fetch_add(in_bytes, std::memory_order_relaxed);
+}
+
+void recordFramesReceived(size_t in_frames)
+{
+   if (isEnabled())
+      s_framesReceived.fetch_add(in_frames, std::memory_order_relaxed);
+}
+
+void recordFrameSent(size_t in_bytes)
+{
+   if (isEnabled())
+   {
+      s_framesSent.fetch_add(1, std::memory_order_relaxed);
+      s_bytesSent.fetch_add(in_bytes, std::memory_order_relaxed);
+   }
+}
+
+void adjustStreamWriteQueueDepth(int64_t in_delta)
+{
+   if (isEnabled())
+      s_streamWriteQueueDepth.fetch_add(in_delta, std::memory_order_relaxed);
+}
+
+void setJobTierSizes(size_t in_hotJobs, size_t in_coldJobs, uint64_t in_coldBytes)
+{
+   if (isEnabled())
+   {
+      s_hotJobs.store(in_hotJobs, std::memory_order_relaxed);
+      s_coldJobs.store(in_coldJobs, std::memory_order_relaxed);
+      s_coldJobBytes.store(in_coldBytes, std::memory_order_relaxed);
+   }
+}
+
+} // namespace metrics
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -0,0 +1,143 @@
+/*
+ * MetricsTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <TestMain.hpp>
+
+#include <Error.hpp>
+#include <metrics/Metrics.hpp>
+#include <system/Asio.hpp>
+#include <system/DateTime.hpp>
+#include <system/FilePath.hpp>
+#include <utils/FileUtils.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace metrics {
+
+TEST_CASE("Empty histogram")
+{
+   LatencyHistogram histogram;
+   CHECK(histogram.getCount() == 0);
+   CHECK(histogram.getSum() == 0);
+   CHECK(histogram.getValueAtQuantile(0.5) == 0);
+   CHECK(histogram.getValueAtQuantile(0.99) == 0);
+}
+
+TEST_CASE("Histogram quantiles")
+{
+   LatencyHistogram histogram;
+   uint64_t sum = 0;
+   for (uint64_t i = 1; i <= 10000; ++i)
+   {
+      histogram.record(i);
+      sum += i;
+   }
+
+   CHECK(histogram.getCount() == 10000);
+   CHECK(histogram.getSum() == sum);
+
+   // Each reported value should be at least the exact value, and no more than 12.5% above it.
+   const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+   for (double quantile: quantiles)
+   {
+      uint64_t exact = static_cast<uint64_t>(quantile * 10000);
+      uint64_t value = histogram.getValueAtQuantile(quantile);
+      CHECK(value >= exact);
+      CHECK(value <= exact + exact / 8);
+   }
+
+   CHECK(histogram.getValueAtQuantile(1.0) >= 10000);
+}
+
+TEST_CASE("Histogram small and large values")
+{
+   LatencyHistogram histogram;
+   histogram.record(0);
+   histogram.record(3);
+   histogram.record(uint64_t(1) << 50);
+
+   CHECK(histogram.getCount() == 3);
+   CHECK(histogram.getValueAtQuantile(0.3) == 0);
+   CHECK(histogram.getValueAtQuantile(0.5) == 3);
+   CHECK(histogram.getValueAtQuantile(1.0) > 0);
+}
+
+TEST_CASE("Metrics are not recorded while disabled")
+{
+   REQUIRE_FALSE(isEnabled());
+
+   recordRequestStage(api::Request::Type::GET_JOB, RequestStage::TOTAL, 100);
+   recordBytesReceived(100);
+
+   std::string text = getPrometheusText();
+   CHECK(text.find("rlps_bytes_received_total 0\n") != std::string::npos);
+   CHECK(text.find("rlps_request_duration_microseconds") == std::string::npos);
+}
+
+TEST_CASE("Metrics are written to the metrics file")
+{
+   system::AsioService::startThreads(1);
+
+   system::FilePath metricsFile;
+   REQUIRE_FALSE(system::FilePath::tempFilePath(".prom", metricsFile));
+   REQUIRE_FALSE(start(metricsFile, system::TimeDuration::Seconds(60)));
+   CHECK(isEnabled());
+
+   std::string contents;
+   REQUIRE(metricsFile.exists());
+   REQUIRE_FALSE(utils::readFileIntoString(metricsFile, contents));
+   CHECK(contents.find("# TYPE rlps_frames_received_total counter\n") != std::string::npos);
+   CHECK(contents.find("rlps_asio_queue_depth{lane=\"high\"} ") != std::string::npos);
+
+   recordBytesReceived(128);
+   recordFramesReceived(2);
+   recordFrameSent(64);
+   recordRequestStage(api::Request::Type::GET_JOB, RequestStage::PARSE, 10);
+   recordRequestStage(api::Request::Type::GET_JOB, RequestStage::TOTAL, 100);
+   recordRequestStage(api::Request::Type::GET_JOB, RequestStage::TOTAL, 300);
+
+   stop();
+
+   REQUIRE_FALSE(utils::readFileIntoString(metricsFile, contents));
+   CHECK(contents.find("rlps_bytes_received_total 128\n") != std::string::npos);
+   CHECK(contents.find("rlps_frames_received_total 2\n") != std::string::npos);
+   CHECK(contents.find("rlps_bytes_sent_total 64\n") != std::string::npos);
+   CHECK(contents.find("rlps_frames_sent_total 1\n") != std::string::npos);
+   CHECK(contents.find("# TYPE rlps_request_duration_microseconds summary\n") != std::string::npos);
+   CHECK(contents.find("rlps_request_duration_microseconds_count{type=\"get_job\",stage=\"total\"} 2\n") !=
+      std::string::npos);
+   CHECK(contents.find("rlps_request_duration_microseconds_sum{type=\"get_job\",stage=\"total\"} 400\n") !=
+      std::string::npos);
+   CHECK(contents.find("rlps_request_duration_microseconds_count{type=\"get_job\",stage=\"parse\"} 1\n") !=
+      std::string::npos);
+   CHECK(contents.find("type=\"heartbeat\"") == std::string::npos);
+
+   CHECK_FALSE(metricsFile.remove());
+
+   system::AsioService::stop();
+   system::AsioService::waitForExit();
+}
+
+} // namespace metrics
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -24,9 +24,12 @@
 #include <options/AbstractUserProfiles.hpp>
 
 #include <cassert>
+#include <chrono>
 #include <grp.h>
 #include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include <boost/regex.hpp>
 #include <boost/algorithm/string.hpp>
@@ -35,9 +38,11 @@
 
 #include <Error.hpp>
 #include <SafeConvert.hpp>
+#include <logging/Logger.hpp>
 #include <system/User.hpp>
 #include <system/FilePath.hpp>
 #include <utils/FileUtils.hpp>
+#include <utils/MutexUtils.hpp>
 
 namespace rstudio {
 namespace launcher_plugins {
@@ -55,6 +60,9 @@ enum class UserProfileError
    INVALID_VALUE_ERROR = 4,
 };
 
+// How often to check whether the profiles configuration file has been modified.
+constexpr std::chrono::seconds s_modifiedCheckInterval(5);
+
 Error userProfileError(
    UserProfileError in_code,
    const std::string& in_message,
@@ -293,9 +301,23 @@ typedef std::map<Group, GroupMembers> GroupLookupMap;
 typedef std::map<std::string, std::string> ValueMap;
 typedef std::pair<Level, ValueMap> LevelValue;
 
+/**
+ * @brief The values from every section of the ini file which apply to a particular user.
+ */
+struct ResolvedProfile
+{
+   /** The primary group of the user when the profile was resolved. */
+   system::GidType GroupId;
+
+   /** The most specific instance of each value which applies to the user. */
+   ValueMap Values;
+};
+
 // Impl Struct =========================================================================================================
 struct AbstractUserProfiles::Impl
 {
+   Impl() : ConfigurationWriteTime(0) { }
+
    /**
     * @brief Gets the most specific instance of a value for the given user.
     *
@@ -317,6 +339,14 @@ struct AbstractUserProfiles::Impl
     */
    bool isInGroup(const system::User& in_user, const std::string& in_groupName) const;
 
+   /**
+    * @brief Finds the most specific instance of every value which applies to the given user.
+    *
+    * @param in_user            The user for whom to resolve values.
+    * @param out_profile        The resolved values for the user.
+    */
+   void resolveProfile(const system::User& in_user, ResolvedProfile& out_profile) const;
+
    /**
     * @brief Iterates all sections of the ini and applies the in_onValueFound function to any values that were found.
     *
@@ -349,6 +379,16 @@ struct AbstractUserProfiles::Impl
     */
    Error populateGroups(const std::set<std::string>& in_groupNames);
 
+   /**
+    * @brief Re-reads the user profiles configuration file if it has been modified since it was last read.
+    *
+    * The file is checked at most once every few seconds. If the modified file cannot be parsed or fails validation,
+    * the error is logged and the previously loaded values continue to be used.
+    *
+    * @param in_profiles        The user profiles which own this implementation, used to validate the new values.
+    */
+   void reloadIfModified(const AbstractUserProfiles& in_profiles);
+
    /** Cached unix group information so we don't need to get it each time. */
    GroupLookupMap Groups;
 
@@ -357,6 +397,18 @@ struct AbstractUserProfiles::Impl
 
    /** The configuration file. */
    system::FilePath ConfigurationFile;
+
+   /** The last write time of the configuration file when it was read. */
+   std::time_t ConfigurationWriteTime;
+
+   /** The next time at which to check whether the configuration file has been modified. */
+   std::chrono::steady_clock::time_point NextModifiedCheck;
+
+   /** The resolved values of each user who has been looked up, by username. */
+   mutable std::unordered_map<std::string, ResolvedProfile> ResolvedProfiles;
+
+   /** Mutex which protects the resolved profiles and reloading of the configuration file. */
+   mutable std::mutex Mutex;
 };
 
 PRIVATE_IMPL_DELETER_IMPL(AbstractUserProfiles)
@@ -366,37 +418,28 @@ bool AbstractUserProfiles::Impl::getValueForUser(
    const system::User& in_user,
    std::string& out_value) const
 {
-   LevelType specificity = LevelType::NONE;
-   const std::string* value = nullptr;
-
-   // Within the same category (e.g. if a user belongs to multiple groups) the last matching entry will be applied.
-   for (const LevelValue& levelValue : LevelValues)
+   LOCK_MUTEX(Mutex)
    {
-      // If the level is less specific than the most recently found value, skip this entry.
-      if (levelValue.first.Type < specificity)
-         continue;
-
-      // If the level is a group level and the user isn't in the group, skip this entry.
-      if ((levelValue.first.Type == LevelType::GROUP) && !isInGroup(in_user, levelValue.first.Name))
-         continue;
-
-      // If the level is a user level and it's not for this user, skip this entry.
-      if ((levelValue.first.Type == LevelType::USER) && (levelValue.first.Name != in_user.getUsername()))
-         continue;
+      // Re-resolve the profile if the user's primary group has changed, since it may affect which groups apply.
+      auto profileItr = ResolvedProfiles.find(in_user.getUsername());
+      if (profileItr == ResolvedProfiles.end())
+      {
+         profileItr = ResolvedProfiles.insert(std::make_pair(in_user.getUsername(), ResolvedProfile())).first;
+         resolveProfile(in_user, profileItr->second);
+      }
+      else if (profileItr->second.GroupId != in_user.getGroupId())
+         resolveProfile(in_user, profileItr->second);
 
-      specificity = levelValue.first.Type;
+      const auto itr = profileItr->second.Values.find(in_valueName);
+      if (itr == profileItr->second.Values.end())
+         return false;
 
-      // Otherwise this level applies to the user. Try to find the value
-      const auto itr = levelValue.second.find(in_valueName);
-      if (itr != levelValue.second.end())
-         value = &(itr->second);
+      out_value = itr->second;
+      return true;
    }
+   END_LOCK_MUTEX
 
-   if (value == nullptr)
-      return false;
-
-   out_value = *value;
-   return true;
+   return false;
 }
 
 bool AbstractUserProfiles::Impl::isInGroup(const system::User& in_user, const std::string& in_groupName) const
@@ -413,6 +456,36 @@ bool AbstractUserProfiles::Impl::isInGroup(const system::User& in_user, const st
    return ((itr->second.find(in_user.getUsername()) != itr->second.end()) || (itr->first.Id == in_user.getGroupId()));
 }
 
+void AbstractUserProfiles::Impl::resolveProfile(const system::User& in_user, ResolvedProfile& out_profile) const
+{
+   out_profile.GroupId = in_user.getGroupId();
+   out_profile.Values.clear();
+
+   LevelType specificity = LevelType::NONE;
+
+   // Within the same category (e.g. if a user belongs to multiple groups) the last matching entry will be applied.
+   for (const LevelValue& levelValue : LevelValues)
+   {
+      // If the level is less specific than the most recently applied level, skip this entry.
+      if (levelValue.first.Type < specificity)
+         continue;
+
+      // If the level is a group level and the user isn't in the group, skip this entry.
+      if ((levelValue.first.Type == LevelType::GROUP) && !isInGroup(in_user, levelValue.first.Name))
+         continue;
+
+      // If the level is a user level and it's not for this user, skip this entry.
+      if ((levelValue.first.Type == LevelType::USER) && (levelValue.first.Name != in_user.getUsername()))
+         continue;
+
+      specificity = levelValue.first.Type;
+
+      // Otherwise this level applies to the user, so its values override any found so far.
+      for (const auto& value: levelValue.second)
+         out_profile.Values[value.first] = value.second;
+   }
+}
+
 Error AbstractUserProfiles::Impl::iterateValues(
    const std::string& in_valueName,
    const std::function<Error (const std::string&)>& in_onValueFound) const
@@ -561,6 +634,65 @@ Error AbstractUserProfiles::Impl::populateGroups(const std::set<std::string>& in
    return Success();
 }
 
+void AbstractUserProfiles::Impl::reloadIfModified(const AbstractUserProfiles& in_profiles)
+{
+   const system::FilePath& configFile = in_profiles.getConfigurationFile();
+   std::time_t writeTime = 0;
+   LOCK_MUTEX(Mutex)
+   {
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      if (now < NextModifiedCheck)
+         return;
+
+      NextModifiedCheck = now + s_modifiedCheckInterval;
+      if (!configFile.exists())
+         return;
+
+      writeTime = configFile.getLastWriteTime();
+      if (writeTime == ConfigurationWriteTime)
+         return;
+   }
+   END_LOCK_MUTEX
+
+   if (writeTime == 0)
+      return;
+
+   std::string iniFileContents;
+   Error error = utils::readFileIntoString(configFile, iniFileContents);
+   if (error)
+   {
+      logging::logError(error);
+      return;
+   }
+
+   LOCK_MUTEX(Mutex)
+   {
+      GroupLookupMap groups;
+      std::vector<LevelValue> levelValues;
+      groups.swap(Groups);
+      levelValues.swap(LevelValues);
+
+      error = parseLevels(iniFileContents, in_profiles.getValidFieldNames());
+      if (!error)
+         error = in_profiles.validateValues();
+
+      // Keep using the last good configuration if the new one is invalid.
+      if (error)
+      {
+         Groups.swap(groups);
+         LevelValues.swap(levelValues);
+         error.addProperty("file", configFile.getAbsolutePath());
+         logging::logError(error);
+      }
+      else
+         ResolvedProfiles.clear();
+
+      // Either way, don't try again until the file is modified again.
+      ConfigurationWriteTime = writeTime;
+   }
+   END_LOCK_MUTEX
+}
+
 // AbstractUserProfiles ================================================================================================
 Error AbstractUserProfiles::initialize()
 {
@@ -580,6 +712,8 @@ Error AbstractUserProfiles::initialize()
    if (error)
       return error;
 
+   m_impl->ConfigurationWriteTime = getConfigurationFile().getLastWriteTime();
+   m_impl->NextModifiedCheck = std::chrono::steady_clock::now() + s_modifiedCheckInterval;
    return validateValues();
 }
 
@@ -608,6 +742,8 @@ Error AbstractUserProfiles::getValueForUser(
          "The requested value \"" + in_valueName + "\" is not supported.",
          ERROR_LOCATION);
 
+   m_impl->reloadIfModified(*this);
+
    std::string strValue;
    if (!m_impl->getValueForUser(in_valueName, in_user, strValue))
       return userProfileError(
@@ -272,13 +272,21 @@ struct Options::Impl
       IsInitialized(false),
       EnableDebugLogging(false),
       JobExpiryHours(0),
+      JobTieringIdleSeconds(0),
       HeartbeatIntervalSeconds(0),
       LauncherConfigFile(""),
       MaxLogLevel(logging::LogLevel::OFF),
+      MetricsFile(""),
+      MetricsIntervalSeconds(0),
       ScratchPath(""),
       ServerUser(),
       LoggingDir(""),
-      ThreadPoolSize(0)
+      ThreadPoolSize(0),
+      ThreadPoolPinThreads(false),
+      ThreadPoolWorkStealing(false),
+      TimerSlackMilliseconds(0),
+      UserCacheNegativeTtlSeconds(0),
+      UserCacheTtlSeconds(0)
    { };
 
    void initialize()
@@ -294,6 +302,9 @@ struct Options::Impl
             ("job-expiry-hours",
                value<unsigned int>(&JobExpiryHours)->default_value(24),
                "amount of hours before completed jobs are removed from the system")
+            ("job-tiering-idle-seconds",
+               value<unsigned int>(&JobTieringIdleSeconds)->default_value(0),
+               "the amount of seconds after which unchanged completed jobs have their details moved to disk - 0 to disable")
             ("heartbeat-interval-seconds",
                value<unsigned int>(&HeartbeatIntervalSeconds)->default_value(5),
                "the amount of seconds between heartbeats - 0 to disable")
@@ -306,6 +317,12 @@ struct Options::Impl
             ("max-message-size",
                value<size_t>(&MaxMessageSize)->default_value(5242880),
                "the maximum size of a message which can be sent to or received from the RStudio Launcher")
+            ("metrics-file",
+               value<system::FilePath>(&MetricsFile)->default_value(system::FilePath()),
+               "file to which request metrics are written in the Prometheus text format - empty to disable metrics")
+            ("metrics-interval-seconds",
+               value<unsigned int>(&MetricsIntervalSeconds)->default_value(15),
+               "the amount of seconds between writes of the metrics file")
             ("plugin-name",
                value<std::string>(&PluginName)->default_value(""),
                "the name of this plugin")
@@ -321,6 +338,21 @@ struct Options::Impl
             ("thread-pool-size",
                value<size_t>(&ThreadPoolSize)->default_value(std::max<size_t>(4, std::thread::hardware_concurrency())),
                "the number of threads in the thread pool")
+            ("thread-pool-pin-threads",
+               value<bool>(&ThreadPoolPinThreads)->default_value(false),
+               "whether to pin each thread in the thread pool to a CPU core")
+            ("thread-pool-work-stealing",
+               value<bool>(&ThreadPoolWorkStealing)->default_value(false),
+               "whether each thread in the thread pool should have its own work queue and steal work when idle")
+            ("timer-slack-milliseconds",
+               value<unsigned int>(&TimerSlackMilliseconds)->default_value(10),
+               "the amount of milliseconds by which timed events may be delayed so that nearby events run together")
+            ("user-cache-negative-ttl-seconds",
+               value<unsigned int>(&UserCacheNegativeTtlSeconds)->default_value(30),
+               "the amount of seconds for which users that could not be found are cached - 0 to disable")
+            ("user-cache-ttl-seconds",
+               value<unsigned int>(&UserCacheTtlSeconds)->default_value(300),
+               "the amount of seconds for which user details are cached - 0 to disable")
             ("unprivileged",
                value<bool>(&UseUnprivilegedMode)->default_value(false),
                "special unprivileged mode - does not change user, runs without root, no impersonation, single user")
@@ -344,16 +376,24 @@ struct Options::Impl
    // Option Members.
    bool EnableDebugLogging;
    unsigned int JobExpiryHours;
+   unsigned int JobTieringIdleSeconds;
    unsigned int HeartbeatIntervalSeconds;
    system::FilePath LauncherConfigFile;
    logging::LogLevel MaxLogLevel;
    size_t MaxMessageSize;
+   system::FilePath MetricsFile;
+   unsigned int MetricsIntervalSeconds;
    std::string PluginName;
    system::FilePath RSandboxPath;
    system::FilePath ScratchPath;
    system::FilePath LoggingDir;
    std::string ServerUser;
    size_t ThreadPoolSize;
+   bool ThreadPoolPinThreads;
+   bool ThreadPoolWorkStealing;
+   unsigned int TimerSlackMilliseconds;
+   unsigned int UserCacheNegativeTtlSeconds;
+   unsigned int UserCacheTtlSeconds;
    bool UseUnprivilegedMode;
 };
 
@@ -483,6 +523,11 @@ system::TimeDuration Options::getJobExpiryHours() const
    return system::TimeDuration::Hours(m_impl->JobExpiryHours);
 }
 
+system::TimeDuration Options::getJobTieringIdleSeconds() const
+{
+   return system::TimeDuration::Seconds(m_impl->JobTieringIdleSeconds);
+}
+
 system::TimeDuration Options::getHeartbeatIntervalSeconds() const
 {
    return system::TimeDuration::Seconds(m_impl->HeartbeatIntervalSeconds);
@@ -505,6 +550,16 @@ size_t Options::getMaxMessageSize() const
    return m_impl->MaxMessageSize;
 }
 
+const system::FilePath& Options::getMetricsFile() const
+{
+   return m_impl->MetricsFile;
+}
+
+system::TimeDuration Options::getMetricsIntervalSeconds() const
+{
+   return system::TimeDuration::Seconds(m_impl->MetricsIntervalSeconds);
+}
+
 const system::FilePath& Options::getRSandboxPath() const
 {
    return m_impl->RSandboxPath;
@@ -528,6 +583,31 @@ size_t Options::getThreadPoolSize() const
    return m_impl->ThreadPoolSize;
 }
 
+bool Options::pinThreadPoolThreads() const
+{
+   return m_impl->ThreadPoolPinThreads;
+}
+
+bool Options::useWorkStealingThreadPool() const
+{
+   return m_impl->ThreadPoolWorkStealing;
+}
+
+system::TimeDuration Options::getTimerSlackMilliseconds() const
+{
+   return system::TimeDuration::Microseconds(static_cast<int64_t>(m_impl->TimerSlackMilliseconds) * 1000);
+}
+
+system::TimeDuration Options::getUserCacheNegativeTtlSeconds() const
+{
+   return system::TimeDuration::Seconds(m_impl->UserCacheNegativeTtlSeconds);
+}
+
+system::TimeDuration Options::getUserCacheTtlSeconds() const
+{
+   return system::TimeDuration::Seconds(m_impl->UserCacheTtlSeconds);
+}
+
 bool Options::useUnprivilegedMode() const
 {
    return m_impl->UseUnprivilegedMode;
@@ -23,12 +23,16 @@
 
 #include <TestMain.hpp>
 
+#include <chrono>
+#include <thread>
+
 #include <boost/algorithm/string.hpp>
 
 #include <Error.hpp>
 #include <options/AbstractUserProfiles.hpp>
 #include <system/FilePath.hpp>
 #include <system/User.hpp>
+#include <utils/FileUtils.hpp>
 
 namespace rstudio {
 namespace launcher_plugins {
@@ -455,6 +459,42 @@ TEST_CASE("Complex case")
 
 }
 
+TEST_CASE("Reloading a modified file")
+{
+   system::User userOne, userTwo;
+   REQUIRE_FALSE(system::User::getUserFromIdentifier(USER_ONE, userOne));
+   REQUIRE_FALSE(system::User::getUserFromIdentifier(USER_TWO, userTwo));
+
+   system::FilePath confFile = system::FilePath::safeCurrentPath(
+      system::FilePath()).completeChildPath("profile-files").completeChildPath("reload.profiles.conf");
+   REQUIRE_FALSE(utils::writeStringToFile(
+      "[*]\nint-field=1\nstr-field=all users\n[" + std::string(USER_TWO) + "]\nint-field=2\n",
+      confFile));
+
+   TestUserProfiles userProfiles("reload.profiles.conf");
+   REQUIRE_FALSE(userProfiles.initialize());
+   CHECK(userProfiles.getIntField(userOne) == 1);
+   CHECK(userProfiles.getIntField(userTwo) == 2);
+   CHECK(userProfiles.getStrField(userTwo) == "all users");
+
+   // An invalid file is ignored.
+   REQUIRE_FALSE(utils::writeStringToFile("[*]\nint-field=not a number\n", confFile));
+   confFile.setLastWriteTime(::time(nullptr) + 10);
+   std::this_thread::sleep_for(std::chrono::seconds(6));
+   CHECK(userProfiles.getIntField(userOne) == 1);
+   CHECK(userProfiles.getIntField(userTwo) == 2);
+
+   // A valid file replaces the previous values.
+   REQUIRE_FALSE(utils::writeStringToFile("[*]\nint-field=3\n", confFile));
+   confFile.setLastWriteTime(::time(nullptr) + 20);
+   std::this_thread::sleep_for(std::chrono::seconds(6));
+   CHECK(userProfiles.getIntField(userOne) == 3);
+   CHECK(userProfiles.getIntField(userTwo) == 3);
+   CHECK(userProfiles.getStrField(userTwo).empty());
+
+   REQUIRE_FALSE(confFile.remove());
+}
+
 } // namespace options
 } // namespace launcher_plugins
 } // namespace rstudio
@@ -23,6 +23,9 @@
 
 #include <system/Asio.hpp>
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -30,10 +33,14 @@
 #include <boost/asio.hpp>
 
 #include <Error.hpp>
+#include <metrics/Metrics.hpp>
 #include <system/DateTime.hpp>
+#include <system/PosixSystem.hpp>
 #include <utils/ErrorUtils.hpp>
 #include <utils/MutexUtils.hpp>
 
+#include "TimerService.hpp"
+
 namespace rstudio {
 namespace launcher_plugins {
 namespace system {
@@ -46,8 +53,344 @@ boost::asio::io_service& getIoService()
    return ioService;
 }
 
+typedef std::chrono::steady_clock Clock;
+
+/** The number of priority lanes. */
+constexpr size_t s_numLanes = static_cast<size_t>(AsioPriority::LOW) + 1;
+
+/**
+ * The maximum number of consecutive work items each lane may run while lower priority work is waiting. The lowest
+ * priority lane never has lower priority work waiting, so its value is unused.
+ */
+constexpr size_t s_maxConsecutive[s_numLanes] = { 8, 4, 1 };
+
+/** The maximum number of workers in PER_WORKER mode. */
+constexpr size_t s_maxWorkers = 256;
+
+/**
+ * @brief A unit of work which has been posted to a priority lane.
+ */
+struct QueuedWork
+{
+   /** The work to perform. */
+   AsioFunction Work;
+
+   /** The time at which the work was posted. */
+   Clock::time_point PostTime;
+};
+
+/**
+ * @brief A single priority lane of work.
+ */
+struct Lane
+{
+   Lane() : Consecutive(0) { }
+
+   /** The queued work. */
+   std::queue<QueuedWork> Queue;
+
+   /** The number of work items run from this lane since a lower priority lane was last served. */
+   size_t Consecutive;
+
+   /** The statistics of this lane, not including the queued count. */
+   AsioQueueStats Stats;
+};
+
+/**
+ * @brief A set of priority lanes.
+ */
+struct LaneSet
+{
+   /**
+    * @brief Adds work to the specified priority lane.
+    *
+    * @param in_work        The work to add.
+    * @param in_priority    The priority lane to which the work should be added.
+    */
+   void push(const AsioFunction& in_work, AsioPriority in_priority)
+   {
+      LOCK_MUTEX(Mutex)
+      {
+         Lanes[static_cast<size_t>(in_priority)].Queue.push(QueuedWork{ in_work, Clock::now() });
+      }
+      END_LOCK_MUTEX
+   }
+
+   /**
+    * @brief Removes the next work item, choosing the highest priority lane which has not exceeded its consecutive run
+    *        limit while lower priority work is waiting.
+    *
+    * @param out_work   The next work item, if any.
+    *
+    * @return True if there was work to remove; false otherwise.
+    */
+   bool pop(AsioFunction& out_work)
+   {
+      LOCK_MUTEX(Mutex)
+      {
+         for (size_t i = 0; i < s_numLanes; ++i)
+         {
+            Lane& lane = Lanes[i];
+            if (lane.Queue.empty())
+               continue;
+
+            if (lane.Consecutive >= s_maxConsecutive[i])
+            {
+               bool lowerWaiting = false;
+               for (size_t j = i + 1; j < s_numLanes; ++j)
+                  lowerWaiting = lowerWaiting || !Lanes[j].Queue.empty();
+
+               // Yield to the lower priority work.
+               if (lowerWaiting)
+                  continue;
+            }
+
+            // A lower priority lane is being served, so reset the counts of the higher priority lanes.
+            for (size_t j = 0; j < i; ++j)
+               Lanes[j].Consecutive = 0;
+            ++lane.Consecutive;
+
+            QueuedWork& next = lane.Queue.front();
+            uint64_t waitTime = std::chrono::duration_cast<std::chrono::microseconds>(
+               Clock::now() - next.PostTime).count();
+            ++lane.Stats.CompletedCount;
+            lane.Stats.TotalWaitMicroseconds += waitTime;
+            lane.Stats.MaxWaitMicroseconds = std::max(lane.Stats.MaxWaitMicroseconds, waitTime);
+
+            out_work = std::move(next.Work);
+            lane.Queue.pop();
+            return true;
+         }
+      }
+      END_LOCK_MUTEX
+
+      return false;
+   }
+
+   /**
+    * @brief Adds the statistics of the specified priority lane to the provided statistics.
+    *
+    * @param in_priority    The priority lane for which to add statistics.
+    * @param io_stats       The statistics to add to.
+    */
+   void addStats(AsioPriority in_priority, AsioQueueStats& io_stats)
+   {
+      LOCK_MUTEX(Mutex)
+      {
+         const Lane& lane = Lanes[static_cast<size_t>(in_priority)];
+         io_stats.QueuedCount += lane.Queue.size();
+         io_stats.CompletedCount += lane.Stats.CompletedCount;
+         io_stats.TotalWaitMicroseconds += lane.Stats.TotalWaitMicroseconds;
+         io_stats.MaxWaitMicroseconds = std::max(io_stats.MaxWaitMicroseconds, lane.Stats.MaxWaitMicroseconds);
+      }
+      END_LOCK_MUTEX
+   }
+
+   /** The priority lanes of posted work. */
+   std::array<Lane, s_numLanes> Lanes;
+
+   /** The mutex to protect the priority lanes. */
+   std::mutex Mutex;
+};
+
+/**
+ * @brief An IO service, and the queue of work that should be run on it.
+ *
+ * In SHARED mode there is a single worker which is run by every thread. In PER_WORKER mode each thread runs its own
+ * worker, and idle workers steal queued work from the other workers.
+ */
+struct Worker
+{
+   /**
+    * @brief Constructor. Creates a worker which uses an existing IO service.
+    *
+    * @param in_ioService   The IO service of this worker.
+    */
+   explicit Worker(boost::asio::io_service& in_ioService) :
+      IoService(in_ioService),
+      IsWakePending(false),
+      Pending(0)
+   {
+   }
+
+   /**
+    * @brief Constructor. Creates a worker with its own IO service.
+    */
+   Worker() :
+      OwnedIoService(new boost::asio::io_service()),
+      IoService(*OwnedIoService),
+      IsWakePending(false),
+      Pending(0)
+   {
+   }
+
+   /** The IO service of this worker, if it is not the shared IO service. */
+   std::unique_ptr<boost::asio::io_service> OwnedIoService;
+
+   /** The IO service of this worker. */
+   boost::asio::io_service& IoService;
+
+   /** Whether this worker has been woken to steal work, and has not started looking for work since. */
+   std::atomic_bool IsWakePending;
+
+   /** The work queued on this worker. */
+   LaneSet Lanes;
+
+   /** The number of work items which are queued on or running on this worker. */
+   std::atomic<size_t> Pending;
+};
+
+/**
+ * @brief The workers of the ASIO service.
+ */
+struct WorkerPool
+{
+   /**
+    * @brief Constructor. The first worker always uses the shared IO service, so that objects created before the
+    *        threads are started are still serviced.
+    */
+   WorkerPool() :
+      WorkerCount(1),
+      NextWorker(0)
+   {
+      Workers[0].reset(new Worker(getIoService()));
+   }
+
+   /**
+    * @brief Gets the worker that work posted from the calling thread should be queued on. This is the worker of the
+    *        calling thread, if it has one. Otherwise workers are chosen in round-robin order.
+    *
+    * @return The worker that work posted from the calling thread should be queued on.
+    */
+   Worker& selectWorker()
+   {
+      if (CurrentWorker != nullptr)
+         return *CurrentWorker;
+
+      size_t count = WorkerCount.load();
+      return *Workers[(count == 1) ? 0 : (NextWorker.fetch_add(1) % count)];
+   }
+
+   /**
+    * @brief Wakes an idle worker, if there is one, so it may steal work from the specified worker. Workers which have
+    *        already been woken are not woken again, so that consecutive posts wake different workers.
+    *
+    * @param in_owner   The worker to which work was just posted.
+    */
+   void wakeIdleWorker(const Worker& in_owner)
+   {
+      size_t count = WorkerCount.load();
+      if (count == 1)
+         return;
+
+      size_t start = NextWorker.fetch_add(1);
+      for (size_t i = 0; i < count; ++i)
+      {
+         Worker* worker = Workers[(start + i) % count].get();
+         if ((worker != &in_owner) && (worker->Pending.load() == 0) && !worker->IsWakePending.exchange(true))
+         {
+            boost::asio::post(worker->IoService, std::bind(&WorkerPool::runNextWork, this, worker));
+            return;
+         }
+      }
+   }
+
+   /**
+    * @brief Runs the next work item queued on the specified worker. Once the worker has no queued work, it steals work
+    *        from the other workers until there is none left.
+    *
+    * @param in_worker  The worker which should run the work.
+    */
+   void runNextWork(Worker* in_worker)
+   {
+      // Any work posted from here on may need this worker to be woken again.
+      in_worker->IsWakePending.store(false);
+
+      AsioFunction work;
+      if (in_worker->Lanes.pop(work))
+      {
+         work();
+         --in_worker->Pending;
+      }
+
+      // Work queued on this worker has its own runs scheduled, so only steal while there is none.
+      if (in_worker->Pending.load() > 0)
+         return;
+
+      size_t count = WorkerCount.load();
+      Worker* victim = nullptr;
+      for (size_t i = 0; (i < count) && !victim; ++i)
+      {
+         Worker* worker = Workers[i].get();
+         if ((worker != in_worker) && (worker->Pending.load() > 0) && worker->Lanes.pop(work))
+            victim = worker;
+      }
+
+      // Nothing to do.
+      if (!victim)
+         return;
+
+      ++in_worker->Pending;
+      --victim->Pending;
+
+      work();
+      --in_worker->Pending;
+
+      // Keep stealing until there is nothing left, but let the IO service run its other handlers in between.
+      in_worker->IsWakePending.store(true);
+      boost::asio::post(in_worker->IoService, std::bind(&WorkerPool::runNextWork, this, in_worker));
+   }
+
+   /** The workers. Only the first WorkerCount workers exist. A fixed size array is used so that workers may be read
+    *  without locking. */
+   std::array<std::unique_ptr<Worker>, s_maxWorkers> Workers;
+
+   /** The number of workers. */
+   std::atomic<size_t> WorkerCount;
+
+   /** The index of the next worker to use when choosing workers in round-robin order. */
+   std::atomic<size_t> NextWorker;
+
+   /** The worker run by the current thread, if any. */
+   static thread_local Worker* CurrentWorker;
+};
+
+thread_local Worker* WorkerPool::CurrentWorker = nullptr;
+
+WorkerPool& getWorkerPool()
+{
+   static WorkerPool workerPool;
+   return workerPool;
+}
+
+/**
+ * @brief Converts a TimeDuration to a duration of the timer clock.
+ *
+ * @param in_timeDuration    The TimeDuration to convert.
+ *
+ * @return The converted duration.
+ */
+TimerEntry::Clock::duration toClockDuration(const TimeDuration& in_timeDuration)
+{
+   return std::chrono::hours(in_timeDuration.getHours()) +
+      std::chrono::minutes(in_timeDuration.getMinutes()) +
+      std::chrono::seconds(in_timeDuration.getSeconds()) +
+      std::chrono::microseconds(in_timeDuration.getMicroseconds());
 }
 
+/**
+ * @brief Gets the IO service with which new async objects, like streams, should be associated. The
+ *        handlers of those objects will be run by the worker that owns the IO service.
+ *
+ * @return The IO service with which new async objects should be associated.
+ */
+boost::asio::io_service& getAffinityIoService()
+{
+   return getWorkerPool().selectWorker().IoService;
+}
+
+} // anonymous namespace
+
 // Asio Service ========================================================================================================
 struct AsioService::Impl
 {
@@ -55,25 +398,55 @@ struct AsioService::Impl
     * @brief Constructor.
     */
    Impl() :
-      IoService(getIoService()),
+      Pool(getWorkerPool()),
       IsRunning(true),
       IsSignalSetInit(false),
-      SignalSet(IoService, SIGTERM, SIGINT) // These signals need to be passed in this order or it won't pick up SIGINTs
+      SignalSet(getIoService(), SIGTERM, SIGINT) // These signals need to be passed in this order or it won't pick up SIGINTs
+   {
+   }
+
+   /**
+    * @brief Adds work to the specified priority lane of a worker and schedules a run on that worker's IO service.
+    *
+    * @param in_work        The work to add.
+    * @param in_priority    The priority lane to which the work should be added.
+    */
+   void postWork(const AsioFunction& in_work, AsioPriority in_priority)
    {
+      Worker& worker = Pool.selectWorker();
+      ++worker.Pending;
+      worker.Lanes.push(in_work, in_priority);
+
+      // Each post schedules exactly one run on the worker, so there is always a run available for every queued work
+      // item. The run does not necessarily perform the work which caused it to be scheduled, though.
+      boost::asio::post(worker.IoService, std::bind(&WorkerPool::runNextWork, &Pool, &worker));
+      Pool.wakeIdleWorker(worker);
    }
 
    /**
     * @brief Callback function which may be used to register a thread with the ASIO service and ensure it is available
     *        for ASIO work.
+    *
+    * @param in_worker      The worker that the thread should run.
+    * @param in_index       The index of the thread.
+    * @param in_pinThread   Whether the thread should be pinned to a CPU core.
     */
-   void startWorkerThread()
+   static void startWorkerThread(Worker* in_worker, size_t in_index, bool in_pinThread)
    {
-      boost::asio::io_service::work work(IoService);
-      IoService.run();
+      WorkerPool::CurrentWorker = in_worker;
+      if (in_pinThread)
+      {
+         Error error = posix::pinCurrentThreadToCore(in_index);
+         if (error)
+            logging::logError(error);
+      }
+
+      boost::asio::io_service::work work(in_worker->IoService);
+      in_worker->IoService.run();
    }
 
-   /** The underlying async IO service. */
-   boost::asio::io_service& IoService;
+   /** The workers of the ASIO service. */
+   WorkerPool& Pool;
 
    /** Whether the ASIO service is running */
    bool IsRunning;
@@ -93,7 +466,24 @@ struct AsioService::Impl
 
 void AsioService::post(const AsioFunction& in_work)
 {
-   boost::asio::post(getAsioService().m_impl->IoService, in_work);
+   post(in_work, AsioPriority::NORMAL);
+}
+
+void AsioService::post(const AsioFunction& in_work, AsioPriority in_priority)
+{
+   getAsioService().m_impl->postWork(in_work, in_priority);
+}
+
+AsioQueueStats AsioService::getQueueStats(AsioPriority in_priority)
+{
+   WorkerPool& pool = getAsioService().m_impl->Pool;
+
+   AsioQueueStats stats;
+   size_t count = pool.WorkerCount.load();
+   for (size_t i = 0; i < count; ++i)
+      pool.Workers[i]->Lanes.addStats(in_priority, stats);
+
+   return stats;
 }
 
 void AsioService::setSignalHandler(const OnSignal& in_onSignal)
@@ -110,22 +500,58 @@ void AsioService::setSignalHandler(const OnSignal& in_onSignal)
    END_LOCK_MUTEX
 }
 
+void AsioService::setTimerSlack(const TimeDuration& in_slack)
+{
+   TimerService::getInstance().setSlack(toClockDuration(in_slack));
+}
+
 void AsioService::startThreads(size_t in_numThreads)
+{
+   startThreads(in_numThreads, AsioExecutionMode::SHARED, false);
+}
+
+void AsioService::startThreads(size_t in_numThreads, AsioExecutionMode in_mode, bool in_pinThreads)
 {
    std::shared_ptr<Impl> sharedThis = getAsioService().m_impl;
 
    UNIQUE_LOCK_MUTEX(sharedThis->Mutex)
    {
-      if (sharedThis->IsRunning)
+      if (!sharedThis->IsRunning)
+         return;
+
+      // Timers may only be scheduled while the service is running.
+      TimerService::getInstance().start();
+
+      WorkerPool& pool = sharedThis->Pool;
+      if ((in_mode == AsioExecutionMode::PER_WORKER) && !sharedThis->Threads.empty())
+      {
+         logging::logWarningMessage(
+            "ASIO worker threads have already been started. Adding threads to the shared worker instead.",
+            ERROR_LOCATION);
+         in_mode = AsioExecutionMode::SHARED;
+      }
+
+      if (in_mode == AsioExecutionMode::PER_WORKER)
+      {
+         size_t numWorkers = std::min(in_numThreads, s_maxWorkers);
+         for (size_t i = 1; i < numWorkers; ++i)
+            pool.Workers[i].reset(new Worker());
+
+         // Publish the new workers only once they have all been created.
+         pool.WorkerCount.store(std::max<size_t>(numWorkers, 1));
+         for (size_t i = 0; i < numWorkers; ++i)
+            sharedThis->Threads.emplace_back(
+               new std::thread(&Impl::startWorkerThread, pool.Workers[i].get(), i, in_pinThreads));
+      }
+      else
       {
          for (size_t i = 0; i < in_numThreads; ++i)
-         {
-            sharedThis->Threads.emplace_back(new std::thread(
-               [sharedThis]()
-               {
-                  sharedThis->startWorkerThread();
-               }));
-         }
+            sharedThis->Threads.emplace_back(
+               new std::thread(
+                  &Impl::startWorkerThread,
+                  pool.Workers[0].get(),
+                  sharedThis->Threads.size(),
+                  in_pinThreads));
       }
    }
    END_LOCK_MUTEX
@@ -139,11 +565,17 @@ void AsioService::stop()
    {
       if (sharedThis->IsRunning)
       {
-         sharedThis->IoService.stop();
+         WorkerPool& pool = sharedThis->Pool;
+         size_t count = pool.WorkerCount.load();
+         for (size_t i = 0; i < count; ++i)
+            pool.Workers[i]->IoService.stop();
+
          sharedThis->IsRunning = false;
       }
    }
    END_LOCK_MUTEX
+
+   TimerService::getInstance().stop();
 }
 
 void AsioService::waitForExit()
@@ -177,7 +609,7 @@ struct AsioStream::Impl : public std::enable_shared_from_this<AsioStream::Impl>
     * @param in_streamHandle    The handle of the stream to open.
     */
    explicit Impl(boost::asio::posix::stream_descriptor::native_handle_type in_streamHandle) :
-      StreamDescriptor(getIoService())
+      StreamDescriptor(getAffinityIoService())
    {
       try
       {
@@ -253,6 +685,7 @@ struct AsioStream::Impl : public std::enable_shared_from_this<AsioStream::Impl>
       while (!WriteBuffer.empty() && WriteBuffer.front().empty())
       {
          WriteBuffer.pop();
+         metrics::adjustStreamWriteQueueDepth(-1);
       }
 
       if (WriteBuffer.empty())
@@ -295,10 +728,14 @@ struct AsioStream::Impl : public std::enable_shared_from_this<AsioStream::Impl>
                {
                   // If we didn't write all of the data, push the remainder onto the buffer queue and start over.
                   if (instance->WriteBuffer.front().size() > in_writtenLength)
+                  {
                      instance->WriteBuffer.push(instance->WriteBuffer.front().substr(in_writtenLength));
+                     metrics::adjustStreamWriteQueueDepth(1);
+                  }
 
                   // Pop the first message and start writing over again.
                   instance->WriteBuffer.pop();
+                  metrics::adjustStreamWriteQueueDepth(-1);
                   instance->startWriting(uniqueLock, in_onError, in_onFinishedWriting);
                }
                END_LOCK_MUTEX
@@ -366,6 +803,7 @@ void AsioStream::writeBytes(
    UNIQUE_LOCK_MUTEX(m_impl->WriteMutex)
    {
       m_impl->WriteBuffer.push(in_data);
+      metrics::adjustStreamWriteQueueDepth(1);
       if (m_impl->WriteBuffer.size() == 1)
          m_impl->startWriting(
             uniqueLock,
@@ -394,35 +832,32 @@ struct AsyncTimedEvent::Impl
    {
    }
 
-   static void runEvent(
-      const WeakImpl& in_weakThis,
-      const boost::posix_time::time_duration& in_intervalSeconds,
-      const AsioFunction& in_event,
-      const boost::system::error_code& in_ec)
+   static void runEvent(const WeakImpl& in_weakThis)
    {
-      // If the operation was canceled, there's nothing to do.
-      if (in_ec == boost::asio::error::operation_aborted)
-         return;
-      // If another error occurred, log it and exit.
-      else if (in_ec.value() != 0)
-         return logging::logError(utils::createErrorFromBoostError(in_ec, ERROR_LOCATION));
-
       // If this has been deleted, there's nothing to do.
       SharedImpl sharedThis = in_weakThis.lock();
       if (!sharedThis)
          return;
 
-      UNIQUE_LOCK_MUTEX(sharedThis->Mutex)
+      // If this is no longer running, there's nothing to do. The event itself is performed without holding the lock,
+      // so that it may cancel the timed event.
+      bool running = false;
+      LOCK_MUTEX(sharedThis->Mutex)
       {
-         // If this is no longer running, there's nothing to do.
-         if (!sharedThis->Running)
-            return;
+         running = sharedThis->Running;
+      }
+      END_LOCK_MUTEX
 
-         // Otherwise, perform the action and restart the timer.
-         in_event();
-         sharedThis->Timer->expires_from_now(in_intervalSeconds);
-         sharedThis->Timer->async_wait(
-            std::bind(runEvent, in_weakThis, in_intervalSeconds, in_event, std::placeholders::_1));
+      if (!running)
+         return;
+
+      sharedThis->Event();
+
+      // Restart the timer, unless the event was canceled while it was being performed.
+      LOCK_MUTEX(sharedThis->Mutex)
+      {
+         if (sharedThis->Running)
+            sharedThis->Timer->schedule(sharedThis->Interval);
       }
       END_LOCK_MUTEX
    }
@@ -433,8 +868,14 @@ struct AsyncTimedEvent::Impl
    /** Whether the timed event is currently running. */
    bool Running;
 
-   /** The timer that will invoke the callback function. */
-   std::shared_ptr<boost::asio::deadline_timer> Timer;
+   /** The action to perform each interval. */
+   AsioFunction Event;
+
+   /** The amount of time to wait between each event. */
+   TimerEntry::Clock::duration Interval;
+
+   /** The timer entry that will invoke the event. */
+   std::unique_ptr<TimerEntry> Timer;
 };
 
 AsyncTimedEvent::AsyncTimedEvent() :
@@ -448,22 +889,21 @@ void AsyncTimedEvent::start(const TimeDuration& in_timeDuration, const AsioFunct
    if (in_timeDuration == TimeDuration())
       return;
 
-   boost::posix_time::time_duration timeDuration(
-      in_timeDuration.getHours(),
-      in_timeDuration.getMinutes(),
-      in_timeDuration.getSeconds(),
-      in_timeDuration.getMicroseconds());
-
-   m_impl->Timer.reset(
-      new boost::asio::deadline_timer(getIoService(), timeDuration));
-
    Impl::WeakImpl weakImpl = m_impl;
-   m_impl->Timer->async_wait(std::bind(&Impl::runEvent, m_impl, timeDuration, in_event, std::placeholders::_1));
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      m_impl->Event = in_event;
+      m_impl->Interval = toClockDuration(in_timeDuration);
+      m_impl->Timer.reset(new TimerEntry(std::bind(&Impl::runEvent, weakImpl)));
+      if (m_impl->Running)
+         m_impl->Timer->schedule(m_impl->Interval);
+   }
+   END_LOCK_MUTEX
 }
 
 void AsyncTimedEvent::cancel()
 {
-   UNIQUE_LOCK_MUTEX(m_impl->Mutex)
+   LOCK_MUTEX(m_impl->Mutex)
    {
       m_impl->Running = false;
       if (m_impl->Timer)
@@ -483,13 +923,14 @@ struct AsyncDeadlineEvent::Impl
 {
    Impl(AsioFunction in_work, DateTime in_deadline) :
       Deadline(std::move(in_deadline)),
+      IsCanceled(false),
       Work(std::move(in_work))
    {
-
    }
 
    DateTime Deadline;
-   std::shared_ptr<boost::asio::deadline_timer> Timer;
+   std::atomic_bool IsCanceled;
+   std::unique_ptr<TimerEntry> Timer;
    AsioFunction Work;
 };
 
@@ -517,6 +958,7 @@ AsyncDeadlineEvent::~AsyncDeadlineEvent()
 
 void AsyncDeadlineEvent::cancel()
 {
+   m_impl->IsCanceled.store(true);
    if (m_impl->Timer != nullptr)
       m_impl->Timer->cancel();
 }
@@ -528,25 +970,16 @@ void AsyncDeadlineEvent::start()
       AsioService::post(m_impl->Work);
    else
    {
-      TimeDuration diff = m_impl->Deadline - now;
-      m_impl->Timer.reset(
-         new boost::asio::deadline_timer(
-            getIoService(),
-            boost::posix_time::time_duration(
-               diff.getHours(),
-               diff.getMinutes(),
-               diff.getSeconds(),
-               diff.getMicroseconds())));
-
       std::weak_ptr<Impl> weakThis = m_impl;
-      m_impl->Timer->async_wait(
-         [weakThis](boost::system::error_code in_ec)
+      m_impl->Timer.reset(new TimerEntry(
+         [weakThis]()
          {
             // Don't do any work if this was canceled or m_impl has been destroyed.
             std::shared_ptr<Impl> sharedThis = weakThis.lock();
-            if ((in_ec != boost::asio::error::operation_aborted) && sharedThis)
+            if (sharedThis && !sharedThis->IsCanceled.load())
                sharedThis->Work();
-         });
+         }));
+      m_impl->Timer->schedule(toClockDuration(m_impl->Deadline - now));
    }
 }
 
@@ -27,6 +27,9 @@
 #include <boost/date_time/gregorian/greg_duration.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 #include <Error.hpp>
 
 namespace rstudio {
@@ -36,6 +39,258 @@ namespace system {
 namespace {
 constexpr char const* ISO_8601_OUTPUT_FORMAT = "%Y-%m-%dT%H:%M:%S%FZ";
 constexpr char const* ISO_8601_INPUT_FORMAT  = "%Y-%m-%dT%H:%M:%S%F%ZP";
+
+/** The length of the "YYYY-MM-DDTHH:MM:SS" prefix of an ISO 8601 time string. */
+constexpr size_t ISO_8601_PREFIX_LENGTH = 19;
+
+/** The length of the longest ISO 8601 time string which is output: "YYYY-MM-DDTHH:MM:SS.ffffffZ". */
+constexpr size_t ISO_8601_MAX_LENGTH = ISO_8601_PREFIX_LENGTH + 8;
+
+constexpr int64_t MICROSECONDS_PER_SECOND = 1000000;
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+/**
+ * @brief The most recently formatted second on this thread. Many times formatted in a row (e.g. log timestamps) fall
+ *        within the same second, so the date and time of day only need to be computed once.
+ */
+struct FormatCache
+{
+   int64_t Seconds;
+   char Prefix[ISO_8601_PREFIX_LENGTH];
+   bool IsValid;
+};
+
+thread_local FormatCache s_formatCache = { 0, { 0 }, false };
+
+const boost::posix_time::ptime& getEpoch()
+{
+   static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+   return epoch;
+}
+
+// Converts between days since the epoch and proleptic Gregorian calendar dates. See
+// http://howardhinnant.github.io/date_algorithms.html for the derivation.
+int64_t daysFromCivil(int64_t in_year, unsigned int in_month, unsigned int in_day)
+{
+   in_year -= (in_month <= 2) ? 1 : 0;
+   const int64_t era = ((in_year >= 0) ? in_year : in_year - 399) / 400;
+   const unsigned int yearOfEra = static_cast<unsigned int>(in_year - era * 400);
+   const unsigned int dayOfYear = (153 * (in_month + ((in_month > 2) ? -3 : 9)) + 2) / 5 + in_day - 1;
+   const unsigned int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+   return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+void civilFromDays(int64_t in_days, int64_t& out_year, unsigned int& out_month, unsigned int& out_day)
+{
+   in_days += 719468;
+   const int64_t era = ((in_days >= 0) ? in_days : in_days - 146096) / 146097;
+   const unsigned int dayOfEra = static_cast<unsigned int>(in_days - era * 146097);
+   const unsigned int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+   const unsigned int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+   const unsigned int monthIndex = (5 * dayOfYear + 2) / 153;
+
+   out_day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+   out_month = monthIndex + ((monthIndex < 10) ? 3 : -9);
+   out_year = static_cast<int64_t>(yearOfEra) + era * 400 + ((out_month <= 2) ? 1 : 0);
+}
+
+unsigned int getDaysInMonth(int64_t in_year, unsigned int in_month)
+{
+   static const unsigned int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+   if ((in_month == 2) && ((in_year % 4 == 0) && ((in_year % 100 != 0) || (in_year % 400 == 0))))
+      return 29;
+
+   return daysInMonth[in_month - 1];
+}
+
+inline void writeDigits(unsigned int in_value, size_t in_width, char* out_buffer)
+{
+   for (size_t i = in_width; i > 0; --i)
+   {
+      out_buffer[i - 1] = static_cast<char>('0' + (in_value % 10));
+      in_value /= 10;
+   }
+}
+
+inline bool readDigits(const char*& io_pos, const char* in_end, size_t in_width, unsigned int& out_value)
+{
+   if (static_cast<size_t>(in_end - io_pos) < in_width)
+      return false;
+
+   out_value = 0;
+   for (size_t i = 0; i < in_width; ++i, ++io_pos)
+   {
+      if ((*io_pos < '0') || (*io_pos > '9'))
+         return false;
+      out_value = out_value * 10 + static_cast<unsigned int>(*io_pos - '0');
+   }
+
+   return true;
+}
+
+inline bool readSeparator(const char*& io_pos, const char* in_end, char in_separator)
+{
+   if ((io_pos == in_end) || (*io_pos != in_separator))
+      return false;
+
+   ++io_pos;
+   return true;
+}
+
+/**
+ * @brief Formats a time in the ISO 8601 output format without using iostreams.
+ *
+ * @param in_time        The time to format.
+ * @param out_buffer     The buffer to which the formatted time should be written.
+ *
+ * @return The length of the formatted time, or 0 if the time can't be represented by the fast formatter.
+ */
+size_t formatIso8601(const boost::posix_time::ptime& in_time, char (&out_buffer)[ISO_8601_MAX_LENGTH])
+{
+   if (in_time.is_special())
+      return 0;
+
+   const int64_t totalMicroseconds = (in_time - getEpoch()).total_microseconds();
+   int64_t seconds = totalMicroseconds / MICROSECONDS_PER_SECOND;
+   int64_t microseconds = totalMicroseconds % MICROSECONDS_PER_SECOND;
+   if (microseconds < 0)
+   {
+      --seconds;
+      microseconds += MICROSECONDS_PER_SECOND;
+   }
+
+   FormatCache& cache = s_formatCache;
+   if (!cache.IsValid || (cache.Seconds != seconds))
+   {
+      int64_t days = seconds / SECONDS_PER_DAY;
+      int64_t secondOfDay = seconds % SECONDS_PER_DAY;
+      if (secondOfDay < 0)
+      {
+         --days;
+         secondOfDay += SECONDS_PER_DAY;
+      }
+
+      int64_t year = 0;
+      unsigned int month = 0, day = 0;
+      civilFromDays(days, year, month, day);
+      if ((year < 0) || (year > 9999))
+         return 0;
+
+      char* prefix = cache.Prefix;
+      writeDigits(static_cast<unsigned int>(year), 4, prefix);
+      prefix[4] = '-';
+      writeDigits(month, 2, prefix + 5);
+      prefix[7] = '-';
+      writeDigits(day, 2, prefix + 8);
+      prefix[10] = 'T';
+      writeDigits(static_cast<unsigned int>(secondOfDay / 3600), 2, prefix + 11);
+      prefix[13] = ':';
+      writeDigits(static_cast<unsigned int>((secondOfDay / 60) % 60), 2, prefix + 14);
+      prefix[16] = ':';
+      writeDigits(static_cast<unsigned int>(secondOfDay % 60), 2, prefix + 17);
+
+      cache.Seconds = seconds;
+      cache.IsValid = true;
+   }
+
+   std::memcpy(out_buffer, cache.Prefix, ISO_8601_PREFIX_LENGTH);
+   size_t length = ISO_8601_PREFIX_LENGTH;
+
+   // Like the %F flag, only include the fractional seconds if they are non-zero.
+   if (microseconds != 0)
+   {
+      out_buffer[length++] = '.';
+      writeDigits(static_cast<unsigned int>(microseconds), 6, out_buffer + length);
+      length += 6;
+   }
+
+   out_buffer[length++] = 'Z';
+   return length;
+}
+
+/**
+ * @brief Parses an ISO 8601 time with a UTC or numeric offset time zone (e.g. "Z", "+5:30", or "-08:00") without using
+ *        iostreams.
+ *
+ * @param in_timeStr     The time string to parse.
+ * @param out_time       The parsed time, in UTC.
+ *
+ * @return True if the time string could be parsed; false if it must be parsed by the general time parser.
+ */
+bool parseIso8601(const std::string& in_timeStr, boost::posix_time::ptime& out_time)
+{
+   const char* pos = in_timeStr.data();
+   const char* end = pos + in_timeStr.size();
+
+   unsigned int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+   if (!readDigits(pos, end, 4, year) || !readSeparator(pos, end, '-') ||
+      !readDigits(pos, end, 2, month) || !readSeparator(pos, end, '-') ||
+      !readDigits(pos, end, 2, day) || !readSeparator(pos, end, 'T') ||
+      !readDigits(pos, end, 2, hour) || !readSeparator(pos, end, ':') ||
+      !readDigits(pos, end, 2, minute) || !readSeparator(pos, end, ':') ||
+      !readDigits(pos, end, 2, second))
+      return false;
+
+   if ((month < 1) || (month > 12) || (day < 1) || (day > getDaysInMonth(year, month)) ||
+      (hour > 23) || (minute > 59) || (second > 59))
+      return false;
+
+   // Fractional seconds beyond microsecond resolution are truncated.
+   int64_t microseconds = 0;
+   if ((pos != end) && (*pos == '.'))
+   {
+      ++pos;
+      int64_t scale = MICROSECONDS_PER_SECOND;
+      const char* fractionStart = pos;
+      for (; (pos != end) && (*pos >= '0') && (*pos <= '9'); ++pos)
+      {
+         scale /= 10;
+         microseconds += (*pos - '0') * scale;
+      }
+
+      if (pos == fractionStart)
+         return false;
+   }
+
+   int64_t offsetSeconds = 0;
+   if ((pos != end) && (*pos == 'Z'))
+      ++pos;
+   else if ((pos != end) && ((*pos == '+') || (*pos == '-')))
+   {
+      const int64_t sign = (*pos == '+') ? 1 : -1;
+      ++pos;
+
+      // The offset may be H, HH, H:MM, HH:MM, or HHMM.
+      unsigned int offsetHours = 0, offsetMinutes = 0;
+      const char* colon = std::find(pos, end, ':');
+      const size_t hoursLength = (colon != end) ? (colon - pos) : (((end - pos) == 4) ? 2 : (end - pos));
+      if ((hoursLength < 1) || (hoursLength > 2) || !readDigits(pos, end, hoursLength, offsetHours))
+         return false;
+
+      if ((colon != end) || (pos != end))
+      {
+         readSeparator(pos, end, ':');
+         if (!readDigits(pos, end, 2, offsetMinutes))
+            return false;
+      }
+
+      if ((offsetHours > 23) || (offsetMinutes > 59))
+         return false;
+
+      offsetSeconds = sign * (offsetHours * 3600 + offsetMinutes * 60);
+   }
+   else
+      return false;
+
+   if (pos != end)
+      return false;
+
+   const int64_t seconds = daysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second -
+      offsetSeconds;
+   out_time = getEpoch() + boost::posix_time::microseconds(seconds * MICROSECONDS_PER_SECOND + microseconds);
+   return true;
+}
+
 } // anonymous namespace
 
 // TimeDuration ========================================================================================================
@@ -257,6 +512,10 @@ Error DateTime::fromString(const std::string& in_timeStr, DateTime& out_dateTime
 
 Error DateTime::fromString(const std::string& in_timeStr, const std::string& in_format, DateTime& out_dateTime)
 {
+   // Parse the common ISO 8601 forms directly; creating a facet and imbuing a locale is far more expensive.
+   if ((in_format == ISO_8601_INPUT_FORMAT) && parseIso8601(in_timeStr, out_dateTime.m_impl->Time))
+      return Success();
+
    // Invalidate the DateTime so it won't act as the current time if this function fails.
    out_dateTime.m_impl->Time = boost::posix_time::not_a_date_time;
 
@@ -432,6 +691,14 @@ std::string DateTime::toString(const char* in_format) const
    if ((m_impl == nullptr) || m_impl->Time.is_not_a_date_time())
       return "";
 
+   if (std::strcmp(in_format, ISO_8601_OUTPUT_FORMAT) == 0)
+   {
+      char buffer[ISO_8601_MAX_LENGTH];
+      size_t length = formatIso8601(m_impl->Time, buffer);
+      if (length > 0)
+         return std::string(buffer, length);
+   }
+
    using namespace boost::posix_time;
 
    std::unique_ptr<time_facet> facet(new time_facet(in_format));
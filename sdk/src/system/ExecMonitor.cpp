@@ -0,0 +1,293 @@
+/*
+ * ExecMonitor.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <system/ExecMonitor.hpp>
+
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <Error.hpp>
+#include <logging/Logger.hpp>
+#include <system/Asio.hpp>
+#include <utils/MutexUtils.hpp>
+
+#include "ScopedThreadRoot.hpp"
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+namespace process {
+
+namespace {
+
+// The size of the socket receive buffer to request. Larger buffers make dropped events less likely.
+constexpr int s_receiveBufferSize = 1024 * 1024;
+
+/**
+ * @brief The state of the exec monitor.
+ */
+struct MonitorState
+{
+   MonitorState() : IsRunning(false), Socket(-1) { }
+
+   /**
+    * @brief Opens the process events socket and subscribes to process events.
+    *
+    * @return Success if process events could be subscribed to; Error otherwise.
+    */
+   Error subscribe()
+   {
+      // Subscribing requires root, so elevate this thread only while doing so.
+      ScopedThreadRoot elevation;
+
+      int sock = ::socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+      if (sock < 0)
+         return systemError(errno, "Failed to open the process events socket.", ERROR_LOCATION);
+
+      // The forced size may exceed the system maximum, since this thread is privileged. If it can't be set, fall back
+      // to the default buffer size.
+      if (::setsockopt(sock, SOL_SOCKET, SO_RCVBUFFORCE, &s_receiveBufferSize, sizeof(s_receiveBufferSize)) != 0)
+         ::setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &s_receiveBufferSize, sizeof(s_receiveBufferSize));
+
+      struct sockaddr_nl address;
+      std::memset(&address, 0, sizeof(address));
+      address.nl_family = AF_NETLINK;
+      address.nl_groups = CN_IDX_PROC;
+      address.nl_pid = 0;
+      if (::bind(sock, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0)
+      {
+         Error error = systemError(errno, "Failed to bind the process events socket.", ERROR_LOCATION);
+         ::close(sock);
+         return error;
+      }
+
+      // The subscription message is a netlink header, followed by a connector message whose data is the operation.
+      const enum proc_cn_mcast_op operation = PROC_CN_MCAST_LISTEN;
+      alignas(struct nlmsghdr) char message[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(operation))];
+      std::memset(message, 0, sizeof(message));
+
+      struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(message);
+      header->nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(operation));
+      header->nlmsg_type = NLMSG_DONE;
+      header->nlmsg_pid = 0;
+
+      struct cn_msg* connectorMessage = reinterpret_cast<struct cn_msg*>(NLMSG_DATA(header));
+      connectorMessage->id.idx = CN_IDX_PROC;
+      connectorMessage->id.val = CN_VAL_PROC;
+      connectorMessage->len = sizeof(operation);
+      std::memcpy(connectorMessage->data, &operation, sizeof(operation));
+
+      if (::send(sock, message, header->nlmsg_len, 0) < 0)
+      {
+         Error error = systemError(errno, "Failed to subscribe to process events.", ERROR_LOCATION);
+         ::close(sock);
+         return error;
+      }
+
+      Socket = sock;
+      return Success();
+   }
+
+   /**
+    * @brief Reads process events until an unrecoverable error occurs.
+    */
+   void run()
+   {
+      std::vector<char> buffer(8192);
+      while (true)
+      {
+         ssize_t size = ::recv(Socket, buffer.data(), buffer.size(), 0);
+         if (size < 0)
+         {
+            if (errno == EINTR)
+               continue;
+
+            // Events were dropped, so any watched process may have called exec.
+            if (errno == ENOBUFS)
+            {
+               notifyAll();
+               continue;
+            }
+
+            logging::logError(systemError(errno, "Stopped reading process events.", ERROR_LOCATION));
+            break;
+         }
+
+         int remaining = static_cast<int>(size);
+         for (struct nlmsghdr* header = reinterpret_cast<struct nlmsghdr*>(buffer.data());
+              NLMSG_OK(header, remaining);
+              header = NLMSG_NEXT(header, remaining))
+         {
+            if ((header->nlmsg_type == NLMSG_ERROR) || (header->nlmsg_type == NLMSG_NOOP))
+               continue;
+
+            const struct cn_msg* message = reinterpret_cast<const struct cn_msg*>(NLMSG_DATA(header));
+            if ((message->id.idx != CN_IDX_PROC) || (message->id.val != CN_VAL_PROC))
+               continue;
+
+            const struct proc_event* event = reinterpret_cast<const struct proc_event*>(message->data);
+            if (event->what == proc_event::PROC_EVENT_EXEC)
+               notify(event->event_data.exec.process_tgid);
+            else if ((event->what == proc_event::PROC_EVENT_EXIT) &&
+               (event->event_data.exit.process_pid == event->event_data.exit.process_tgid))
+               unwatch(event->event_data.exit.process_tgid);
+         }
+      }
+
+      // Fall back to whatever other mechanism the watchers have.
+      LOCK_MUTEX(Mutex)
+      {
+         IsRunning = false;
+         Watchers.clear();
+      }
+      END_LOCK_MUTEX
+
+      ::close(Socket);
+      Socket = -1;
+   }
+
+   void notify(pid_t in_pid)
+   {
+      LOCK_MUTEX(Mutex)
+      {
+         auto itr = Watchers.find(in_pid);
+         if (itr != Watchers.end())
+            AsioService::post(itr->second);
+      }
+      END_LOCK_MUTEX
+   }
+
+   void notifyAll()
+   {
+      LOCK_MUTEX(Mutex)
+      {
+         for (const auto& watcher: Watchers)
+            AsioService::post(watcher.second);
+      }
+      END_LOCK_MUTEX
+   }
+
+   void unwatch(pid_t in_pid)
+   {
+      LOCK_MUTEX(Mutex)
+      {
+         Watchers.erase(in_pid);
+      }
+      END_LOCK_MUTEX
+   }
+
+   bool IsRunning;
+   std::mutex Mutex;
+   int Socket;
+   std::mutex StartMutex;
+   std::unordered_map<pid_t, std::function<void()> > Watchers;
+};
+
+MonitorState& getState()
+{
+   // The monitor thread may outlive static destruction, so the state is intentionally never destroyed.
+   static MonitorState* state = new MonitorState();
+   return *state;
+}
+
+} // anonymous namespace
+
+Error ExecMonitor::start()
+{
+   MonitorState& state = getState();
+
+   // Prevent concurrent calls from starting more than one monitor thread.
+   std::lock_guard<std::mutex> startLock(state.StartMutex);
+   if (isRunning())
+      return Success();
+
+   // Subscribe on the monitor thread, so no other thread is ever elevated.
+   std::promise<Error> subscribed;
+   std::future<Error> result = subscribed.get_future();
+   std::thread monitorThread(
+      [&state, &subscribed]()
+      {
+         Error error = state.subscribe();
+         if (!error)
+         {
+            LOCK_MUTEX(state.Mutex)
+            {
+               state.IsRunning = true;
+            }
+            END_LOCK_MUTEX
+         }
+
+         subscribed.set_value(error);
+         if (!error)
+            state.run();
+      });
+   monitorThread.detach();
+
+   return result.get();
+}
+
+bool ExecMonitor::isRunning()
+{
+   MonitorState& state = getState();
+   LOCK_MUTEX(state.Mutex)
+   {
+      return state.IsRunning;
+   }
+   END_LOCK_MUTEX
+
+   return false;
+}
+
+bool ExecMonitor::watch(pid_t in_pid, const std::function<void()>& in_onExec)
+{
+   MonitorState& state = getState();
+   LOCK_MUTEX(state.Mutex)
+   {
+      if (!state.IsRunning)
+         return false;
+
+      state.Watchers[in_pid] = in_onExec;
+      return true;
+   }
+   END_LOCK_MUTEX
+
+   return false;
+}
+
+void ExecMonitor::unwatch(pid_t in_pid)
+{
+   getState().unwatch(in_pid);
+}
+
+} // namespace process
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
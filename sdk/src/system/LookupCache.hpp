@@ -0,0 +1,289 @@
+/*
+ * LookupCache.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_LOOKUP_CACHE_HPP
+#define LAUNCHER_PLUGINS_LOOKUP_CACHE_HPP
+
+#include <Noncopyable.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <Error.hpp>
+#include <system/Asio.hpp>
+#include <utils/MutexUtils.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+/**
+ * @brief A thread-safe cache of the results of slow lookups, such as NSS user and group queries.
+ *
+ * Successful results are cached for the TTL and "not found" (ENOENT) results are cached for the negative TTL. Other
+ * errors are never cached. Concurrent lookups of the same key are coalesced so only one of them queries the system.
+ * Once half of an entry's TTL has passed, the next access returns the cached value and refreshes the entry on the
+ * AsioService, so hot entries don't expire under load.
+ *
+ * @tparam K    The key type.
+ * @tparam V    The value type.
+ */
+template <typename K, typename V>
+class LookupCache : public Noncopyable, public std::enable_shared_from_this<LookupCache<K, V> >
+{
+public:
+   /** The function which performs the uncached lookup. */
+   typedef std::function<Error(const K&, V&)> LookupFunction;
+
+   /** The clock used for expiry. */
+   typedef std::chrono::steady_clock Clock;
+
+   /**
+    * @brief Constructor.
+    *
+    * @param in_lookup          The function which performs the uncached lookup.
+    * @param in_ttl             How long successful results are cached.
+    * @param in_negativeTtl     How long "not found" results are cached.
+    */
+   LookupCache(LookupFunction in_lookup, Clock::duration in_ttl, Clock::duration in_negativeTtl) :
+      m_generation(0),
+      m_lookup(std::move(in_lookup)),
+      m_negativeTtl(in_negativeTtl),
+      m_ttl(in_ttl)
+   {
+   }
+
+   /**
+    * @brief Gets the value for the specified key, looking it up if it isn't cached.
+    *
+    * @param in_key         The key to look up.
+    * @param out_value      The value, if no error occurs.
+    *
+    * @return Success if the value could be found; Error otherwise.
+    */
+   Error get(const K& in_key, V& out_value)
+   {
+      std::shared_ptr<InFlight> inFlight;
+      bool isOwner = false;
+      uint64_t generation = 0;
+
+      UNIQUE_LOCK_MUTEX(m_mutex)
+      {
+         const Clock::time_point now = Clock::now();
+         auto itr = m_entries.find(in_key);
+         if ((itr != m_entries.end()) && (itr->second.ExpiryTime > now))
+         {
+            if ((itr->second.RefreshTime <= now) && !itr->second.IsRefreshing)
+            {
+               itr->second.IsRefreshing = true;
+               scheduleRefresh(in_key);
+            }
+
+            if (!itr->second.LookupError)
+               out_value = itr->second.Value;
+            return itr->second.LookupError;
+         }
+
+         // Join an in-progress lookup of the same key, or start one.
+         auto inFlightItr = m_inFlight.find(in_key);
+         if (inFlightItr == m_inFlight.end())
+         {
+            inFlight.reset(new InFlight());
+            m_inFlight[in_key] = inFlight;
+            isOwner = true;
+            generation = m_generation;
+         }
+         else
+         {
+            inFlight = inFlightItr->second;
+            m_condVar.wait(uniqueLock, [&inFlight]() { return inFlight->IsDone; });
+            if (!inFlight->LookupError)
+               out_value = inFlight->Value;
+            return inFlight->LookupError;
+         }
+      }
+      END_LOCK_MUTEX
+
+      if (!isOwner)
+         return unknownError("Failed to look up a cached value.", ERROR_LOCATION);
+
+      V value;
+      Error error = m_lookup(in_key, value);
+
+      LOCK_MUTEX(m_mutex)
+      {
+         inFlight->Value = value;
+         inFlight->LookupError = error;
+         inFlight->IsDone = true;
+         m_inFlight.erase(in_key);
+
+         // Don't cache a result which was looked up before the cache was invalidated.
+         if (generation == m_generation)
+            store(in_key, value, error);
+      }
+      END_LOCK_MUTEX
+
+      m_condVar.notify_all();
+
+      if (!error)
+         out_value = value;
+      return error;
+   }
+
+   /**
+    * @brief Removes all entries from the cache.
+    */
+   void invalidate()
+   {
+      LOCK_MUTEX(m_mutex)
+      {
+         m_entries.clear();
+         ++m_generation;
+      }
+      END_LOCK_MUTEX
+   }
+
+   /**
+    * @brief Sets how long results are cached. Existing entries keep their current expiry times.
+    *
+    * @param in_ttl             How long successful results are cached.
+    * @param in_negativeTtl     How long "not found" results are cached.
+    */
+   void setTimeouts(Clock::duration in_ttl, Clock::duration in_negativeTtl)
+   {
+      LOCK_MUTEX(m_mutex)
+      {
+         m_ttl = in_ttl;
+         m_negativeTtl = in_negativeTtl;
+      }
+      END_LOCK_MUTEX
+   }
+
+private:
+   /**
+    * @brief A cached lookup result.
+    */
+   struct Entry
+   {
+      V Value;
+      Error LookupError;
+      Clock::time_point ExpiryTime;
+      Clock::time_point RefreshTime;
+      bool IsRefreshing;
+   };
+
+   /**
+    * @brief A lookup which is in progress, and its result once it is done.
+    */
+   struct InFlight
+   {
+      InFlight() : IsDone(false) { }
+
+      V Value;
+      Error LookupError;
+      bool IsDone;
+   };
+
+   /**
+    * @brief Refreshes an entry on the AsioService. The mutex must be held.
+    *
+    * @param in_key     The key of the entry to refresh.
+    */
+   void scheduleRefresh(const K& in_key)
+   {
+      std::weak_ptr<LookupCache> weakThis = this->shared_from_this();
+      uint64_t generation = m_generation;
+      AsioService::post(
+         [weakThis, in_key, generation]()
+         {
+            std::shared_ptr<LookupCache> sharedThis = weakThis.lock();
+            if (!sharedThis)
+               return;
+
+            V value;
+            Error error = sharedThis->m_lookup(in_key, value);
+
+            LOCK_MUTEX(sharedThis->m_mutex)
+            {
+               // Keep serving the old entry until it expires if the refresh failed for a reason other than the key no
+               // longer existing.
+               auto itr = sharedThis->m_entries.find(in_key);
+               if (error && (error.getCode() != ENOENT))
+               {
+                  if (itr != sharedThis->m_entries.end())
+                     itr->second.IsRefreshing = false;
+               }
+               else if (generation == sharedThis->m_generation)
+                  sharedThis->store(in_key, value, error);
+            }
+            END_LOCK_MUTEX
+         },
+         AsioPriority::LOW);
+   }
+
+   /**
+    * @brief Stores a lookup result, if it should be cached. The mutex must be held.
+    *
+    * @param in_key         The key which was looked up.
+    * @param in_value       The value which was found, if any.
+    * @param in_error       The error which occurred, if any.
+    */
+   void store(const K& in_key, const V& in_value, const Error& in_error)
+   {
+      const bool isNotFound = in_error && (in_error.getCode() == ENOENT);
+      const Clock::duration ttl = isNotFound ? m_negativeTtl : m_ttl;
+      if ((in_error && !isNotFound) || (ttl <= Clock::duration::zero()))
+      {
+         m_entries.erase(in_key);
+         return;
+      }
+
+      const Clock::time_point now = Clock::now();
+      Entry& entry = m_entries[in_key];
+      entry.Value = in_value;
+      entry.LookupError = in_error;
+      entry.ExpiryTime = now + ttl;
+      entry.RefreshTime = isNotFound ? entry.ExpiryTime : now + ttl / 2;
+      entry.IsRefreshing = false;
+   }
+
+   std::condition_variable m_condVar;
+   std::map<K, Entry> m_entries;
+   uint64_t m_generation;
+   std::map<K, std::shared_ptr<InFlight> > m_inFlight;
+   LookupFunction m_lookup;
+   std::mutex m_mutex;
+   Clock::duration m_negativeTtl;
+   Clock::duration m_ttl;
+};
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
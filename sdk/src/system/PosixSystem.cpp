@@ -22,16 +22,24 @@
  */
 
 #include <system/PosixSystem.hpp>
+#include <chrono>
 #include <csignal>
 #include <grp.h>
 #include <ifaddrs.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
 #include <memory.h>
 #include <netdb.h>
+#include <pthread.h>
 #include <pwd.h>
+#include <sched.h>
 #include <sys/prctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 #include <Error.hpp>
 #include <system/User.hpp>
+#include <utils/MutexUtils.hpp>
 
 namespace rstudio {
 namespace launcher_plugins {
@@ -40,6 +48,108 @@ namespace posix {
 
 namespace {
 
+/**
+ * @brief Caches the reachable IP addresses of this machine until the kernel reports that an address has changed.
+ */
+struct IpAddressCache
+{
+   IpAddressCache() :
+      IsRefreshRequired(true),
+      NetlinkSocket(::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE))
+   {
+      if (NetlinkSocket < 0)
+      {
+         logging::logDebugMessage("Unable to monitor IP address changes: falling back to refreshing them periodically.");
+         return;
+      }
+
+      struct sockaddr_nl addr;
+      ::memset(&addr, 0, sizeof(addr));
+      addr.nl_family = AF_NETLINK;
+      addr.nl_groups = RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+      if (::bind(NetlinkSocket, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0)
+      {
+         logging::logDebugMessage("Unable to monitor IP address changes: falling back to refreshing them periodically.");
+         closeNetlinkSocket();
+      }
+   }
+
+   ~IpAddressCache()
+   {
+      closeNetlinkSocket();
+   }
+
+   void closeNetlinkSocket()
+   {
+      if (NetlinkSocket >= 0)
+         ::close(NetlinkSocket);
+
+      NetlinkSocket = -1;
+   }
+
+   /**
+    * @brief Checks whether the cached addresses need to be refreshed, consuming any pending address change
+    *        notifications. The mutex must be held.
+    *
+    * A consumed notification keeps the cache stale until IsRefreshRequired is cleared after a successful refresh.
+    *
+    * @return True if the cached addresses need to be refreshed; false otherwise.
+    */
+   bool isStale()
+   {
+      if (NetlinkSocket < 0)
+         return IsRefreshRequired || ((std::chrono::steady_clock::now() - RefreshTime) >= std::chrono::seconds(30));
+
+      char buffer[8192];
+      while (true)
+      {
+         ssize_t length = ::recv(NetlinkSocket, buffer, sizeof(buffer), 0);
+         if (length < 0)
+         {
+            if (errno == EINTR)
+               continue;
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+               break;
+
+            // ENOBUFS means notifications were dropped. Anything else means there will be no more notifications.
+            IsRefreshRequired = true;
+            if (errno == ENOBUFS)
+               continue;
+
+            logging::logError(systemError(errno, ERROR_LOCATION));
+            closeNetlinkSocket();
+            break;
+         }
+
+         uint32_t remaining = static_cast<uint32_t>(length);
+         for (const struct nlmsghdr* message = reinterpret_cast<const struct nlmsghdr*>(buffer);
+              NLMSG_OK(message, remaining);
+              message = NLMSG_NEXT(message, remaining))
+         {
+            if ((message->nlmsg_type == RTM_NEWADDR) || (message->nlmsg_type == RTM_DELADDR))
+               IsRefreshRequired = true;
+         }
+      }
+
+      return IsRefreshRequired;
+   }
+
+   /** The cached addresses. */
+   IpAddressListPtr Addresses;
+
+   /** Whether the addresses must be refreshed, regardless of any further notifications. */
+   bool IsRefreshRequired;
+
+   /** The mutex which protects the cache. */
+   std::mutex Mutex;
+
+   /** The socket on which address change notifications are received, or -1 if they are not available. */
+   int NetlinkSocket;
+
+   /** The time at which the addresses were last refreshed. */
+   std::chrono::steady_clock::time_point RefreshTime;
+};
+
 Error restorePrivilegesImpl(uid_t in_uid)
 {
    // Reset error state.
@@ -131,6 +241,44 @@ Error getIpAddresses(std::vector<IpAddress>& out_addresses, bool in_includeIPv6)
     return Success();
 }
 
+Error getReachableIpAddresses(IpAddressListPtr& out_addresses)
+{
+   // Leaked intentionally so it can be used during static destruction.
+   static IpAddressCache& cache = *new IpAddressCache();
+
+   LOCK_MUTEX(cache.Mutex)
+   {
+      // Pending notifications are consumed before the addresses are read, so any change after this point will cause
+      // the next call to refresh them again. If reading them fails, the cache stays stale.
+      if (cache.isStale())
+      {
+         std::vector<IpAddress> addresses;
+         Error error = getIpAddresses(addresses, true);
+         if (error)
+            return error;
+
+         std::shared_ptr<std::vector<std::string> > reachableAddresses(new std::vector<std::string>());
+         for (const IpAddress& addr: addresses)
+         {
+            // Skip the loop-back and link local addresses.
+            if ((addr.Address.find("127") != 0) &&
+               (addr.Address.find("::1") != 0) &&
+               (addr.Address.find('%') == std::string::npos))
+               reachableAddresses->push_back(addr.Address);
+         }
+
+         cache.Addresses = reachableAddresses;
+         cache.IsRefreshRequired = false;
+         cache.RefreshTime = std::chrono::steady_clock::now();
+      }
+
+      out_addresses = cache.Addresses;
+   }
+   END_LOCK_MUTEX
+
+   return Success();
+}
+
 Error ignoreSignal(int in_signal)
 {
    struct sigaction sa;
@@ -148,6 +296,28 @@ Error ignoreSignal(int in_signal)
    return Success();
 }
 
+Error pinCurrentThreadToCore(unsigned int in_core)
+{
+   long numCores = ::sysconf(_SC_NPROCESSORS_ONLN);
+   if (numCores <= 0)
+      return systemError(errno, ERROR_LOCATION);
+
+   cpu_set_t cpuSet;
+   CPU_ZERO(&cpuSet);
+   CPU_SET(in_core % numCores, &cpuSet);
+
+   // pthread_setaffinity_np returns the error code rather than setting errno.
+   int result = ::pthread_setaffinity_np(::pthread_self(), sizeof(cpu_set_t), &cpuSet);
+   if (result != 0)
+   {
+      Error error = systemError(result, ERROR_LOCATION);
+      error.addProperty("core", static_cast<int>(in_core % numCores));
+      return error;
+   }
+
+   return Success();
+}
+
 bool realUserIsRoot()
 {
    return ::getuid() == 0;
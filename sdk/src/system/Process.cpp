@@ -25,11 +25,14 @@
 
 #include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <dirent.h>
 #include <fcntl.h>
+#include <future>
 #include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
+#include <thread>
 #include <unordered_set>
 
 #include <boost/regex.hpp>
@@ -44,6 +47,7 @@
 #include <utils/FileUtils.hpp>
 
 #include "../utils/ErrorUtils.hpp"
+#include "ScopedThreadRoot.hpp"
 
 namespace rstudio {
 namespace launcher_plugins {
@@ -246,21 +250,6 @@ int changeUser(uid_t in_uid, gid_t in_gid)
    return 0;
 }
 
-/**
- * @brief Changes the user after fork.
- * 
- * @param in_user    The new user. No action is taken if this object is empty.
- * 
- * @return 0 on success; the error code that occurred otherwise.
- */
-int changeUser(const system::User& in_user)
-{
-   if (in_user.isEmpty())
-      return 0;
-
-   return changeUser(in_user.getUserId(), in_user.getGroupId());
-}
-
 /**
  * @brief Clears the signal mask of the current process.
  *
@@ -407,43 +396,6 @@ Error createPipes(FileDescriptors& out_fds)
    return error;
 }
 
-Error forkAndRun(
-   const std::function<int()>& in_function,
-   const system::User& in_user = system::User(true))
-{
-   pid_t pid = ::fork();
-   if (pid < 0)
-      return systemError(errno, ERROR_LOCATION);
-
-   // If we're in the child process, change users if necessary and then run the requested function.
-   if (pid == 0)
-   {
-      int ret = changeUser(in_user);
-      if (ret != 0)
-         ::_exit(ret);
-
-      ::_exit(in_function());
-   }
-   // Otherwise we're in the parent process, so wait for the child to exit and report the result.
-   else
-   {
-      int status;
-      pid_t result = posix::posixCall<pid_t>(std::bind(::waitpid, pid, &status, 0));
-
-      // Ignore child already reaped errors.
-      if ((result == -1) && (errno != ECHILD))
-         return systemError(errno, ERROR_LOCATION);
-      else if (result == 0)
-      {
-         int exitStatus = getExitCodeFromStatus(status);
-         if (exitStatus != 0)
-            return systemError(errno, ERROR_LOCATION);
-      }
-   }
-   
-   return Success();
-}
-
 /**
  * @brief Gets the process exit code from its exit status.
  *
@@ -557,6 +509,109 @@ int sendSignal(int in_pid, int in_signal)
    return 0;
 }
 
+/**
+ * @brief Thread which sends signals on behalf of the rest of the process, with root privileges if necessary.
+ *
+ * Only this thread regains root, and only for the duration of the kill calls. See ScopedThreadRoot.
+ */
+class SignalThread
+{
+public:
+   /**
+    * @brief Gets the single instance of the signal thread, starting it if necessary.
+    *
+    * The instance is intentionally never destroyed so the thread doesn't need to be joined during static destruction.
+    *
+    * @return The single instance of the signal thread.
+    */
+   static SignalThread& getInstance()
+   {
+      static SignalThread* instance = new SignalThread();
+      return *instance;
+   }
+
+   /**
+    * @brief Sends the signal to each of the specified processes and waits for the result.
+    *
+    * @param in_pids        The IDs of the processes to signal. Negative values signal a process group.
+    * @param in_signal      The signal to send.
+    *
+    * @return 0 on success; the last error number that occurred otherwise.
+    */
+   int signal(std::vector<pid_t> in_pids, int in_signal)
+   {
+      Request request;
+      request.Pids = std::move(in_pids);
+      request.Signal = in_signal;
+      std::future<int> result = request.Result.get_future();
+
+      {
+         std::lock_guard<std::mutex> lock(m_mutex);
+         m_requests.push_back(std::move(request));
+      }
+
+      m_condVar.notify_one();
+      return result.get();
+   }
+
+private:
+   /**
+    * @brief A request to send a signal.
+    */
+   struct Request
+   {
+      std::vector<pid_t> Pids;
+      int Signal;
+      std::promise<int> Result;
+   };
+
+   SignalThread() :
+      m_thread(&SignalThread::run, this)
+   {
+      m_thread.detach();
+   }
+
+   void run()
+   {
+      while (true)
+      {
+         std::deque<Request> requests;
+         {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condVar.wait(lock, [this]() { return !m_requests.empty(); });
+            requests.swap(m_requests);
+         }
+
+         for (Request& request: requests)
+            request.Result.set_value(sendSignals(request.Pids, request.Signal));
+      }
+   }
+
+   static int sendSignals(const std::vector<pid_t>& in_pids, int in_signal)
+   {
+      // Elevate this thread only if the process has dropped root but may regain it.
+      ScopedThreadRoot elevation;
+
+      // Signal all the processes, storing the last error number. It's most important that we report that there was
+      // some sort of error signalling these processes, as opposed to reporting each exact error (if there were
+      // multiple).
+      int ret = 0;
+      for (pid_t pid: in_pids)
+      {
+         int tmp = sendSignal(pid, in_signal);
+         if (tmp != 0)
+            ret = tmp;
+      }
+
+      return ret;
+   }
+
+   std::condition_variable m_condVar;
+   std::mutex m_mutex;
+   std::deque<Request> m_requests;
+   std::thread m_thread;
+};
+
 /**
  * @brief Reads a string from the specified pipe.
  *
@@ -781,6 +836,9 @@ struct AbstractChildProcess::Impl
       StdInFd(-1),
       StdOutFd(-1)
    {
+      if (!in_options.ControlGroup.isEmpty())
+         setControlGroup(in_options.ControlGroup);
+
       if (IsRSandbox)
       {
          Executable = options::Options::getInstance().getRSandboxPath().getAbsolutePath();
@@ -976,6 +1034,16 @@ struct AbstractChildProcess::Impl
       if (::setpgid(0, 0) == -1)
          ::exit(s_threadSafeExitError);
 
+      // Move into the requested cgroup before anything else runs, so every descendant process will be accounted to it.
+      // Writing 0 to cgroup.procs moves the writing process.
+      if (!ControlGroupProcsFile.empty())
+      {
+         int fd = ::open(ControlGroupProcsFile.c_str(), O_WRONLY | O_CLOEXEC);
+         if ((fd == -1) || (::write(fd, "0", 1) != 1))
+            ::_exit(s_threadSafeExitError);
+         ::close(fd);
+      }
+
       if (clearSignalMask() != 0)
          ::exit(s_threadSafeExitError);
 
@@ -1048,12 +1116,41 @@ struct AbstractChildProcess::Impl
 
    }
 
+   /**
+    * @brief Sets the cgroup into which the child should be moved, if this process can move processes into it.
+    *
+    * The child can only exit if it fails to move itself into the cgroup, so check first and launch it without the
+    * cgroup instead. Opening cgroup.procs for writing doesn't move any processes.
+    *
+    * @param in_controlGroup    The cgroup v2 directory into which the child should be moved.
+    */
+   void setControlGroup(const FilePath& in_controlGroup)
+   {
+      std::string procsFile = in_controlGroup.completeChildPath("cgroup.procs").getAbsolutePath();
+      int fd = ::open(procsFile.c_str(), O_WRONLY | O_CLOEXEC);
+      if (fd == -1)
+      {
+         Error error = systemError(
+            errno,
+            "Cannot move the process into cgroup " + in_controlGroup.getAbsolutePath() + ". Launching it without one.",
+            ERROR_LOCATION);
+         logging::logError(error);
+         return;
+      }
+
+      ::close(fd);
+      ControlGroupProcsFile = procsFile;
+   }
+
    /** The list of RSandbox arguments. */
    std::vector<std::string> Arguments;
 
    /** Whether to close the stdin FD after writing StandardInput. */
    bool CloseStdin;
 
+   /** The cgroup.procs file of the cgroup into which the child should be moved, if any. */
+   std::string ControlGroupProcsFile;
+
    /** The list of arguments. */
    std::vector<std::string> Environment;
 
@@ -1898,14 +1995,10 @@ Error getChildProcesses(pid_t in_parentPid, std::vector<ProcessInfo>& out_proces
 
 Error signalProcess(pid_t in_pid, int in_signal, bool in_processGroupOnly)
 {
-   std::function<int()> signalFunction;
+   // Signalling the process group reaches every process in the group with a single call.
+   std::vector<pid_t> pids;
    if (in_processGroupOnly)
-   {
-      signalFunction = [in_pid, in_signal]()
-      {
-          return sendSignal(-in_pid, in_signal);
-      };
-   }
+      pids.push_back(-in_pid);
    else
    {
       std::vector<ProcessInfo> children;
@@ -1913,30 +2006,16 @@ Error signalProcess(pid_t in_pid, int in_signal, bool in_processGroupOnly)
       if (error)
          return error;
 
-      signalFunction = [in_pid, in_signal, children]()
-      {
-         // Kill the process and all its children, storing the last error number. It's most improtant that we report
-         // that there was some sort of error killing all these processes, as opposed to reporting each exact error (if
-         // there were multiple).
-         int ret = sendSignal(in_pid, in_signal);
-
-         for (const ProcessInfo& child: children)
-         {
-            int tmp = sendSignal(child.Pid, in_signal);
-            if (tmp != 0)
-               ret = tmp;
-         }
-
-         return ret;
-      };
+      pids.push_back(in_pid);
+      for (const ProcessInfo& child: children)
+         pids.push_back(child.Pid);
    }
 
-   system::User rootUser;
-   Error error = system::User::getUserFromIdentifier(0, rootUser);
-   if (error)
-      return error;
+   int ret = SignalThread::getInstance().signal(std::move(pids), in_signal);
+   if (ret != 0)
+      return systemError(ret, ERROR_LOCATION);
 
-   return forkAndRun(signalFunction, rootUser);
+   return Success();
 }
 
 std::string shellEscape(const std::string& in_string)
@@ -0,0 +1,83 @@
+/*
+ * ScopedThreadRoot.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_SCOPED_THREAD_ROOT_HPP
+#define LAUNCHER_PLUGINS_SCOPED_THREAD_ROOT_HPP
+
+#include <Noncopyable.hpp>
+
+#include <cstdlib>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+/**
+ * @brief Gives the calling thread, and only the calling thread, root privileges for the lifetime of this object.
+ *
+ * On Linux, user IDs are per-thread at the kernel level and glibc only synchronizes them across threads when its own
+ * set*id functions are used. Using the raw system call allows a single thread to regain root from the saved set-user
+ * ID without forking or affecting the credentials of any other thread.
+ *
+ * Nothing is changed if the process is already running as root, or if it has no way to regain root.
+ */
+class ScopedThreadRoot : public Noncopyable
+{
+public:
+   /**
+    * @brief Constructor. Elevates the calling thread, if necessary and possible.
+    */
+   ScopedThreadRoot() :
+      m_euid(0),
+      m_isElevated(false)
+   {
+      uid_t ruid = 0, suid = 0;
+      if ((::getresuid(&ruid, &m_euid, &suid) == 0) && (m_euid != 0) && ((ruid == 0) || (suid == 0)))
+         m_isElevated = (::syscall(SYS_setresuid, -1, 0, -1) == 0);
+   }
+
+   /**
+    * @brief Destructor. Restores the calling thread's previous effective user.
+    */
+   ~ScopedThreadRoot()
+   {
+      // The thread can't safely keep running as root, so abort if privileges can't be dropped again.
+      if (m_isElevated && (::syscall(SYS_setresuid, -1, m_euid, -1) != 0))
+         std::abort();
+   }
+
+private:
+   /** The effective user ID of the thread before elevation. */
+   uid_t m_euid;
+
+   /** Whether the thread was elevated. */
+   bool m_isElevated;
+};
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
@@ -0,0 +1,359 @@
+/*
+ * TimerService.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include "TimerService.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <utils/MutexUtils.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+namespace {
+
+typedef TimerEntry::Clock Clock;
+
+/** The number of buckets each granularity covers before the next coarser granularity is used. */
+constexpr int64_t s_bucketsPerLevel = 64;
+
+/** The factor by which each granularity is coarser than the previous one. */
+constexpr int64_t s_levelFactor = 8;
+
+/** The number of granularities. */
+constexpr size_t s_numLevels = 3;
+
+/**
+ * @brief The entries which expire at the same time, in the order they were scheduled.
+ */
+struct Bucket
+{
+   Bucket() : First(nullptr), Last(nullptr) { }
+
+   /** The first entry in the bucket. */
+   TimerEntry* First;
+
+   /** The last entry in the bucket. */
+   TimerEntry* Last;
+};
+
+} // anonymous namespace
+
+// TimerEntry ==========================================================================================================
+TimerEntry::TimerEntry(AsioFunction in_onExpired, AsioPriority in_priority) :
+   m_onExpired(std::move(in_onExpired)),
+   m_priority(in_priority),
+   m_prev(nullptr),
+   m_next(nullptr),
+   m_isScheduled(false)
+{
+}
+
+TimerEntry::~TimerEntry()
+{
+   cancel();
+}
+
+void TimerEntry::cancel()
+{
+   TimerService::getInstance().cancel(*this);
+}
+
+bool TimerEntry::isScheduled() const
+{
+   return TimerService::getInstance().isScheduled(*this);
+}
+
+void TimerEntry::schedule(const Clock::duration& in_delay)
+{
+   TimerService::getInstance().schedule(*this, in_delay);
+}
+
+// TimerService ========================================================================================================
+struct TimerService::Impl
+{
+   Impl() :
+      Slack(std::chrono::milliseconds(10)),
+      IsStopped(false)
+   {
+   }
+
+   /**
+    * @brief Gets the expiry time of the bucket for an entry which should expire after the specified delay.
+    *
+    * @param in_delay   The minimum amount of time to wait before the entry expires.
+    *
+    * @return The expiry time of the bucket.
+    */
+   Clock::time_point getBucketTime(const Clock::duration& in_delay) const
+   {
+      Clock::duration granularity = Slack;
+      for (size_t level = 1; (level < s_numLevels) && (in_delay > granularity * s_bucketsPerLevel); ++level)
+         granularity *= s_levelFactor;
+
+      // Round up to a multiple of the granularity so that entries at every granularity line up.
+      Clock::duration expiry = Clock::now().time_since_epoch() + in_delay;
+      return Clock::time_point(((expiry + granularity - Clock::duration(1)) / granularity) * granularity);
+   }
+
+   /**
+    * @brief Adds an entry to the end of a bucket. The mutex must be held.
+    *
+    * @param io_entry       The entry to add.
+    * @param in_bucketTime  The expiry time of the bucket.
+    */
+   void link(TimerEntry& io_entry, const Clock::time_point& in_bucketTime)
+   {
+      Bucket& bucket = Buckets[in_bucketTime];
+      io_entry.m_prev = bucket.Last;
+      io_entry.m_next = nullptr;
+      if (bucket.Last != nullptr)
+         bucket.Last->m_next = &io_entry;
+      else
+         bucket.First = &io_entry;
+      bucket.Last = &io_entry;
+
+      io_entry.m_bucketTime = in_bucketTime;
+      io_entry.m_isScheduled = true;
+   }
+
+   /**
+    * @brief Removes an entry from its bucket, removing the bucket if it becomes empty. The mutex must be held.
+    *
+    * @param io_entry   The entry to remove.
+    */
+   void unlink(TimerEntry& io_entry)
+   {
+      if (!io_entry.m_isScheduled)
+         return;
+
+      auto itr = Buckets.find(io_entry.m_bucketTime);
+      if (itr != Buckets.end())
+      {
+         Bucket& bucket = itr->second;
+         if (io_entry.m_prev != nullptr)
+            io_entry.m_prev->m_next = io_entry.m_next;
+         else
+            bucket.First = io_entry.m_next;
+
+         if (io_entry.m_next != nullptr)
+            io_entry.m_next->m_prev = io_entry.m_prev;
+         else
+            bucket.Last = io_entry.m_prev;
+
+         if (bucket.First == nullptr)
+            Buckets.erase(itr);
+      }
+
+      io_entry.m_prev = nullptr;
+      io_entry.m_next = nullptr;
+      io_entry.m_isScheduled = false;
+   }
+
+   /**
+    * @brief Waits for buckets to expire and posts the functions of their entries until the service is stopped.
+    */
+   void run()
+   {
+      // Reuse the same storage for each expiry so that the functions can be posted once the mutex is released.
+      std::vector<std::pair<AsioFunction, AsioPriority> > expired;
+
+      UNIQUE_LOCK_MUTEX(Mutex)
+      {
+         while (!IsStopped)
+         {
+            if (Buckets.empty())
+            {
+               Condition.wait(uniqueLock);
+               continue;
+            }
+
+            Clock::time_point now = Clock::now();
+            if (now < Buckets.begin()->first)
+            {
+               Condition.wait_until(uniqueLock, Buckets.begin()->first);
+               continue;
+            }
+
+            auto end = Buckets.begin();
+            for (; (end != Buckets.end()) && (end->first <= now); ++end)
+            {
+               TimerEntry* entry = end->second.First;
+               while (entry != nullptr)
+               {
+                  TimerEntry* next = entry->m_next;
+                  expired.emplace_back(entry->m_onExpired, entry->m_priority);
+                  entry->m_prev = nullptr;
+                  entry->m_next = nullptr;
+                  entry->m_isScheduled = false;
+                  entry = next;
+               }
+            }
+            Buckets.erase(Buckets.begin(), end);
+
+            uniqueLock.unlock();
+            for (const auto& work: expired)
+               AsioService::post(work.first, work.second);
+            expired.clear();
+            uniqueLock.lock();
+         }
+      }
+      END_LOCK_MUTEX
+   }
+
+   /** Mutex to protect the buckets and the scheduling state of every entry. */
+   mutable std::mutex Mutex;
+
+   /** Notified when the earliest bucket changes or the service is stopped. */
+   std::condition_variable Condition;
+
+   /** The buckets which have entries, ordered by expiry time. */
+   std::map<Clock::time_point, Bucket> Buckets;
+
+   /** The granularity of buckets for entries which expire soon. */
+   Clock::duration Slack;
+
+   /** Whether the service has been stopped. */
+   bool IsStopped;
+
+   /** The thread which expires buckets. It is started when the first entry is scheduled. */
+   std::thread Thread;
+};
+
+PRIVATE_IMPL_DELETER_IMPL(TimerService)
+
+TimerService& TimerService::getInstance()
+{
+   // Never destroyed, so entries may be safely cancelled during static destruction.
+   static TimerService* timerService = new TimerService();
+   return *timerService;
+}
+
+size_t TimerService::getBucketCount() const
+{
+   size_t count = 0;
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      count = m_impl->Buckets.size();
+   }
+   END_LOCK_MUTEX
+
+   return count;
+}
+
+void TimerService::setSlack(const TimerEntry::Clock::duration& in_slack)
+{
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      m_impl->Slack = std::max<Clock::duration>(in_slack, std::chrono::milliseconds(1));
+   }
+   END_LOCK_MUTEX
+}
+
+void TimerService::start()
+{
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      m_impl->IsStopped = false;
+   }
+   END_LOCK_MUTEX
+}
+
+void TimerService::stop()
+{
+   std::thread thread;
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      m_impl->IsStopped = true;
+      while (!m_impl->Buckets.empty())
+         m_impl->unlink(*m_impl->Buckets.begin()->second.First);
+
+      thread = std::move(m_impl->Thread);
+   }
+   END_LOCK_MUTEX
+
+   m_impl->Condition.notify_all();
+   if (thread.joinable())
+      thread.join();
+}
+
+TimerService::TimerService() :
+   m_impl(new Impl())
+{
+}
+
+void TimerService::cancel(TimerEntry& io_entry)
+{
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      m_impl->unlink(io_entry);
+   }
+   END_LOCK_MUTEX
+}
+
+bool TimerService::isScheduled(const TimerEntry& in_entry) const
+{
+   bool isScheduled = false;
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      isScheduled = in_entry.m_isScheduled;
+   }
+   END_LOCK_MUTEX
+
+   return isScheduled;
+}
+
+void TimerService::schedule(TimerEntry& io_entry, const TimerEntry::Clock::duration& in_delay)
+{
+   bool notify = false;
+   LOCK_MUTEX(m_impl->Mutex)
+   {
+      if (m_impl->IsStopped)
+         return;
+
+      if (!m_impl->Thread.joinable())
+         m_impl->Thread = std::thread([this]() { m_impl->run(); });
+
+      m_impl->unlink(io_entry);
+
+      Clock::time_point bucketTime = m_impl->getBucketTime(in_delay);
+      notify = m_impl->Buckets.empty() || (bucketTime < m_impl->Buckets.begin()->first);
+      m_impl->link(io_entry, bucketTime);
+   }
+   END_LOCK_MUTEX
+
+   // Only wake the timer thread if it needs to expire this entry sooner than it was going to wake up.
+   if (notify)
+      m_impl->Condition.notify_one();
+}
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
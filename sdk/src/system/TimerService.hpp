@@ -0,0 +1,199 @@
+/*
+ * TimerService.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#ifndef LAUNCHER_PLUGINS_TIMER_SERVICE_HPP
+#define LAUNCHER_PLUGINS_TIMER_SERVICE_HPP
+
+#include <Noncopyable.hpp>
+
+#include <chrono>
+
+#include <PImpl.hpp>
+#include <system/Asio.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+class TimerService;
+
+/**
+ * @brief A callback which may be scheduled to be posted to the AsioService at a later time by the TimerService.
+ *
+ * The entry holds all of the state the TimerService needs to track it, so cancelling it never allocates. Destroying a
+ * scheduled entry cancels it.
+ */
+class TimerEntry final : public Noncopyable
+{
+public:
+   /** The clock used to schedule entries. */
+   typedef std::chrono::steady_clock Clock;
+
+   /**
+    * @brief Constructor.
+    *
+    * @param in_onExpired   The function to post to the AsioService when the entry expires.
+    * @param in_priority    The priority lane to which in_onExpired should be posted.
+    */
+   explicit TimerEntry(AsioFunction in_onExpired, AsioPriority in_priority = AsioPriority::NORMAL);
+
+   /**
+    * @brief Destructor. Cancels the entry if it is scheduled.
+    */
+   ~TimerEntry();
+
+   /**
+    * @brief Cancels the entry, if it is scheduled. This does not allocate.
+    *
+    * If the entry has already expired, its function may still be waiting to run on the AsioService.
+    */
+   void cancel();
+
+   /**
+    * @brief Checks whether the entry is currently scheduled.
+    *
+    * @return True if the entry is scheduled and has not yet expired; false otherwise.
+    */
+   bool isScheduled() const;
+
+   /**
+    * @brief Schedules the entry to expire after the specified delay. If the entry is already scheduled, it is
+    *        rescheduled.
+    *
+    * @param in_delay   The minimum amount of time to wait before the entry expires.
+    */
+   void schedule(const Clock::duration& in_delay);
+
+private:
+   // The TimerService manages the scheduling state of the entry.
+   friend class TimerService;
+
+   /** The function to post when the entry expires. */
+   AsioFunction m_onExpired;
+
+   /** The priority lane to which m_onExpired is posted. */
+   AsioPriority m_priority;
+
+   /** The previous entry in the same bucket. */
+   TimerEntry* m_prev;
+
+   /** The next entry in the same bucket. */
+   TimerEntry* m_next;
+
+   /** The expiry time of the bucket this entry belongs to. */
+   Clock::time_point m_bucketTime;
+
+   /** Whether the entry is in a bucket. */
+   bool m_isScheduled;
+};
+
+/**
+ * @brief Single service which expires all TimerEntry instances in the process.
+ *
+ * Expiry times are rounded up to a granularity so that entries which expire close together share a bucket and are
+ * posted together, with a single wake up. The granularity is the configured slack for entries that expire soon, and
+ * grows in steps for entries that expire further in the future. Each coarser granularity is a multiple of the finer
+ * ones, so entries scheduled far in advance share buckets with entries scheduled shortly before they expire.
+ *
+ * Expired functions are posted to the AsioService without holding any lock of the TimerService.
+ */
+class TimerService final : public Noncopyable
+{
+public:
+   /**
+    * @brief Gets the single TimerService for this process.
+    *
+    * @return The single TimerService for this process.
+    */
+   static TimerService& getInstance();
+
+   /**
+    * @brief Gets the number of buckets which currently have scheduled entries.
+    *
+    * @return The number of buckets which currently have scheduled entries.
+    */
+   size_t getBucketCount() const;
+
+   /**
+    * @brief Sets the amount of time by which the expiry of soon to expire entries may be delayed, so they can be
+    *        grouped. Entries which are already scheduled are not affected.
+    *
+    * @param in_slack   The slack. Values of less than one millisecond are treated as one millisecond.
+    */
+   void setSlack(const TimerEntry::Clock::duration& in_slack);
+
+   /**
+    * @brief Starts the service again after it was stopped. The thread which expires entries is started when the next
+    *        entry is scheduled.
+    */
+   void start();
+
+   /**
+    * @brief Stops the service. Scheduled entries will not expire, and entries scheduled before the service is started
+    *        again will be ignored.
+    */
+   void stop();
+
+private:
+   /**
+    * @brief Constructor.
+    */
+   TimerService();
+
+   /**
+    * @brief Removes an entry from its bucket.
+    *
+    * @param io_entry   The entry to remove.
+    */
+   void cancel(TimerEntry& io_entry);
+
+   /**
+    * @brief Checks whether an entry is in a bucket.
+    *
+    * @param in_entry   The entry to check.
+    *
+    * @return True if the entry is in a bucket; false otherwise.
+    */
+   bool isScheduled(const TimerEntry& in_entry) const;
+
+   /**
+    * @brief Adds an entry to the bucket for the specified delay, removing it from its current bucket if required.
+    *
+    * @param io_entry   The entry to add.
+    * @param in_delay   The minimum amount of time to wait before the entry expires.
+    */
+   void schedule(TimerEntry& io_entry, const TimerEntry::Clock::duration& in_delay);
+
+   // TimerEntry schedules itself through the service.
+   friend class TimerEntry;
+
+   // The private implementation of TimerService.
+   PRIVATE_IMPL(m_impl);
+};
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
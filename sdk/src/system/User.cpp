@@ -25,17 +25,38 @@
 
 #include <pwd.h>
 
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+
 #include <boost/algorithm/string.hpp>
 
 #include <Error.hpp>
+#include <system/DateTime.hpp>
 #include <system/FilePath.hpp>
 #include "SafeConvert.hpp"
 #include <system/PosixSystem.hpp>
+#include <utils/MutexUtils.hpp>
+
+#include "LookupCache.hpp"
 
 namespace rstudio {
 namespace launcher_plugins {
 namespace system {
 
+namespace {
+
+typedef LookupCache<std::string, User> UserNameCache;
+typedef LookupCache<UidType, User> UserIdCache;
+
+constexpr unsigned int s_defaultTtlSeconds = 300;
+constexpr unsigned int s_defaultNegativeTtlSeconds = 30;
+
+/** The number of shared user details after which unreferenced details are dropped. */
+constexpr size_t s_internPurgeThreshold = 1024;
+
+} // anonymous namespace
+
 struct User::Impl
 {
    template<class T>
@@ -44,6 +65,106 @@ struct User::Impl
    Impl() : UserId(-1), GroupId(-1)
    { };
 
+   static std::shared_ptr<UserNameCache> getUserNameCache()
+   {
+      static std::shared_ptr<UserNameCache> cache = std::make_shared<UserNameCache>(
+         [](const std::string& in_username, User& out_user)
+         {
+            return lookupUser<const char*>(::getpwnam_r, in_username.c_str(), out_user);
+         },
+         std::chrono::seconds(s_defaultTtlSeconds),
+         std::chrono::seconds(s_defaultNegativeTtlSeconds));
+      return cache;
+   }
+
+   static std::shared_ptr<UserIdCache> getUserIdCache()
+   {
+      static std::shared_ptr<UserIdCache> cache = std::make_shared<UserIdCache>(
+         [](UidType in_userId, User& out_user)
+         {
+            return lookupUser<UidType>(::getpwuid_r, in_userId, out_user);
+         },
+         std::chrono::seconds(s_defaultTtlSeconds),
+         std::chrono::seconds(s_defaultNegativeTtlSeconds));
+      return cache;
+   }
+
+   template<typename T>
+   static Error lookupUser(const GetPasswdFunc<T>& in_getPasswdFunc, T in_value, User& out_user)
+   {
+      std::shared_ptr<Impl> impl(new Impl());
+      Error error = impl->populateUser<T>(in_getPasswdFunc, in_value);
+      if (!error)
+         out_user.m_impl = intern(impl);
+
+      return error;
+   }
+
+   /**
+    * @brief Gets the shared details of the user with the same details as the provided ones, so that every User object
+    *        for the same user shares one copy of the details.
+    *
+    * @param in_impl    The newly looked up details of a user.
+    *
+    * @return The shared details which are equal to in_impl.
+    */
+   static std::shared_ptr<Impl> intern(const std::shared_ptr<Impl>& in_impl)
+   {
+      static std::mutex* mutex = new std::mutex();
+      static auto* users = new std::unordered_map<UidType, std::weak_ptr<Impl> >();
+
+      LOCK_MUTEX(*mutex)
+      {
+         std::weak_ptr<Impl>& entry = (*users)[in_impl->UserId];
+         std::shared_ptr<Impl> existing = entry.lock();
+         if ((existing != nullptr) && (*existing == *in_impl))
+            return existing;
+
+         entry = in_impl;
+
+         // Drop the entries of users which are no longer referenced once there are many of them.
+         if (users->size() > s_internPurgeThreshold)
+         {
+            for (auto itr = users->begin(); itr != users->end();)
+               itr = itr->second.expired() ? users->erase(itr) : std::next(itr);
+         }
+      }
+      END_LOCK_MUTEX
+
+      return in_impl;
+   }
+
+   /**
+    * @brief Gets the shared details of the empty user or of all users.
+    *
+    * @param in_isEmpty     True to get the details of the empty user; false to get the details of all users.
+    *
+    * @return The shared details of the empty user or of all users.
+    */
+   static const std::shared_ptr<Impl>& getSpecialUser(bool in_isEmpty)
+   {
+      static const std::shared_ptr<Impl>* emptyUser = new std::shared_ptr<Impl>(createSpecialUser(""));
+      static const std::shared_ptr<Impl>* allUsers = new std::shared_ptr<Impl>(createSpecialUser("*"));
+      return in_isEmpty ? *emptyUser : *allUsers;
+   }
+
+   static std::shared_ptr<Impl> createSpecialUser(const std::string& in_name)
+   {
+      std::shared_ptr<Impl> impl(new Impl());
+      impl->Name = in_name;
+      return impl;
+   }
+
+   bool operator==(const Impl& in_other) const
+   {
+      return (UserId == in_other.UserId) &&
+         (GroupId == in_other.GroupId) &&
+         (Name == in_other.Name) &&
+         (RealName == in_other.RealName) &&
+         (HomeDirectory == in_other.HomeDirectory) &&
+         (Shell == in_other.Shell);
+   }
+
    template<typename T>
    Error populateUser(const GetPasswdFunc<T>& in_getPasswdFunc, T in_value)
    {
@@ -112,16 +233,13 @@ struct User::Impl
    std::string Shell;
 };
 
-PRIVATE_IMPL_DELETER_IMPL(User)
-
 User::User(bool in_isEmpty) :
-   m_impl(new Impl())
+   m_impl(Impl::getSpecialUser(in_isEmpty))
 {
-   m_impl->Name = in_isEmpty ? "" : "*";
 }
 
 User::User(const User& in_other) :
-   m_impl(new Impl(*in_other.m_impl))
+   m_impl(in_other.m_impl)
 {
 }
 
@@ -132,23 +250,30 @@ Error User::getCurrentUser(User& out_currentUser)
 
 Error User::getUserFromIdentifier(const std::string& in_username, User& out_user)
 {
-   User user;
+   return Impl::getUserNameCache()->get(in_username, out_user);
+}
 
-   Error error = user.m_impl->populateUser<const char*>(::getpwnam_r, in_username.c_str());
-   if (!error)
-      out_user = user;
+Error User::getUserFromIdentifier(UidType in_userId, User& out_user)
+{
+   return Impl::getUserIdCache()->get(in_userId, out_user);
+}
 
-   return error;
+void User::invalidateCache()
+{
+   Impl::getUserNameCache()->invalidate();
+   Impl::getUserIdCache()->invalidate();
 }
 
-Error User::getUserFromIdentifier(UidType in_userId, User& out_user)
+void User::setCacheTimeouts(const TimeDuration& in_ttl, const TimeDuration& in_negativeTtl)
 {
-   User user;
-   Error error = user.m_impl->populateUser<UidType>(::getpwuid_r, in_userId);
-   if (!error)
-      out_user = user;
+   auto toChrono = [](const TimeDuration& in_duration)
+   {
+      return std::chrono::seconds(
+         (in_duration.getHours() * 3600) + (in_duration.getMinutes() * 60) + in_duration.getSeconds());
+   };
 
-   return error;
+   Impl::getUserNameCache()->setTimeouts(toChrono(in_ttl), toChrono(in_negativeTtl));
+   Impl::getUserIdCache()->setTimeouts(toChrono(in_ttl), toChrono(in_negativeTtl));
 }
 
 FilePath User::getUserHomePath(const std::string& in_envOverride)
@@ -178,28 +303,16 @@ FilePath User::getUserHomePath(const std::string& in_envOverride)
 
 User& User::operator=(const User& in_other)
 {
-   if (this == &in_other)
-      return *this;
-
-   if ((m_impl == nullptr) && (in_other.m_impl == nullptr))
-      return *this;
-
-   if (in_other.m_impl == nullptr)
-   {
-      m_impl.reset();
-      return *this;
-   }
-
-   if (m_impl == nullptr)
-      m_impl.reset(new Impl());
-
-   *m_impl = *in_other.m_impl;
-
+   m_impl = in_other.m_impl;
    return *this;
 }
 
 bool User::operator==(const User& in_other) const
 {
+   // Users which were looked up share their details, so this is the common case.
+   if (m_impl == in_other.m_impl)
+      return true;
+
    // If one or the other is empty but not both, these objects aren't equal.
    if (isEmpty() != in_other.isEmpty())
       return false;
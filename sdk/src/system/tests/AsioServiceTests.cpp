@@ -0,0 +1,161 @@
+/*
+ * AsioServiceTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <TestMain.hpp>
+
+#include <unistd.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <system/Asio.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+namespace {
+
+/**
+ * @brief Blocks the single ASIO worker thread until released, so that work can be queued behind it.
+ */
+struct Gate
+{
+   Gate() : IsEntered(false), IsOpen(false) { }
+
+   void wait()
+   {
+      std::unique_lock<std::mutex> lock(Mutex);
+      IsEntered = true;
+      CondVar.notify_all();
+      CondVar.wait(lock, [this]() { return IsOpen; });
+   }
+
+   void waitUntilEntered()
+   {
+      std::unique_lock<std::mutex> lock(Mutex);
+      CondVar.wait(lock, [this]() { return IsEntered; });
+   }
+
+   void open()
+   {
+      std::unique_lock<std::mutex> lock(Mutex);
+      IsOpen = true;
+      CondVar.notify_all();
+   }
+
+   bool IsEntered;
+   bool IsOpen;
+   std::mutex Mutex;
+   std::condition_variable CondVar;
+};
+
+bool waitForCount(const std::atomic<size_t>& in_count, size_t in_expected)
+{
+   for (int i = 0; (i < 500) && (in_count.load() < in_expected); ++i)
+      usleep(10000);
+
+   return in_count.load() == in_expected;
+}
+
+struct Recorder
+{
+   Recorder() : Count(0) { }
+
+   AsioFunction record(char in_lane)
+   {
+      return [this, in_lane]()
+      {
+         std::lock_guard<std::mutex> lock(Mutex);
+         Order.push_back(in_lane);
+         Count.fetch_add(1);
+      };
+   }
+
+   std::mutex Mutex;
+   std::vector<char> Order;
+   std::atomic<size_t> Count;
+};
+
+} // anonymous namespace
+
+TEST_CASE("Start ASIO service")
+{
+   // Use a single thread so the order of execution is deterministic.
+   AsioService::startThreads(1);
+}
+
+TEST_CASE("Higher priority work runs first")
+{
+   Gate gate;
+   Recorder recorder;
+   AsioService::post([&gate]() { gate.wait(); });
+   gate.waitUntilEntered();
+   for (int i = 0; i < 3; ++i)
+      AsioService::post(recorder.record('L'), AsioPriority::LOW);
+   for (int i = 0; i < 3; ++i)
+      AsioService::post(recorder.record('N'));
+   for (int i = 0; i < 3; ++i)
+      AsioService::post(recorder.record('H'), AsioPriority::HIGH);
+
+   gate.open();
+   REQUIRE(waitForCount(recorder.Count, 9));
+   CHECK(recorder.Order == std::vector<char>({ 'H', 'H', 'H', 'N', 'N', 'N', 'L', 'L', 'L' }));
+}
+
+TEST_CASE("Lower priority work is not starved")
+{
+   Gate gate;
+   Recorder recorder;
+   AsioService::post([&gate]() { gate.wait(); }, AsioPriority::LOW);
+   gate.waitUntilEntered();
+   for (int i = 0; i < 2; ++i)
+      AsioService::post(recorder.record('L'), AsioPriority::LOW);
+   for (int i = 0; i < 40; ++i)
+      AsioService::post(recorder.record('H'), AsioPriority::HIGH);
+
+   gate.open();
+   REQUIRE(waitForCount(recorder.Count, 42));
+
+   size_t firstLow = 0;
+   while ((firstLow < recorder.Order.size()) && (recorder.Order[firstLow] != 'L'))
+      ++firstLow;
+   CHECK(firstLow < 10);
+
+   AsioQueueStats stats = AsioService::getQueueStats(AsioPriority::HIGH);
+   CHECK(stats.QueuedCount == 0);
+   CHECK(stats.CompletedCount >= 40);
+   CHECK(stats.MaxWaitMicroseconds > 0);
+   CHECK(stats.TotalWaitMicroseconds >= stats.MaxWaitMicroseconds);
+}
+
+TEST_CASE("Stop ASIO service")
+{
+   AsioService::stop();
+   AsioService::waitForExit();
+}
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -0,0 +1,173 @@
+/*
+ * AsioWorkerPoolTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <TestMain.hpp>
+
+#include <unistd.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <system/Asio.hpp>
+#include <system/DateTime.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+namespace {
+
+bool waitForCount(const std::atomic<size_t>& in_count, size_t in_expected)
+{
+   for (int i = 0; (i < 500) && (in_count.load() < in_expected); ++i)
+      usleep(10000);
+
+   return in_count.load() == in_expected;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Start ASIO service")
+{
+   AsioService::startThreads(4, AsioExecutionMode::PER_WORKER, true);
+}
+
+TEST_CASE("Work posted from a non-worker thread is run")
+{
+   std::atomic<size_t> count = { 0 };
+   for (int i = 0; i < 100; ++i)
+      AsioService::post([&count]() { count.fetch_add(1); });
+
+   REQUIRE(waitForCount(count, 100));
+}
+
+TEST_CASE("Work posted from a busy worker is stolen by an idle worker")
+{
+   std::mutex mutex;
+   std::condition_variable condVar;
+   bool innerDone = false;
+   std::thread::id outerThread, innerThread;
+   std::atomic<size_t> count = { 0 };
+
+   AsioService::post(
+      [&]()
+      {
+         outerThread = std::this_thread::get_id();
+
+         // This is queued on the current worker, which stays busy until the inner work completes, so the inner work
+         // can only complete if another worker steals it.
+         AsioService::post(
+            [&]()
+            {
+               std::unique_lock<std::mutex> lock(mutex);
+               innerThread = std::this_thread::get_id();
+               innerDone = true;
+               condVar.notify_all();
+            });
+
+         std::unique_lock<std::mutex> lock(mutex);
+         condVar.wait_for(lock, std::chrono::seconds(5), [&]() { return innerDone; });
+         count.fetch_add(1);
+      });
+
+   REQUIRE(waitForCount(count, 1));
+   std::unique_lock<std::mutex> lock(mutex);
+   CHECK(innerDone);
+   CHECK(innerThread != outerThread);
+}
+
+TEST_CASE("Consecutive posts from a busy worker wake different idle workers")
+{
+   std::mutex mutex;
+   std::condition_variable condVar;
+   size_t started = 0;
+   std::atomic<size_t> count = { 0 }, concurrent = { 0 };
+
+   AsioService::post(
+      [&]()
+      {
+         // Each inner work item waits until all of them have started, so they can only all complete together if each
+         // is stolen by a different idle worker.
+         for (int i = 0; i < 3; ++i)
+         {
+            AsioService::post(
+               [&]()
+               {
+                  std::unique_lock<std::mutex> lock(mutex);
+                  ++started;
+                  condVar.notify_all();
+                  if (condVar.wait_for(lock, std::chrono::seconds(5), [&]() { return started == 3; }))
+                     concurrent.fetch_add(1);
+               });
+         }
+
+         std::unique_lock<std::mutex> lock(mutex);
+         condVar.wait_for(lock, std::chrono::seconds(10), [&]() { return started == 3; });
+         count.fetch_add(1);
+      });
+
+   REQUIRE(waitForCount(count, 1));
+   CHECK(waitForCount(concurrent, 3));
+}
+
+TEST_CASE("Timers created on a worker fire")
+{
+   std::atomic<size_t> count = { 0 };
+   std::shared_ptr<AsyncDeadlineEvent> deadline;
+   std::mutex mutex;
+
+   AsioService::post(
+      [&]()
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         deadline.reset(
+            new AsyncDeadlineEvent([&count]() { count.fetch_add(1); }, TimeDuration::Microseconds(100000)));
+         deadline->start();
+      });
+
+   REQUIRE(waitForCount(count, 1));
+}
+
+TEST_CASE("Priority lanes are aggregated across workers")
+{
+   std::atomic<size_t> count = { 0 };
+   AsioQueueStats before = AsioService::getQueueStats(AsioPriority::HIGH);
+   for (int i = 0; i < 10; ++i)
+      AsioService::post([&count]() { count.fetch_add(1); }, AsioPriority::HIGH);
+
+   REQUIRE(waitForCount(count, 10));
+   AsioQueueStats after = AsioService::getQueueStats(AsioPriority::HIGH);
+   CHECK(after.CompletedCount == before.CompletedCount + 10);
+   CHECK(after.QueuedCount == 0);
+}
+
+TEST_CASE("Stop ASIO service")
+{
+   AsioService::stop();
+   AsioService::waitForExit();
+}
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -0,0 +1,174 @@
+/*
+ * CachedCommandRunnerTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <TestMain.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <unistd.h>
+
+#include <AsioRaii.hpp>
+#include <system/CachedCommandRunner.hpp>
+#include <system/FilePath.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+namespace {
+
+/** The parsed output of the fake scheduler: job states by job ID. */
+typedef std::map<std::string, std::string> JobStates;
+typedef CachedCommandRunner<JobStates> Runner;
+
+void parseJobLine(const std::string& in_line, JobStates& io_states)
+{
+   size_t idEnd = in_line.find('|');
+   size_t stateEnd = in_line.find('|', idEnd + 1);
+   REQUIRE(idEnd != std::string::npos);
+   REQUIRE(stateEnd != std::string::npos);
+   io_states[in_line.substr(0, idEnd)] = in_line.substr(idEnd + 1, stateEnd - idEnd - 1);
+}
+
+size_t countLines(const FilePath& in_file)
+{
+   std::ifstream file(in_file.getAbsolutePath());
+   size_t count = 0;
+   std::string line;
+   while (std::getline(file, line))
+      ++count;
+   return count;
+}
+
+bool waitFor(const std::atomic<int>& in_count, int in_expected)
+{
+   // Wait for at most 10 seconds.
+   for (int i = 0; (i < 1000) && (in_count.load() < in_expected); ++i)
+      usleep(10000);
+   return in_count.load() == in_expected;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Cached command runner")
+{
+   AsioRaii init;
+
+   FilePath stateDir;
+   REQUIRE_FALSE(FilePath::uniqueFilePath("/tmp", stateDir));
+   REQUIRE_FALSE(stateDir.ensureDirectory());
+   const FilePath invocations = stateDir.completeChildPath("invocations"),
+                  overlaps = stateDir.completeChildPath("overlaps");
+
+   User currentUser;
+   REQUIRE_FALSE(User::getCurrentUser(currentUser));
+
+   auto makeOptions = [&](const std::string& in_partition)
+   {
+      process::ProcessOptions options;
+      options.Executable = FilePath::safeCurrentPath(FilePath("/")).completeChildPath("fake-scheduler.sh")
+         .getAbsolutePath();
+      options.Arguments = { stateDir.getAbsolutePath(), in_partition };
+      options.RunAsUser = currentUser;
+      options.UseSandbox = false;
+      return options;
+   };
+
+   std::shared_ptr<Runner> runner(new Runner(&parseJobLine, std::chrono::seconds(60), 1));
+
+   // Identical commands run at the same time share one child process, and lines split across reads are parsed whole.
+   std::atomic<int> completed(0);
+   std::vector<std::shared_ptr<const JobStates> > results(3);
+   for (size_t i = 0; i < results.size(); ++i)
+   {
+      runner->run(
+         makeOptions("debug"),
+         [&, i](const Error& in_error, const std::shared_ptr<const JobStates>& in_result)
+         {
+            CHECK_FALSE(in_error);
+            results[i] = in_result;
+            ++completed;
+         });
+   }
+
+   REQUIRE(waitFor(completed, 3));
+   CHECK(countLines(invocations) == 1);
+   REQUIRE(results[0] != nullptr);
+   CHECK(results[0] == results[1]);
+   CHECK(results[0] == results[2]);
+   CHECK(*results[0] == JobStates({ { "1", "RUNNING" }, { "2", "PENDING" }, { "3", "COMPLETED" } }));
+
+   // The result is cached.
+   runner->run(
+      makeOptions("debug"),
+      [&](const Error& in_error, const std::shared_ptr<const JobStates>& in_result)
+      {
+         CHECK_FALSE(in_error);
+         CHECK(in_result == results[0]);
+         ++completed;
+      });
+   CHECK(completed == 4);
+   CHECK(countLines(invocations) == 1);
+
+   // Different commands are queued so only one runs at a time. Failures are reported and not cached.
+   std::atomic<int> failed(0);
+   runner->invalidate();
+   for (const std::string& partition: { "debug", "gpu", "fail", "fail" })
+   {
+      runner->run(
+         makeOptions(partition),
+         [&](const Error& in_error, const std::shared_ptr<const JobStates>& in_result)
+         {
+            if (in_error)
+            {
+               CHECK(in_result == nullptr);
+               CHECK(in_error.getSummary().find("Invalid partition") != std::string::npos);
+               ++failed;
+            }
+            ++completed;
+         });
+   }
+
+   REQUIRE(waitFor(completed, 8));
+   CHECK(failed == 2);
+   CHECK(countLines(invocations) == 4);
+   CHECK_FALSE(overlaps.exists());
+
+   runner->run(
+      makeOptions("fail"),
+      [&](const Error& in_error, const std::shared_ptr<const JobStates>&)
+      {
+         CHECK(in_error);
+         ++completed;
+      });
+
+   REQUIRE(waitFor(completed, 9));
+   CHECK(countLines(invocations) == 5);
+
+   CHECK_FALSE(stateDir.remove());
+}
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
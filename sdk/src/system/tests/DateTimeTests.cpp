@@ -266,6 +266,75 @@ TEST_CASE("Complex toString")
    }
 }
 
+TEST_CASE("ISO 8601 parsing and formatting")
+{
+   SECTION("Matches the general formatter")
+   {
+      // Walk across a wide range of times, including before the epoch, leap days, and times without fractional
+      // seconds.
+      DateTime d;
+      REQUIRE_FALSE(DateTime::fromString("1903-02-27T21:59:58.000001Z", d));
+      for (int i = 0; i < 2000; ++i)
+      {
+         std::string expected = d.toString("%Y-%m-%dT%H:%M:%S%F") + "Z";
+         REQUIRE(d.toString() == expected);
+
+         DateTime parsed;
+         REQUIRE_FALSE(DateTime::fromString(expected, parsed));
+         REQUIRE(parsed == d);
+
+         d += TimeDuration(1271, 13, 1, (i % 3 == 0) ? 0 : 999999);
+      }
+   }
+
+   SECTION("Within the same second")
+   {
+      DateTime d1, d2, d3;
+      REQUIRE_FALSE(DateTime::fromString("2020-02-29T23:59:59Z", d1));
+      REQUIRE_FALSE(DateTime::fromString("2020-02-29T23:59:59.5Z", d2));
+      REQUIRE_FALSE(DateTime::fromString("2020-02-29T23:59:59.000010Z", d3));
+
+      CHECK(d1.toString() == "2020-02-29T23:59:59Z");
+      CHECK(d2.toString() == "2020-02-29T23:59:59.500000Z");
+      CHECK(d3.toString() == "2020-02-29T23:59:59.000010Z");
+      CHECK(d1.toString() == "2020-02-29T23:59:59Z");
+   }
+
+   SECTION("Numeric offsets")
+   {
+      DateTime expected, d;
+      REQUIRE_FALSE(DateTime::fromString("2019-12-31T20:00:00.25Z", expected));
+
+      REQUIRE_FALSE(DateTime::fromString("2020-01-01T01:30:00.25+5:30", d));
+      CHECK(d == expected);
+      REQUIRE_FALSE(DateTime::fromString("2020-01-01T01:30:00.25+05:30", d));
+      CHECK(d == expected);
+      REQUIRE_FALSE(DateTime::fromString("2020-01-01T01:30:00.25+0530", d));
+      CHECK(d == expected);
+      REQUIRE_FALSE(DateTime::fromString("2019-12-31T12:00:00.25-8", d));
+      CHECK(d == expected);
+      REQUIRE_FALSE(DateTime::fromString("2019-12-31T12:00:00.25-08:00", d));
+      CHECK(d == expected);
+   }
+
+   SECTION("Excess fractional digits are truncated")
+   {
+      DateTime d;
+      REQUIRE_FALSE(DateTime::fromString("2019-02-15T11:23:44.123456789Z", d));
+      CHECK(d.toString() == "2019-02-15T11:23:44.123456Z");
+   }
+
+   SECTION("Invalid times")
+   {
+      DateTime d;
+      CHECK(DateTime::fromString("2019-02-29T11:23:44Z", d));
+      CHECK(DateTime::fromString("2019-13-01T11:23:44Z", d));
+      CHECK(DateTime::fromString("not a time", d));
+      CHECK(DateTime::fromString("", d));
+      CHECK(d.toString().empty());
+   }
+}
+
 TEST_CASE("Equality and Inequality")
 {
    SECTION("Two current times")
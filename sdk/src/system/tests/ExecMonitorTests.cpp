@@ -0,0 +1,113 @@
+/*
+ * ExecMonitorTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <TestMain.hpp>
+
+#include <future>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <AsioRaii.hpp>
+#include <system/ExecMonitor.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+namespace process {
+
+namespace {
+
+// Forks a child which execs /bin/true once a byte is written to the returned pipe.
+pid_t forkWaitingChild(int& out_writeFd)
+{
+   int fds[2];
+   REQUIRE(::pipe(fds) == 0);
+
+   pid_t pid = ::fork();
+   REQUIRE(pid >= 0);
+   if (pid == 0)
+   {
+      ::close(fds[1]);
+      char c;
+      if (::read(fds[0], &c, 1) == 1)
+         ::execl("/bin/true", "true", nullptr);
+      ::_exit(1);
+   }
+
+   ::close(fds[0]);
+   out_writeFd = fds[1];
+   return pid;
+}
+
+void releaseChild(pid_t in_pid, int in_writeFd)
+{
+   REQUIRE(::write(in_writeFd, "x", 1) == 1);
+   ::close(in_writeFd);
+
+   int status = 0;
+   ::waitpid(in_pid, &status, 0);
+}
+
+} // anonymous namespace
+
+TEST_CASE("Exec monitor")
+{
+   // The AsioService can't be restarted, so all checks share one test case.
+   AsioRaii init;
+
+   REQUIRE_FALSE(ExecMonitor::start());
+   REQUIRE(ExecMonitor::isRunning());
+
+   // Watched process exec is reported.
+   {
+      int writeFd = -1;
+      pid_t pid = forkWaitingChild(writeFd);
+
+      std::shared_ptr<std::promise<void> > execed = std::make_shared<std::promise<void> >();
+      std::future<void> execedFuture = execed->get_future();
+      REQUIRE(ExecMonitor::watch(pid, [execed]() { execed->set_value(); }));
+
+      releaseChild(pid, writeFd);
+      CHECK(execedFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+   }
+
+   // Unwatched process exec is not reported.
+   {
+      int writeFd = -1;
+      pid_t pid = forkWaitingChild(writeFd);
+
+      std::shared_ptr<std::promise<void> > execed = std::make_shared<std::promise<void> >();
+      std::future<void> execedFuture = execed->get_future();
+      REQUIRE(ExecMonitor::watch(pid, [execed]() { execed->set_value(); }));
+      ExecMonitor::unwatch(pid);
+
+      releaseChild(pid, writeFd);
+      CHECK(execedFuture.wait_for(std::chrono::milliseconds(500)) == std::future_status::timeout);
+   }
+}
+
+} // namespace process
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
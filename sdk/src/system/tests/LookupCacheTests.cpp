@@ -0,0 +1,195 @@
+/*
+ * LookupCacheTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <TestMain.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <AsioRaii.hpp>
+#include <system/DateTime.hpp>
+#include <system/FilePath.hpp>
+#include <system/User.hpp>
+
+#include "../LookupCache.hpp"
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+typedef LookupCache<std::string, int> TestCache;
+
+TEST_CASE("Lookup cache")
+{
+   std::atomic<int> lookups = {0};
+   auto lookup = [&lookups](const std::string& in_key, int& out_value) -> Error
+   {
+      lookups.fetch_add(1);
+      if (in_key == "missing")
+         return systemError(ENOENT, "Not found.", ERROR_LOCATION);
+      if (in_key == "broken")
+         return systemError(EIO, "Lookup failed.", ERROR_LOCATION);
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      out_value = static_cast<int>(in_key.size());
+      return Success();
+   };
+
+   SECTION("Successful lookups are cached")
+   {
+      std::shared_ptr<TestCache> cache = std::make_shared<TestCache>(
+         lookup,
+         std::chrono::minutes(5),
+         std::chrono::minutes(1));
+
+      int value = 0;
+      REQUIRE_FALSE(cache->get("abc", value));
+      CHECK(value == 3);
+      REQUIRE_FALSE(cache->get("abc", value));
+      CHECK(value == 3);
+      CHECK(lookups.load() == 1);
+
+      cache->invalidate();
+      REQUIRE_FALSE(cache->get("abc", value));
+      CHECK(lookups.load() == 2);
+   }
+
+   SECTION("Not found results are cached but other errors are not")
+   {
+      std::shared_ptr<TestCache> cache = std::make_shared<TestCache>(
+         lookup,
+         std::chrono::minutes(5),
+         std::chrono::minutes(1));
+
+      int value = -1;
+      Error error = cache->get("missing", value);
+      REQUIRE(error);
+      CHECK(error.getCode() == ENOENT);
+      CHECK(cache->get("missing", value).getCode() == ENOENT);
+      CHECK(value == -1);
+      CHECK(lookups.load() == 1);
+
+      CHECK(cache->get("broken", value).getCode() == EIO);
+      CHECK(cache->get("broken", value).getCode() == EIO);
+      CHECK(lookups.load() == 3);
+   }
+
+   SECTION("Expired entries are looked up again")
+   {
+      std::shared_ptr<TestCache> cache = std::make_shared<TestCache>(
+         lookup,
+         std::chrono::milliseconds(0),
+         std::chrono::milliseconds(0));
+
+      int value = 0;
+      REQUIRE_FALSE(cache->get("abc", value));
+      REQUIRE_FALSE(cache->get("abc", value));
+      CHECK(cache->get("missing", value));
+      CHECK(cache->get("missing", value));
+      CHECK(lookups.load() == 4);
+   }
+
+   SECTION("Concurrent lookups are coalesced")
+   {
+      std::shared_ptr<TestCache> cache = std::make_shared<TestCache>(
+         lookup,
+         std::chrono::minutes(5),
+         std::chrono::minutes(1));
+
+      std::atomic<int> failures = {0};
+      std::vector<std::thread> threads;
+      for (int i = 0; i < 8; ++i)
+      {
+         threads.emplace_back(
+            [&cache, &failures]()
+            {
+               int value = 0;
+               if (cache->get("abcdef", value) || (value != 6))
+                  failures.fetch_add(1);
+            });
+      }
+
+      for (std::thread& thread: threads)
+         thread.join();
+
+      CHECK(failures.load() == 0);
+      CHECK(lookups.load() == 1);
+   }
+
+   SECTION("Stale entries are refreshed in the background")
+   {
+      AsioRaii init;
+      std::shared_ptr<TestCache> cache = std::make_shared<TestCache>(
+         lookup,
+         std::chrono::milliseconds(400),
+         std::chrono::minutes(1));
+
+      int value = 0;
+      REQUIRE_FALSE(cache->get("abc", value));
+      std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+      // The entry is past its refresh time, so the cached value is returned and a refresh is started.
+      REQUIRE_FALSE(cache->get("abc", value));
+      CHECK(value == 3);
+      std::this_thread::sleep_for(std::chrono::milliseconds(150));
+      CHECK(lookups.load() == 2);
+
+      // The refreshed entry hasn't expired, even though the original would have.
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      REQUIRE_FALSE(cache->get("abc", value));
+      CHECK(lookups.load() == 2);
+   }
+}
+
+TEST_CASE("User cache")
+{
+   User::invalidateCache();
+
+   User byName, byId;
+   REQUIRE_FALSE(User::getUserFromIdentifier("root", byName));
+   REQUIRE_FALSE(User::getUserFromIdentifier(0, byId));
+   CHECK(byName == byId);
+   CHECK(byName.getUsername() == "root");
+
+   // Repeated lookups return equivalent, independent copies.
+   User again;
+   REQUIRE_FALSE(User::getUserFromIdentifier("root", again));
+   CHECK(again == byName);
+   CHECK(again.getHomePath().getAbsolutePath() == byName.getHomePath().getAbsolutePath());
+
+   User missing;
+   Error error = User::getUserFromIdentifier("rlps-no-such-user", missing);
+   REQUIRE(error);
+   CHECK(error.getCode() == ENOENT);
+   CHECK(User::getUserFromIdentifier("rlps-no-such-user", missing).getCode() == ENOENT);
+
+   User::setCacheTimeouts(TimeDuration::Seconds(0), TimeDuration::Seconds(0));
+   REQUIRE_FALSE(User::getUserFromIdentifier("root", again));
+   CHECK(again == byName);
+   User::setCacheTimeouts(TimeDuration::Minutes(5), TimeDuration::Seconds(30));
+}
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -248,6 +248,43 @@ TEST_CASE("Create Processes")
       CHECK(result.StdError == "");
       CHECK(result.StdOut == "Mount test passed!");
    }
+
+   SECTION("Unusable cgroup")
+   {
+      logging::MockLogPtr mockLog = logging::getMockLogDest();
+
+      // Not a cgroup, so processes can't be moved into it.
+      FilePath cgroup;
+      REQUIRE_FALSE(FilePath::uniqueFilePath("/tmp", cgroup));
+      REQUIRE_FALSE(cgroup.ensureDirectory());
+
+      ProcessOptions opts;
+      opts.Executable = "/bin/echo";
+      opts.Arguments.emplace_back("-n");
+      opts.Arguments.emplace_back("output");
+      opts.ControlGroup = cgroup;
+      opts.IsShellCommand = false;
+      opts.UseSandbox = false;
+
+      // The process is launched without the cgroup rather than failing.
+      ProcessResult result;
+      SyncChildProcess child(opts);
+      REQUIRE_FALSE(child.run(result));
+      CHECK(result.ExitCode == 0);
+      CHECK(result.StdOut == "output");
+
+      bool loggedError = false;
+      while (mockLog->getSize() > 0)
+      {
+         logging::LogRecord record = mockLog->pop();
+         if ((record.Level == logging::LogLevel::ERR) &&
+            (record.Message.find(cgroup.getAbsolutePath()) != std::string::npos))
+            loggedError = true;
+      }
+      CHECK(loggedError);
+
+      REQUIRE_FALSE(cgroup.remove());
+   }
 }
 
 } // namespace process
@@ -0,0 +1,158 @@
+/*
+ * TimerServiceTests.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+
+#include <TestMain.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <AsioRaii.hpp>
+
+#include "../TimerService.hpp"
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace system {
+
+namespace {
+
+/**
+ * @brief Waits up to two seconds for the count to reach the expected value.
+ *
+ * @param in_count       The count to wait on.
+ * @param in_expected    The expected value of the count.
+ *
+ * @return True if the count reached the expected value; false otherwise.
+ */
+bool waitForCount(const std::atomic_int& in_count, int in_expected)
+{
+   for (int i = 0; (i < 200) && (in_count.load() < in_expected); ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+   return in_count.load() == in_expected;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Timer service")
+{
+   AsioRaii init;
+   TimerService& service = TimerService::getInstance();
+
+   // Nearby entries share a bucket.
+   {
+      service.setSlack(std::chrono::milliseconds(200));
+
+      std::atomic_int count(0);
+      std::vector<std::unique_ptr<TimerEntry> > entries;
+      TimerEntry::Clock::time_point start = TimerEntry::Clock::now();
+      std::atomic_bool tooEarly(false);
+      for (int i = 0; i < 5; ++i)
+      {
+         auto delay = std::chrono::milliseconds(100 + (i * 10));
+         entries.emplace_back(new TimerEntry(
+            [&count, &tooEarly, start, delay]()
+            {
+               if (TimerEntry::Clock::now() - start < delay)
+                  tooEarly.store(true);
+               count.fetch_add(1);
+            }));
+         entries.back()->schedule(delay);
+      }
+
+      // The entries span 40ms, so they cross at most one 200ms boundary.
+      CHECK(service.getBucketCount() <= 2);
+      CHECK(entries[0]->isScheduled());
+
+      CHECK(waitForCount(count, 5));
+      CHECK_FALSE(tooEarly.load());
+      CHECK_FALSE(entries[4]->isScheduled());
+      CHECK(service.getBucketCount() == 0);
+   }
+
+   // Entries which are due further in the future use coarser buckets.
+   {
+      service.setSlack(std::chrono::milliseconds(10));
+
+      std::vector<std::unique_ptr<TimerEntry> > entries;
+      for (int i = 0; i < 10; ++i)
+      {
+         entries.emplace_back(new TimerEntry([]() { CHECK(false); }));
+         entries.back()->schedule(std::chrono::seconds(60) + std::chrono::milliseconds(i * 10));
+      }
+
+      CHECK(service.getBucketCount() <= 2);
+
+      for (const auto& entry: entries)
+         entry->cancel();
+
+      CHECK(service.getBucketCount() == 0);
+   }
+
+   // Canceled and destroyed entries don't run, and rescheduled entries run once.
+   {
+      std::atomic_int count(0), canceledCount(0);
+      TimerEntry kept([&count]() { count.fetch_add(1); });
+      TimerEntry rescheduled([&count]() { count.fetch_add(1); });
+      TimerEntry canceled([&canceledCount]() { canceledCount.fetch_add(1); });
+      std::unique_ptr<TimerEntry> destroyed(new TimerEntry([&canceledCount]() { canceledCount.fetch_add(1); }));
+
+      kept.schedule(std::chrono::milliseconds(50));
+      rescheduled.schedule(std::chrono::milliseconds(20));
+      rescheduled.schedule(std::chrono::milliseconds(60));
+      canceled.schedule(std::chrono::milliseconds(50));
+      destroyed->schedule(std::chrono::milliseconds(50));
+
+      canceled.cancel();
+      destroyed.reset();
+      CHECK_FALSE(canceled.isScheduled());
+
+      CHECK(waitForCount(count, 2));
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      CHECK(count.load() == 2);
+      CHECK(canceledCount.load() == 0);
+   }
+
+   // Entries scheduled while the service is stopped are ignored until it is started again.
+   {
+      std::atomic_int count(0);
+      TimerEntry entry([&count]() { count.fetch_add(1); });
+
+      service.stop();
+      entry.schedule(std::chrono::milliseconds(10));
+      CHECK_FALSE(entry.isScheduled());
+
+      service.start();
+      entry.schedule(std::chrono::milliseconds(10));
+      CHECK(entry.isScheduled());
+      CHECK(waitForCount(count, 1));
+   }
+}
+
+} // namespace system
+} // namespace launcher_plugins
+} // namespace rstudio
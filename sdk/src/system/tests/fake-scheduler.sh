@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+
+#
+# fake-scheduler.sh
+#
+# Copyright (C) 2020 by RStudio, PBC
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+
+# Stands in for a Job Scheduling System CLI such as squeue.
+#
+# Usage: fake-scheduler.sh <state-dir> <partition|fail>
+#
+# Records each invocation in <state-dir>/invocations, and in <state-dir>/overlaps if another invocation was running at
+# the same time. Prints one "<id>|<state>|<partition>" line per job, or exits with an error if the partition is "fail".
+
+STATE_DIR="$1"
+PARTITION="$2"
+
+echo "$PARTITION" >> "$STATE_DIR/invocations"
+if ! mkdir "$STATE_DIR/running" 2>/dev/null; then
+  echo "$PARTITION" >> "$STATE_DIR/overlaps"
+fi
+
+sleep 0.3
+
+if [[ "$PARTITION" == "fail" ]]; then
+  rmdir "$STATE_DIR/running" 2>/dev/null
+  echo "fake-scheduler: error: Invalid partition" >&2
+  exit 1
+fi
+
+# Write the output in pieces, so lines are split across reads. The last line has no line ending.
+printf "1|RUNNING|%s\n2|PEND" "$PARTITION"
+sleep 0.1
+printf "ING|%s\n3|COMPLETED|%s" "$PARTITION" "$PARTITION"
+
+rmdir "$STATE_DIR/running" 2>/dev/null
+exit 0
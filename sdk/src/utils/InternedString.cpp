@@ -0,0 +1,227 @@
+/*
+ * InternedString.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <utils/InternedString.hpp>
+
+#include <array>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+#include <utils/MutexUtils.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace utils {
+
+namespace {
+
+/** The number of independently locked parts of the table. */
+constexpr size_t s_numShards = 16;
+
+/**
+ * @brief A part of the table of interned values.
+ */
+struct Shard
+{
+   /** Mutex to protect the values. */
+   std::mutex Mutex;
+
+   /** The interned values, by value. Entries are removed when the last reference to the value is released. */
+   std::unordered_map<std::string, std::weak_ptr<const std::string> > Values;
+};
+
+typedef std::array<Shard, s_numShards> Table;
+
+Table& getTable()
+{
+   // Never destroyed, so values may be safely released during static destruction.
+   static Table* table = new Table();
+   return *table;
+}
+
+/**
+ * @brief Removes a value from its shard when the last reference to it is released.
+ */
+struct ReleaseValue
+{
+   void operator()(const std::string* in_value) const
+   {
+      LOCK_MUTEX(TableShard->Mutex)
+      {
+         // The value may have been re-interned after the last reference was released, so only remove the entry if it
+         // is still expired.
+         auto itr = TableShard->Values.find(*in_value);
+         if ((itr != TableShard->Values.end()) && itr->second.expired())
+            TableShard->Values.erase(itr);
+      }
+      END_LOCK_MUTEX
+
+      delete in_value;
+   }
+
+   /** The shard to which the value belongs. */
+   Shard* TableShard;
+};
+
+std::shared_ptr<const std::string> intern(const std::string& in_value)
+{
+   if (in_value.empty())
+      return nullptr;
+
+   Shard& shard = getTable()[std::hash<std::string>()(in_value) % s_numShards];
+   LOCK_MUTEX(shard.Mutex)
+   {
+      std::weak_ptr<const std::string>& entry = shard.Values[in_value];
+      std::shared_ptr<const std::string> value = entry.lock();
+      if (value == nullptr)
+      {
+         value.reset(new std::string(in_value), ReleaseValue{ &shard });
+         entry = value;
+      }
+
+      return value;
+   }
+   END_LOCK_MUTEX
+
+   // Only reached if the mutex could not be locked; the value will simply not be shared.
+   return std::make_shared<const std::string>(in_value);
+}
+
+const std::string& getEmptyString()
+{
+   static const std::string* empty = new std::string();
+   return *empty;
+}
+
+} // anonymous namespace
+
+InternedString::InternedString(const std::string& in_value) :
+   m_value(intern(in_value))
+{
+}
+
+InternedString::InternedString(const char* in_value) :
+   m_value(((in_value == nullptr) || (*in_value == '\0')) ? nullptr : intern(std::string(in_value)))
+{
+}
+
+size_t InternedString::getInternedCount()
+{
+   size_t count = 0;
+   for (Shard& shard: getTable())
+   {
+      LOCK_MUTEX(shard.Mutex)
+      {
+         count += shard.Values.size();
+      }
+      END_LOCK_MUTEX
+   }
+
+   return count;
+}
+
+InternedString::operator const std::string&() const
+{
+   return str();
+}
+
+bool InternedString::operator==(const InternedString& in_other) const
+{
+   return m_value == in_other.m_value;
+}
+
+bool InternedString::operator!=(const InternedString& in_other) const
+{
+   return m_value != in_other.m_value;
+}
+
+bool InternedString::operator<(const InternedString& in_other) const
+{
+   return (m_value != in_other.m_value) && (str() < in_other.str());
+}
+
+const char* InternedString::c_str() const
+{
+   return str().c_str();
+}
+
+bool InternedString::empty() const
+{
+   return m_value == nullptr;
+}
+
+size_t InternedString::size() const
+{
+   return str().size();
+}
+
+const std::string& InternedString::str() const
+{
+   return (m_value == nullptr) ? getEmptyString() : *m_value;
+}
+
+bool operator==(const InternedString& in_lhs, const std::string& in_rhs)
+{
+   return in_lhs.str() == in_rhs;
+}
+
+bool operator==(const std::string& in_lhs, const InternedString& in_rhs)
+{
+   return in_lhs == in_rhs.str();
+}
+
+bool operator==(const InternedString& in_lhs, const char* in_rhs)
+{
+   return in_lhs.str() == in_rhs;
+}
+
+bool operator!=(const InternedString& in_lhs, const std::string& in_rhs)
+{
+   return !(in_lhs == in_rhs);
+}
+
+bool operator!=(const std::string& in_lhs, const InternedString& in_rhs)
+{
+   return !(in_lhs == in_rhs);
+}
+
+bool operator!=(const InternedString& in_lhs, const char* in_rhs)
+{
+   return !(in_lhs == in_rhs);
+}
+
+std::string operator+(const std::string& in_lhs, const InternedString& in_rhs)
+{
+   return in_lhs + in_rhs.str();
+}
+
+std::ostream& operator<<(std::ostream& io_ostream, const InternedString& in_string)
+{
+   return io_ostream << in_string.str();
+}
+
+} // namespace utils
+} // namespace launcher_plugins
+} // namespace rstudio
@@ -0,0 +1,254 @@
+/*
+ * LoadTest.hpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#ifndef LAUNCHER_PLUGINS_LOADTEST_HPP
+#define LAUNCHER_PLUGINS_LOADTEST_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Error.hpp>
+#include <metrics/Metrics.hpp>
+#include <system/FilePath.hpp>
+#include <system/Process.hpp>
+#include <system/User.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace smoke_test {
+
+/**
+ * @enum LoadRequest
+ * @brief The kinds of requests which the load tester may send to the plugin.
+ */
+enum class LoadRequest
+{
+   /** Submits a short job. */
+   SUBMIT_JOB        = 0,
+
+   /** Gets all of the request user's jobs. */
+   GET_ALL_JOBS      = 1,
+
+   /** Opens a job status stream for all jobs, and cancels it after the first response. */
+   STATUS_STREAM     = 2,
+
+   /** Opens an output stream for a recently submitted job, and cancels it after the first response. */
+   OUTPUT_STREAM     = 3,
+
+   /** Opens a resource utilization stream for a recently submitted job, and cancels it after the first response. */
+   RESOURCE_STREAM   = 4,
+
+   /** Cancels a recently submitted job. */
+   CONTROL_JOB       = 5,
+
+   /** Gets the cluster info. */
+   CLUSTER_INFO      = 6,
+};
+
+/** The number of kinds of requests which the load tester may send to the plugin. */
+constexpr size_t LOAD_REQUEST_COUNT = static_cast<size_t>(LoadRequest::CLUSTER_INFO) + 1;
+
+/**
+ * @brief The options which control the load generated by the load tester.
+ */
+struct LoadTestOptions
+{
+   /**
+    * @brief Constructor.
+    */
+   LoadTestOptions();
+
+   /**
+    * @brief Parses a single command line argument of the form --name=value.
+    *
+    * @param in_argument    The argument to parse.
+    *
+    * @return Success if the argument was valid; Error otherwise.
+    */
+   Error parseArgument(const std::string& in_argument);
+
+   /** The number of seconds for which requests should be sent. */
+   unsigned int DurationSeconds;
+
+   /** Additional arguments to pass to the plugin, e.g. --thread-pool-size=8. */
+   std::vector<std::string> PluginArguments;
+
+   /** The relative weight of each kind of request in the request mix. */
+   std::array<unsigned int, LOAD_REQUEST_COUNT> RequestMix;
+
+   /** The number of requests to send per second. */
+   double RequestsPerSecond;
+
+   /** The number of seconds to wait for outstanding responses after the last request has been sent. */
+   unsigned int ResponseTimeoutSeconds;
+
+   /** The number of job status stream subscriptions to hold open for the whole test. */
+   unsigned int StatusStreamSubscriptions;
+};
+
+/**
+ * @brief Generates a synthetic request load against a plugin and reports the plugin's latency and resource usage.
+ */
+class LoadTest : public std::enable_shared_from_this<LoadTest>
+{
+public:
+   /**
+    * @brief Constructor.
+    *
+    * @param in_pluginPath      The path to the Plugin to be tested.
+    * @param in_requestUser     The user to send requests for.
+    * @param in_options         The options which control the generated load.
+    */
+   LoadTest(system::FilePath in_pluginPath, system::User in_requestUser, LoadTestOptions in_options);
+
+   /**
+    * @brief Initializes the load tester, including starting threads and bootstrapping the plugin.
+    *
+    * @return Success if the load tester could be initialized; Error otherwise.
+    */
+   Error initialize();
+
+   /**
+    * @brief Sends requests at the configured rate for the configured duration, and then waits for outstanding
+    *        responses.
+    *
+    * @return Success if the plugin stayed up for the whole run; Error otherwise.
+    */
+   Error run();
+
+   /**
+    * @brief Writes the latency, throughput, and resource usage report to the specified stream.
+    *
+    * @param in_stream      The stream to which the report should be written.
+    */
+   void writeReport(std::ostream& in_stream) const;
+
+   /**
+    * @brief Stops the plugin and joins all threads.
+    */
+   void stop();
+
+private:
+   /**
+    * @brief A request which has been sent and has not yet received its first response.
+    */
+   struct PendingRequest
+   {
+      /** The kind of the request. */
+      LoadRequest Kind;
+
+      /** The time at which the request was sent. */
+      std::chrono::steady_clock::time_point SentTime;
+
+      /** The job ID used by the request, if any. */
+      std::string JobId;
+
+      /** Whether the request opens a stream which should be held open for the whole test. */
+      bool KeepOpen;
+   };
+
+   /**
+    * @brief A sample of the plugin's resource usage.
+    */
+   struct ResourceSample
+   {
+      /** The number of seconds since the run started. */
+      double ElapsedSeconds;
+
+      /** The CPU usage of the plugin since the previous sample, as a percentage of one core. */
+      double CpuPercent;
+
+      /** The resident set size of the plugin, in KiB. */
+      uint64_t RssKib;
+   };
+
+   /**
+    * @brief Handles a response from the plugin.
+    *
+    * @param in_response    The response.
+    */
+   void onResponse(const std::string& in_response);
+
+   /**
+    * @brief Samples the plugin's resource usage once per second until the run completes.
+    */
+   void sampleResources();
+
+   /**
+    * @brief Sends a request of the specified kind.
+    *
+    * @param in_kind        The kind of request to send.
+    *
+    * @return Success if the request could be written to the plugin; Error otherwise.
+    */
+   Error sendRequest(LoadRequest in_kind);
+
+   /**
+    * @brief Writes a formatted message to the plugin.
+    *
+    * @param in_message     The message to write.
+    *
+    * @return Success if the message could be written to the plugin; Error otherwise.
+    */
+   Error writeMessage(const std::string& in_message);
+
+   std::shared_ptr<system::process::AbstractChildProcess> m_plugin;
+   system::FilePath m_pluginPath;
+   system::User m_requestUser;
+   LoadTestOptions m_options;
+
+   std::mutex m_mutex;
+   std::condition_variable m_condVar;
+   // Set under m_mutex so waiters are notified, but also read without it.
+   std::atomic_bool m_exited;
+   bool m_isBootstrapped;
+   bool m_isRunComplete;
+   std::map<uint64_t, PendingRequest> m_pendingRequests;
+   std::vector<std::string> m_jobIds;
+   size_t m_nextJobIdIndex;
+
+   std::array<std::unique_ptr<metrics::LatencyHistogram>, LOAD_REQUEST_COUNT> m_latencies;
+   std::array<std::atomic_uint64_t, LOAD_REQUEST_COUNT> m_sentCounts;
+   std::array<std::atomic_uint64_t, LOAD_REQUEST_COUNT> m_errorCounts;
+   std::atomic_uint64_t m_streamEvents;
+   std::atomic_uint64_t m_nextRequestId;
+
+   std::chrono::steady_clock::time_point m_startTime;
+   double m_elapsedSeconds;
+   std::vector<ResourceSample> m_resourceSamples;
+};
+
+typedef std::shared_ptr<LoadTest> LoadTestPtr;
+
+} // namespace smoke_test
+} // namespace launcher_plugins
+} // namespace rstudio
+
+#endif
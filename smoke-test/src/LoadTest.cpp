@@ -0,0 +1,677 @@
+/*
+ * LoadTest.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <LoadTest.hpp>
+
+#include <unistd.h>
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include <api/Job.hpp>
+#include <api/Request.hpp>
+#include <json/Json.hpp>
+#include <system/Asio.hpp>
+#include <utils/FileUtils.hpp>
+
+// Private SDK Includes - These are not reliable!
+#include <api/Constants.hpp>
+#include <comms/MessageHandler.hpp>
+#include <logging/StderrLogDestination.hpp>
+#include <system/PosixSystem.hpp>
+
+namespace rstudio {
+namespace launcher_plugins {
+namespace smoke_test {
+
+typedef LoadTestPtr SharedThis;
+typedef std::weak_ptr<LoadTest> WeakThis;
+typedef std::chrono::steady_clock Clock;
+
+namespace {
+
+/** The maximum number of recently submitted job IDs to remember. */
+constexpr size_t MAX_JOB_IDS = 64;
+
+/** The names of each kind of load request, as used in the --mix argument and in the report. */
+constexpr char const* LOAD_REQUEST_NAMES[LOAD_REQUEST_COUNT] = {
+   "submit",
+   "get-all",
+   "status-stream",
+   "output-stream",
+   "resource-stream",
+   "control",
+   "cluster-info"
+};
+
+comms::MessageHandler& getMessageHandler()
+{
+   static comms::MessageHandler msgHandler;
+   return msgHandler;
+}
+
+Error invalidArgument(const std::string& in_argument, const std::string& in_reason)
+{
+   return systemError(EINVAL, "Invalid argument (" + in_argument + "): " + in_reason, ERROR_LOCATION);
+}
+
+json::Object makeRequest(uint64_t in_requestId, api::Request::Type in_type, const system::User& in_user)
+{
+   json::Object request;
+   request[api::FIELD_REQUEST_ID] = in_requestId;
+   request[api::FIELD_MESSAGE_TYPE] = static_cast<int>(in_type);
+   request[api::FIELD_REQUEST_USERNAME] = in_user.getUsername();
+   request[api::FIELD_REAL_USER] = in_user.getUsername();
+   return request;
+}
+
+json::Object makeStreamRequest(
+   uint64_t in_requestId,
+   api::Request::Type in_type,
+   const std::string& in_jobId,
+   bool in_cancel,
+   const system::User& in_user)
+{
+   json::Object request = makeRequest(in_requestId, in_type, in_user);
+   request[api::FIELD_JOB_ID] = in_jobId;
+   request[api::FIELD_ENCODED_JOB_ID] = "";
+   request[api::FIELD_CANCEL_STREAM] = in_cancel;
+   if (in_type == api::Request::Type::GET_JOB_OUTPUT)
+      request[api::FIELD_OUTPUT_TYPE] = static_cast<int>(api::OutputType::BOTH);
+
+   return request;
+}
+
+json::Object makeSubmitRequest(uint64_t in_requestId, const system::User& in_user)
+{
+   // The job runs long enough for output, resource utilization, and control requests to have something to act on.
+   api::Job job;
+   job.User = in_user;
+   job.Command = "echo Load test job && sleep 5";
+   job.Name = "Load test job";
+   job.Tags = { "load test" };
+
+   json::Object request = makeRequest(in_requestId, api::Request::Type::SUBMIT_JOB, in_user);
+   request[api::FIELD_JOB] = job.toJson();
+   return request;
+}
+
+Error readProcessUsage(pid_t in_pid, uint64_t& out_cpuTicks, uint64_t& out_rssKib)
+{
+   std::string contents;
+   Error error = utils::readFileIntoString(
+      system::FilePath("/proc/" + std::to_string(in_pid) + "/stat"),
+      contents);
+   if (error)
+      return error;
+
+   // The executable name may contain spaces, so start after it. utime and stime are the 12th and 13th fields after the
+   // executable name.
+   std::istringstream statStream(contents.substr(contents.rfind(')') + 1));
+   std::string field;
+   uint64_t userTicks = 0, systemTicks = 0;
+   for (int i = 0; (i < 11) && (statStream >> field); ++i);
+   statStream >> userTicks >> systemTicks;
+   out_cpuTicks = userTicks + systemTicks;
+
+   error = utils::readFileIntoString(
+      system::FilePath("/proc/" + std::to_string(in_pid) + "/status"),
+      contents);
+   if (error)
+      return error;
+
+   out_rssKib = 0;
+   size_t pos = contents.find("VmRSS:");
+   if (pos != std::string::npos)
+      std::istringstream(contents.substr(pos + 6)) >> out_rssKib;
+
+   return Success();
+}
+
+} // anonymous namespace
+
+LoadTestOptions::LoadTestOptions() :
+   DurationSeconds(60),
+   RequestMix({{ 1, 4, 1, 1, 1, 1, 1 }}),
+   RequestsPerSecond(50),
+   ResponseTimeoutSeconds(30),
+   StatusStreamSubscriptions(10)
+{
+}
+
+Error LoadTestOptions::parseArgument(const std::string& in_argument)
+{
+   size_t equalsPos = in_argument.find('=');
+   if ((in_argument.compare(0, 2, "--") != 0) || (equalsPos == std::string::npos))
+      return invalidArgument(in_argument, "expected --name=value");
+
+   std::string name = in_argument.substr(2, equalsPos - 2);
+   std::string value = in_argument.substr(equalsPos + 1);
+   try
+   {
+      if (name == "rate")
+         RequestsPerSecond = std::stod(value);
+      else if (name == "duration-seconds")
+         DurationSeconds = std::stoul(value);
+      else if (name == "status-streams")
+         StatusStreamSubscriptions = std::stoul(value);
+      else if (name == "response-timeout-seconds")
+         ResponseTimeoutSeconds = std::stoul(value);
+      else if (name == "plugin-arg")
+         PluginArguments.push_back(value);
+      else if (name == "mix")
+      {
+         // The mix is a comma separated list of <request>:<weight> pairs. Requests which are not listed are not sent.
+         RequestMix.fill(0);
+         std::istringstream mixStream(value);
+         std::string entry;
+         while (std::getline(mixStream, entry, ','))
+         {
+            size_t colonPos = entry.find(':');
+            std::string requestName = entry.substr(0, colonPos);
+            size_t i = 0;
+            while ((i < LOAD_REQUEST_COUNT) && (requestName != LOAD_REQUEST_NAMES[i]))
+               ++i;
+
+            if (i == LOAD_REQUEST_COUNT)
+               return invalidArgument(in_argument, "unknown request type " + requestName);
+
+            RequestMix[i] = (colonPos == std::string::npos) ? 1 : std::stoul(entry.substr(colonPos + 1));
+         }
+      }
+      else
+         return invalidArgument(in_argument, "unknown option");
+   }
+   catch (const std::exception& e)
+   {
+      return invalidArgument(in_argument, e.what());
+   }
+
+   if (RequestsPerSecond <= 0)
+      return invalidArgument(in_argument, "rate must be positive");
+
+   return Success();
+}
+
+LoadTest::LoadTest(system::FilePath in_pluginPath, system::User in_requestUser, LoadTestOptions in_options) :
+   m_pluginPath(std::move(in_pluginPath)),
+   m_requestUser(std::move(in_requestUser)),
+   m_options(std::move(in_options)),
+   m_exited(false),
+   m_isBootstrapped(false),
+   m_isRunComplete(false),
+   m_nextJobIdIndex(0),
+   m_streamEvents(0),
+   m_nextRequestId(0),
+   m_elapsedSeconds(0)
+{
+   for (size_t i = 0; i < LOAD_REQUEST_COUNT; ++i)
+   {
+      m_latencies[i].reset(new metrics::LatencyHistogram());
+      m_sentCounts[i] = 0;
+      m_errorCounts[i] = 0;
+   }
+}
+
+Error LoadTest::initialize()
+{
+   logging::addLogDestination(
+      std::shared_ptr<logging::ILogDestination>(
+         new logging::StderrLogDestination("LoadTestStderrLogging", logging::LogLevel::WARN, logging::LogMessageFormatType::PRETTY)));
+
+   // Responses are handled on the ASIO threads, so there must be enough of them to keep up with the plugin.
+   system::AsioService::startThreads(std::max(2u, std::thread::hardware_concurrency()));
+
+   system::process::ProcessOptions pluginOpts;
+   pluginOpts.Executable = m_pluginPath.getAbsolutePath();
+   pluginOpts.IsShellCommand = false;
+   pluginOpts.CloseStdIn = false;
+   pluginOpts.UseSandbox = false;
+   pluginOpts.Arguments = { "--heartbeat-interval-seconds=0" };
+   pluginOpts.Arguments.insert(
+      pluginOpts.Arguments.end(),
+      m_options.PluginArguments.begin(),
+      m_options.PluginArguments.end());
+   pluginOpts.RunAsUser = system::User(true); // Don't change users - run as whoever launched this.
+
+   if (!system::posix::realUserIsRoot())
+      pluginOpts.Arguments.emplace_back("--unprivileged=1");
+
+   system::process::AsyncProcessCallbacks callbacks;
+   callbacks.OnError = [](const Error& in_error)
+   {
+      std::cerr << "Error occurred while communicating with plugin: " << std::endl
+                << in_error.asString() << std::endl;
+   };
+
+   WeakThis weakThis = weak_from_this();
+   callbacks.OnExit = [weakThis](int exitCode)
+   {
+      if (exitCode != 0)
+         std::cerr << "Plugin exited with code " << exitCode << std::endl;
+
+      if (SharedThis sharedThis = weakThis.lock())
+      {
+         UNIQUE_LOCK_MUTEX(sharedThis->m_mutex)
+         {
+            sharedThis->m_exited = true;
+         }
+         END_LOCK_MUTEX
+
+         sharedThis->m_condVar.notify_all();
+      }
+   };
+
+   callbacks.OnStandardError = [](const std::string& in_string)
+   {
+      std::cerr << in_string << std::endl;
+   };
+
+   callbacks.OnStandardOutput = [weakThis](const std::string& in_string)
+   {
+      std::vector<std::string> messages;
+      Error error = getMessageHandler().processBytes(in_string.c_str(), in_string.size(), messages);
+      if (error)
+         logging::logError(error);
+
+      if (SharedThis sharedThis = weakThis.lock())
+      {
+         for (const std::string& message: messages)
+            sharedThis->onResponse(message);
+      }
+   };
+
+   Error error = system::process::ProcessSupervisor::runAsyncProcess(pluginOpts, callbacks, &m_plugin);
+   if (error)
+      return error;
+
+   json::Object version;
+   version[api::FIELD_VERSION_MAJOR] = api::API_VERSION_MAJOR;
+   version[api::FIELD_VERSION_MINOR] = api::API_VERSION_MINOR;
+   version[api::FIELD_VERSION_PATCH] = api::API_VERSION_PATCH;
+
+   json::Object bootstrap;
+   bootstrap[api::FIELD_REQUEST_ID] = 0;
+   bootstrap[api::FIELD_MESSAGE_TYPE] = static_cast<int>(api::Request::Type::BOOTSTRAP);
+   bootstrap[api::FIELD_VERSION] = version;
+
+   error = writeMessage(bootstrap.write());
+   if (error)
+      return error;
+
+   UNIQUE_LOCK_MUTEX(m_mutex)
+   {
+      if (!m_condVar.wait_for(
+         uniqueLock,
+         std::chrono::seconds(m_options.ResponseTimeoutSeconds),
+         [this]() { return m_isBootstrapped || m_exited; }) || !m_isBootstrapped)
+         return systemError(ETIME, "Failed to bootstrap plugin", ERROR_LOCATION);
+   }
+   END_LOCK_MUTEX
+
+   return Success();
+}
+
+Error LoadTest::run()
+{
+   m_startTime = Clock::now();
+   std::thread sampler(&LoadTest::sampleResources, this);
+
+   // Open the long lived job status stream subscriptions first, so the rest of the load is sent while they are active.
+   Error error;
+   for (unsigned int i = 0; !error && (i < m_options.StatusStreamSubscriptions); ++i)
+   {
+      uint64_t requestId = ++m_nextRequestId;
+      LOCK_MUTEX(m_mutex)
+      {
+         m_pendingRequests[requestId] = PendingRequest{ LoadRequest::STATUS_STREAM, Clock::now(), "*", true };
+      }
+      END_LOCK_MUTEX
+
+      ++m_sentCounts[static_cast<size_t>(LoadRequest::STATUS_STREAM)];
+      error = writeMessage(
+         makeStreamRequest(requestId, api::Request::Type::GET_JOB_STATUS, "*", false, m_requestUser).write());
+   }
+
+   std::mt19937 generator(std::random_device{}());
+   std::discrete_distribution<size_t> distribution(m_options.RequestMix.begin(), m_options.RequestMix.end());
+   const Clock::duration interval = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / m_options.RequestsPerSecond));
+   const Clock::time_point endTime = m_startTime + std::chrono::seconds(m_options.DurationSeconds);
+
+   for (Clock::time_point next = Clock::now(); !error && (next < endTime); next += interval)
+   {
+      std::this_thread::sleep_until(next);
+      if (m_exited)
+         error = systemError(ECHILD, "Plugin exited during the load test", ERROR_LOCATION);
+      else
+         error = sendRequest(static_cast<LoadRequest>(distribution(generator)));
+   }
+
+   m_elapsedSeconds = std::chrono::duration<double>(Clock::now() - m_startTime).count();
+
+   // Wait for responses to the outstanding requests.
+   UNIQUE_LOCK_MUTEX(m_mutex)
+   {
+      m_condVar.wait_for(
+         uniqueLock,
+         std::chrono::seconds(m_options.ResponseTimeoutSeconds),
+         [this]()
+         {
+            if (m_exited)
+               return true;
+
+            for (const auto& pending: m_pendingRequests)
+            {
+               if (!pending.second.KeepOpen)
+                  return false;
+            }
+
+            return true;
+         });
+
+      m_isRunComplete = true;
+   }
+   END_LOCK_MUTEX
+
+   m_condVar.notify_all();
+   sampler.join();
+
+   return error;
+}
+
+void LoadTest::writeReport(std::ostream& in_stream) const
+{
+   uint64_t totalSent = 0;
+   for (const auto& sent: m_sentCounts)
+      totalSent += sent;
+
+   in_stream << std::endl
+             << "Sent " << totalSent << " requests in " << std::fixed << std::setprecision(1) << m_elapsedSeconds
+             << " seconds (" << (m_elapsedSeconds > 0 ? totalSent / m_elapsedSeconds : 0) << " requests/second)."
+             << std::endl
+             << "Received " << m_streamEvents << " additional stream responses." << std::endl
+             << std::endl
+             << std::left << std::setw(18) << "Request"
+             << std::right << std::setw(10) << "Sent"
+             << std::setw(12) << "Responses"
+             << std::setw(10) << "Errors"
+             << std::setw(12) << "p50 (us)"
+             << std::setw(12) << "p99 (us)"
+             << std::setw(12) << "p99.9 (us)" << std::endl;
+
+   for (size_t i = 0; i < LOAD_REQUEST_COUNT; ++i)
+   {
+      if (m_sentCounts[i] == 0)
+         continue;
+
+      const metrics::LatencyHistogram& latency = *m_latencies[i];
+      in_stream << std::left << std::setw(18) << LOAD_REQUEST_NAMES[i]
+                << std::right << std::setw(10) << m_sentCounts[i]
+                << std::setw(12) << latency.getCount()
+                << std::setw(10) << m_errorCounts[i]
+                << std::setw(12) << latency.getValueAtQuantile(0.5)
+                << std::setw(12) << latency.getValueAtQuantile(0.99)
+                << std::setw(12) << latency.getValueAtQuantile(0.999) << std::endl;
+   }
+
+   in_stream << std::endl
+             << std::setw(10) << "Time (s)"
+             << std::setw(10) << "CPU (%)"
+             << std::setw(12) << "RSS (KiB)" << std::endl;
+
+   for (const ResourceSample& sample: m_resourceSamples)
+   {
+      in_stream << std::setw(10) << sample.ElapsedSeconds
+                << std::setw(10) << sample.CpuPercent
+                << std::setw(12) << sample.RssKib << std::endl;
+   }
+}
+
+void LoadTest::stop()
+{
+   if (m_plugin && !m_exited)
+      m_plugin->writeToStdin("", true);
+
+   system::AsioService::stop();
+   system::AsioService::waitForExit();
+}
+
+void LoadTest::onResponse(const std::string& in_response)
+{
+   json::Object response;
+   Error error = response.parse(in_response);
+   if (error || !response[api::FIELD_REQUEST_ID].isUInt64())
+   {
+      std::cerr << "Invalid response from plugin: " << in_response << std::endl;
+      return;
+   }
+
+   uint64_t requestId = response[api::FIELD_REQUEST_ID].getUInt64();
+   if (requestId == 0)
+   {
+      LOCK_MUTEX(m_mutex)
+      {
+         m_isBootstrapped = true;
+      }
+      END_LOCK_MUTEX
+
+      m_condVar.notify_all();
+      return;
+   }
+
+   PendingRequest request;
+   UNIQUE_LOCK_MUTEX(m_mutex)
+   {
+      auto itr = m_pendingRequests.find(requestId);
+      if (itr == m_pendingRequests.end())
+      {
+         // This is a later response on a stream which has already been timed.
+         ++m_streamEvents;
+         return;
+      }
+
+      request = itr->second;
+      m_pendingRequests.erase(itr);
+
+      if ((request.Kind == LoadRequest::SUBMIT_JOB) &&
+         response.hasMember(api::FIELD_JOBS) &&
+         response[api::FIELD_JOBS].isArray())
+      {
+         const json::Array jobs = response[api::FIELD_JOBS].getArray();
+         for (size_t i = 0, last = jobs.getSize(); i < last; ++i)
+         {
+            if (jobs[i].isObject() && jobs[i].getObject()[api::FIELD_ID].isString())
+               m_jobIds.push_back(jobs[i].getObject()[api::FIELD_ID].getString());
+         }
+
+         if (m_jobIds.size() > MAX_JOB_IDS)
+            m_jobIds.erase(m_jobIds.begin(), m_jobIds.end() - MAX_JOB_IDS);
+      }
+   }
+   END_LOCK_MUTEX
+
+   size_t kind = static_cast<size_t>(request.Kind);
+   m_latencies[kind]->record(
+      std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - request.SentTime).count());
+
+   // Error responses have a message type of -1.
+   if (response[api::FIELD_MESSAGE_TYPE].getInt() == -1)
+      ++m_errorCounts[kind];
+
+   // Streams are only timed to their first response, so cancel them now unless they should stay open.
+   if (!request.KeepOpen)
+   {
+      api::Request::Type streamType = api::Request::Type::INVALID;
+      if (request.Kind == LoadRequest::STATUS_STREAM)
+         streamType = api::Request::Type::GET_JOB_STATUS;
+      else if (request.Kind == LoadRequest::OUTPUT_STREAM)
+         streamType = api::Request::Type::GET_JOB_OUTPUT;
+      else if (request.Kind == LoadRequest::RESOURCE_STREAM)
+         streamType = api::Request::Type::GET_JOB_RESOURCE_UTIL;
+
+      if (streamType != api::Request::Type::INVALID)
+      {
+         error = writeMessage(makeStreamRequest(requestId, streamType, request.JobId, true, m_requestUser).write());
+         if (error)
+            logging::logError(error);
+      }
+   }
+
+   m_condVar.notify_all();
+}
+
+void LoadTest::sampleResources()
+{
+   // The plugin is launched through a shell, which may or may not exec it, so look for the plugin process itself.
+   pid_t pluginPid = m_plugin->getPid();
+   std::vector<system::process::ProcessInfo> children;
+   Error error = system::process::getChildProcesses(pluginPid, children);
+   for (const system::process::ProcessInfo& child: children)
+   {
+      if (child.Executable == m_pluginPath.getAbsolutePath())
+      {
+         pluginPid = child.Pid;
+         break;
+      }
+   }
+
+   const double ticksPerSecond = static_cast<double>(::sysconf(_SC_CLK_TCK));
+   Clock::time_point lastTime = Clock::now();
+   uint64_t lastTicks = 0, rssKib = 0;
+   error = readProcessUsage(pluginPid, lastTicks, rssKib);
+
+   UNIQUE_LOCK_MUTEX(m_mutex)
+   {
+      while (!error && !m_exited && !m_isRunComplete)
+      {
+         m_condVar.wait_until(
+            uniqueLock,
+            lastTime + std::chrono::seconds(1),
+            [this]() { return m_exited || m_isRunComplete; });
+
+         uint64_t ticks = 0;
+         error = readProcessUsage(pluginPid, ticks, rssKib);
+         if (error)
+            break;
+
+         Clock::time_point now = Clock::now();
+         double intervalSeconds = std::chrono::duration<double>(now - lastTime).count();
+         m_resourceSamples.push_back(ResourceSample{
+            std::chrono::duration<double>(now - m_startTime).count(),
+            intervalSeconds > 0 ? 100.0 * (ticks - lastTicks) / ticksPerSecond / intervalSeconds : 0,
+            rssKib });
+
+         lastTime = now;
+         lastTicks = ticks;
+      }
+   }
+   END_LOCK_MUTEX
+
+   if (error && !m_exited)
+      logging::logError(error);
+}
+
+Error LoadTest::sendRequest(LoadRequest in_kind)
+{
+   std::string jobId;
+   if ((in_kind == LoadRequest::OUTPUT_STREAM) ||
+      (in_kind == LoadRequest::RESOURCE_STREAM) ||
+      (in_kind == LoadRequest::CONTROL_JOB))
+   {
+      LOCK_MUTEX(m_mutex)
+      {
+         if (!m_jobIds.empty())
+            jobId = m_jobIds[m_nextJobIdIndex++ % m_jobIds.size()];
+      }
+      END_LOCK_MUTEX
+
+      // Until a job has been submitted, there's nothing for job specific requests to act on.
+      if (jobId.empty())
+         in_kind = LoadRequest::SUBMIT_JOB;
+   }
+
+   uint64_t requestId = ++m_nextRequestId;
+   json::Object request;
+   switch (in_kind)
+   {
+      case LoadRequest::SUBMIT_JOB:
+         request = makeSubmitRequest(requestId, m_requestUser);
+         break;
+      case LoadRequest::GET_ALL_JOBS:
+      {
+         request = makeRequest(requestId, api::Request::Type::GET_JOB, m_requestUser);
+         request[api::FIELD_JOB_ID] = "*";
+         request[api::FIELD_ENCODED_JOB_ID] = "";
+         break;
+      }
+      case LoadRequest::STATUS_STREAM:
+         jobId = "*";
+         request = makeStreamRequest(requestId, api::Request::Type::GET_JOB_STATUS, jobId, false, m_requestUser);
+         break;
+      case LoadRequest::OUTPUT_STREAM:
+         request = makeStreamRequest(requestId, api::Request::Type::GET_JOB_OUTPUT, jobId, false, m_requestUser);
+         break;
+      case LoadRequest::RESOURCE_STREAM:
+         request = makeStreamRequest(
+            requestId,
+            api::Request::Type::GET_JOB_RESOURCE_UTIL,
+            jobId,
+            false,
+            m_requestUser);
+         break;
+      case LoadRequest::CONTROL_JOB:
+      {
+         request = makeRequest(requestId, api::Request::Type::CONTROL_JOB, m_requestUser);
+         request[api::FIELD_JOB_ID] = jobId;
+         request[api::FIELD_ENCODED_JOB_ID] = "";
+         request[api::FIELD_OPERATION] = static_cast<int>(api::ControlJobRequest::Operation::CANCEL);
+         break;
+      }
+      case LoadRequest::CLUSTER_INFO:
+      default:
+         request = makeRequest(requestId, api::Request::Type::GET_CLUSTER_INFO, m_requestUser);
+         break;
+   }
+
+   LOCK_MUTEX(m_mutex)
+   {
+      m_pendingRequests[requestId] = PendingRequest{ in_kind, Clock::now(), jobId, false };
+   }
+   END_LOCK_MUTEX
+
+   ++m_sentCounts[static_cast<size_t>(in_kind)];
+   return writeMessage(request.write());
+}
+
+Error LoadTest::writeMessage(const std::string& in_message)
+{
+   return m_plugin->writeToStdin(getMessageHandler().formatMessage(in_message), false);
+}
+
+} // namespace smoke_test
+} // namespace launcher_plugins
+} // namespace rstudio
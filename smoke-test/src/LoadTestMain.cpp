@@ -0,0 +1,96 @@
+/*
+ * LoadTestMain.cpp
+ *
+ * Copyright (C) 2020 by RStudio, PBC
+ *
+ * Unless you have received this program directly from RStudio pursuant to the terms of a commercial license agreement
+ * with RStudio, then this program is licensed to you under the following terms:
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ * documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ * OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+
+#include <LoadTest.hpp>
+
+#include <iostream>
+
+#include <system/FilePath.hpp>
+
+using namespace rstudio::launcher_plugins;
+using namespace rstudio::launcher_plugins::smoke_test;
+
+/**
+ * @brief The main function.
+ *
+ * @param in_argc      The number of arguments supplied to the program.
+ * @param in_argv      The list of arguments supplied to the program.
+ *
+ * @return 0 on success; non-zero exit code otherwise.
+ */
+int main(int in_argc, char** in_argv)
+{
+   if (in_argc < 3)
+   {
+      std::cerr << "Unexpected number of arguments: " << in_argc << std::endl
+                << "Usage: ./rlps-load-test <path/to/plugin/exe> <request user> [options]" << std::endl
+                << "Options:" << std::endl
+                << "  --rate=<requests per second>           (default 50)" << std::endl
+                << "  --duration-seconds=<seconds>           (default 60)" << std::endl
+                << "  --status-streams=<subscriptions>       (default 10)" << std::endl
+                << "  --response-timeout-seconds=<seconds>   (default 30)" << std::endl
+                << "  --mix=<request>:<weight>[,...]         (default submit:1,get-all:4,status-stream:1," << std::endl
+                << "                                          output-stream:1,resource-stream:1,control:1," << std::endl
+                << "                                          cluster-info:1)" << std::endl
+                << "  --plugin-arg=<plugin argument>         (may be repeated, e.g. --plugin-arg=--thread-pool-size=8)"
+                << std::endl;
+      return 1;
+   }
+
+   LoadTestOptions options;
+   for (int i = 3; i < in_argc; ++i)
+   {
+      Error error = options.parseArgument(in_argv[i]);
+      if (error)
+      {
+         std::cerr << error.asString() << std::endl;
+         return 1;
+      }
+   }
+
+   system::User requestUser;
+   Error error = system::User::getUserFromIdentifier(in_argv[2], requestUser);
+   if (error)
+   {
+      std::cerr << "User " << in_argv[2] << " could not be created. Please ensure that it exists. Error:" << std::endl
+                << error.asString() << std::endl;
+      return 1;
+   }
+
+   int exitCode = 0;
+   LoadTestPtr tester(new LoadTest(system::FilePath(in_argv[1]), requestUser, options));
+   error = tester->initialize();
+   if (!error)
+      error = tester->run();
+
+   if (error)
+   {
+      std::cerr << "An error occurred during the load test: " << std::endl
+                << error.asString() << std::endl;
+      exitCode = 1;
+   }
+
+   tester->writeReport(std::cout);
+   tester->stop();
+   return exitCode;
+}
@@ -56,8 +56,10 @@ runTest "sdk/src/tests"
 runTest "sdk/src/api/tests"
 runTest "sdk/src/comms/tests"
 runTest "sdk/src/jobs/tests"
+runTest "sdk/src/metrics/tests"
 runTest "sdk/src/options/tests"
 runTest "sdk/src/system/tests"
+runTest "plugins/Local/src/tests"
 
 # TODO: Integration tests
 